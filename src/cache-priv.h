@@ -137,6 +137,15 @@ typedef struct {
 	 * this field.
 	 */
 	struct ttx_page_stat		_pages[0x800];
+
+	/**
+	 * TOP page titles by page number. Call cache_network_ait_index()
+	 * to access this field.
+	 */
+	struct ttx_ait_index		_ait_index[0x800];
+
+	/** Number of valid _ait_index entries. */
+	unsigned int			n_ait_titles;
 } cache_network;
 
 /**
@@ -369,6 +378,15 @@ cache_network_const_page_stat	(const cache_network *	cn,
 	return &cn->_pages[pgno - 0x100];
 }
 
+/** @internal */
+_vbi_inline struct ttx_ait_index *
+cache_network_ait_index		(cache_network *	cn,
+				 vbi_pgno		pgno)
+{
+	assert (pgno >= 0x100 && pgno <= 0x8FF);
+	return &cn->_ait_index[pgno - 0x100];
+}
+
 #if 3 == VBI_VERSION_MINOR
 /* in top.c */
 extern const struct ttx_ait_title *
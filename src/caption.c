@@ -26,6 +26,7 @@
 #endif
 
 #include <unistd.h>
+#include <sched.h>		/* sched_yield() */
 
 #include "misc.h"
 #include "trigger.h"
@@ -43,15 +44,85 @@
 #define CC_DUMP(x) /* x */
 #define CC_TEXT_DUMP(x) /* x */
 
+#define ROWS			15
+#define COLUMNS			34
+
+/*
+ *  Page access
+ *
+ *  Rendering threads may fetch pages at the display rate, so
+ *  vbi_fetch_cc_page() does not take cc->mutex, which serializes
+ *  only the writers. Instead the writers increment cc->seq before
+ *  and after they modify the pages (a sequence lock), and readers
+ *  repeat their copy if a writer was active. Since readers cannot
+ *  write, they request the reset of the dirty fields by storing the
+ *  sequence number of their copy in ch->fetched_seq, and the next
+ *  writer resets the fields if the page did not change since then.
+ *  A reader which collides with a writer yields the CPU and tries
+ *  again, it never waits for the mutex.
+ */
+
+#ifdef __ATOMIC_ACQUIRE
+#  define CC_SEQLOCK 1
+#else
+#  define CC_SEQLOCK 0
+#endif
+
+static inline void
+reset_dirty(vbi_page *pg)
+{
+	pg->dirty.y0 = ROWS;
+	pg->dirty.y1 = -1;
+	pg->dirty.roll = 0;
+}
+
+static void
+write_begin(struct caption *cc)
+{
+	pthread_mutex_lock(&cc->mutex);
+
+#if CC_SEQLOCK
+	{
+		unsigned int seq = cc->seq;
+		int i;
+
+		__atomic_store_n(&cc->seq, seq + 1, __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+
+		for (i = 0; i < 8; i++) {
+			cc_channel *ch = &cc->channel[i];
+
+			if (__atomic_load_n(&ch->fetched_seq,
+					    __ATOMIC_RELAXED) == seq) {
+				reset_dirty(ch->pg + (ch->hidden ^ 1));
+				/* Odd, never matches again. */
+				__atomic_store_n(&ch->fetched_seq, seq + 1,
+						 __ATOMIC_RELAXED);
+			}
+		}
+	}
+#endif
+}
+
+static void
+write_end(struct caption *cc)
+{
+#if CC_SEQLOCK
+	__atomic_store_n(&cc->seq, cc->seq + 1, __ATOMIC_RELEASE);
+#endif
+
+	pthread_mutex_unlock(&cc->mutex);
+}
+
 static inline void
 caption_send_event(vbi_decoder *vbi, vbi_event *ev)
 {
 	/* Permits calling vbi_fetch_cc_page from handler */
-	pthread_mutex_unlock(&vbi->cc.mutex);
+	write_end(&vbi->cc);
 
 	vbi_send_event(vbi, ev);
 
-	pthread_mutex_lock(&vbi->cc.mutex);
+	write_begin(&vbi->cc);
 }
 
 /*
@@ -503,8 +574,13 @@ xds_decoder(vbi_decoder *vbi, int _class, int type,
 				sum &= ((1UL << 31) - 1);
 				sum |= 1UL << 30;
 
-				if (n->nuid != 0)
+				if (n->nuid != 0) {
+					/* Resets the caption decoder,
+					   which takes cc->mutex. */
+					write_end(&vbi->cc);
 					vbi_chsw_reset(vbi, sum);
+					write_begin(&vbi->cc);
+				}
 
 				n->nuid = sum;
 
@@ -713,9 +789,6 @@ itv_separator(vbi_decoder *vbi, struct caption *cc, char c)
  *  Closed Caption decoder
  */
 
-#define ROWS			15
-#define COLUMNS			34
-
 static void
 render(vbi_page *pg, int row)
 {
@@ -1241,7 +1314,7 @@ vbi_decode_caption(vbi_decoder *vbi, int line, uint8_t *buf)
 	char c1 = buf[0] & 0x7F;
 	int field2 = 1, i;
 
-	pthread_mutex_lock(&cc->mutex);
+	write_begin(cc);
 
 	switch (line) {
 	case 21:	/* NTSC */
@@ -1372,7 +1445,7 @@ vbi_decode_caption(vbi_decoder *vbi, int line, uint8_t *buf)
 	}
 
  finish:
-	pthread_mutex_unlock(&cc->mutex);
+	write_end(cc);
 }
 
 /**
@@ -1414,6 +1487,8 @@ vbi_caption_channel_switched(vbi_decoder *vbi)
 	cc_channel *ch;
 	int i;
 
+	write_begin(cc);
+
 	for (i = 0; i < 9; i++) {
 		ch = &cc->channel[i];
 
@@ -1454,6 +1529,8 @@ vbi_caption_channel_switched(vbi_decoder *vbi)
 	cc->info_cycle[0] = 0;
 	cc->info_cycle[1] = 0;
 
+	write_end(cc);
+
 	vbi_caption_desync(vbi);
 }
 
@@ -1477,6 +1554,8 @@ vbi_caption_color_level(vbi_decoder *vbi)
 {
 	int i;
 
+	write_begin(&vbi->cc);
+
 	vbi_transp_colormap(vbi, vbi->cc.channel[0].pg[0].color_map,
 			    default_color_map, 8);
 
@@ -1484,6 +1563,8 @@ vbi_caption_color_level(vbi_decoder *vbi)
 		memcpy(vbi->cc.channel[i >> 1].pg[i & 1].color_map,
 		       vbi->cc.channel[0].pg[0].color_map,
 		       sizeof(default_color_map));
+
+	write_end(&vbi->cc);
 }
 
 /**
@@ -1572,6 +1653,9 @@ vbi_caption_init(vbi_decoder *vbi)
  * Although safe to do, this function is not supposed to be
  * called from an event handler, since rendering may block decoding
  * for extended periods of time.
+ *
+ * This function does not block the decoder. It can be called from
+ * another thread at any rate.
  * 
  * @return
  * @c FALSE if some error occured.
@@ -1579,27 +1663,48 @@ vbi_caption_init(vbi_decoder *vbi)
 vbi_bool
 vbi_fetch_cc_page(vbi_decoder *vbi, vbi_page *pg, vbi_pgno pgno, vbi_bool reset)
 {
-	cc_channel *ch = vbi->cc.channel + ((pgno - 1) & 7);
-	vbi_page *spg;
+	struct caption *cc = &vbi->cc;
+	cc_channel *ch = cc->channel + ((pgno - 1) & 7);
+#if CC_SEQLOCK
+	unsigned int seq;
+#endif
 
 	reset = reset;
 
 	if (pgno < 1 || pgno > 8)
 		return FALSE;
 
-	pthread_mutex_lock(&vbi->cc.mutex);
+#if CC_SEQLOCK
+	for (;;) {
+		seq = __atomic_load_n(&cc->seq, __ATOMIC_ACQUIRE);
+		if (0 == (seq & 1)) {
+			memcpy(pg, ch->pg + (ch->hidden ^ 1), sizeof(*pg));
+
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (__atomic_load_n(&cc->seq, __ATOMIC_RELAXED)
+			    == seq)
+				break;
+		}
+
+		/* A writer is active, let it finish. */
+		sched_yield();
+	}
 
-	spg = ch->pg + (ch->hidden ^ 1);
+	__atomic_store_n(&ch->fetched_seq, seq, __ATOMIC_RELAXED);
 
-	memcpy(pg, spg, sizeof(*pg)); /* shortcut? */
+	return TRUE;
+#else
+	pthread_mutex_lock(&cc->mutex);
 
-	spg->dirty.y0 = ROWS;
-	spg->dirty.y1 = -1;
-	spg->dirty.roll = 0;
+	memcpy(pg, ch->pg + (ch->hidden ^ 1), sizeof(*pg));
 
-	pthread_mutex_unlock(&vbi->cc.mutex);
+	reset_dirty(ch->pg + (ch->hidden ^ 1));
 
-	return 1;
+	pthread_mutex_unlock(&cc->mutex);
+
+	return TRUE;
+#endif
 }
 
 /*
@@ -64,11 +64,18 @@ typedef struct {
 
 	int			hidden;
 	vbi_page		pg[2];
+
+	/* caption.seq when the page was last fetched with reset. */
+	unsigned int		fetched_seq;
 } cc_channel;
 
 struct caption {
+	/* Serializes the writers. */
 	pthread_mutex_t		mutex;
 
+	/* Odd while a writer modifies the pages, see caption.c. */
+	unsigned int		seq;
+
 	uint8_t			last[2];		/* field 1, cc command repetition */
 
 	int			curr_chan;
@@ -949,6 +949,63 @@ _vbi_cc608_decoder_get_page	(_vbi_cc608_decoder *	cd,
 	return TRUE;
 }
 
+/**
+ * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
+ * @param text The rows of the roll-up window will be stored here,
+ *   top row first.
+ * @param max_rows Number of rows which fit into @a text. The
+ *   function stores only the bottom rows of a larger window.
+ * @param channel Caption channel @c VBI_CHANNEL_CC1 ...
+ *   @c VBI_CHANNEL_CC4.
+ *
+ * This function stores the displayed rows of the roll-up window of
+ * the given caption channel like _vbi_cc608_decoder_get_page()
+ * without padding, but formats only these rows.
+ *
+ * @returns
+ * The number of rows stored in @a text. Zero if the channel number
+ * is out of bounds or the channel is not in roll-up mode.
+ */
+unsigned int
+_vbi_cc608_decoder_get_roll_up_window
+				(_vbi_cc608_decoder *	cd,
+				 vbi_char		text[][32],
+				 unsigned int		max_rows,
+				 vbi_pgno		channel)
+{
+	struct channel *ch;
+	unsigned int n_rows;
+	unsigned int i;
+	vbi_bool to_upper;
+
+	assert (NULL != cd);
+	assert (NULL != text);
+
+	if (channel < VBI_CAPTION_CC1 || channel > VBI_CAPTION_T4)
+		return 0;
+
+	ch = &cd->channel[channel - VBI_CAPTION_CC1];
+
+	if (_VBI_CC608_MODE_ROLL_UP != ch->mode)
+		return 0;
+
+	n_rows = MIN (ch->curr_row + 1 - FIRST_ROW, ch->window_rows);
+	n_rows = MIN (n_rows, max_rows);
+
+	to_upper = (ch->uppercase_predictor > 3);
+
+	for (i = 0; i < n_rows; ++i) {
+		format_row (text[i], 32,
+			    ch, ch->displayed_buffer,
+			    ch->curr_row + 1 - n_rows + i,
+			    to_upper,
+			    /* padding */ FALSE,
+			    /* alpha */ FALSE);
+	}
+
+	return n_rows;
+}
+
 static void
 display_event			(_vbi_cc608_decoder *	cd,
 				 struct channel *	ch,
@@ -961,6 +1018,8 @@ display_event			(_vbi_cc608_decoder *	cd,
 
 	ev.type = _VBI_EVENT_CC608;
 	ev.ev._cc608 = &cc608;
+	cc608.capture_time = cd->timestamp.sys;
+	cc608.pts = cd->timestamp.pts;
 	cc608.channel = channel_num (cd, ch);
 	cc608.mode = ch->mode;
 	cc608.flags = flags;
@@ -1393,7 +1452,7 @@ erase_memory			(_vbi_cc608_decoder *	cd,
 		ch->dirty[buffer] = 0;
 
 		if (buffer == ch->displayed_buffer)
-			display_event (cd, ch, /* flags */ 0);
+			display_event (cd, ch, _VBI_CC608_DISPLAY_ERASED);
 	}
 }
 
@@ -2149,28 +2208,9 @@ characters			(_vbi_cc608_decoder *	cd,
 	return TRUE;
 }
 
-/**
- * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
- * @param buffer A caption byte pair with parity bits.
- * @param line ITU-R line number this data originated from,
- *   usually 21 or 284.
- * @param capture_time System time in seconds when the sliced data was
- *   captured.
- * @param pts ISO 13818-1 Presentation Time Stamp of the sliced
- *   data. @a pts counts 1/90000 seconds from an arbitrary point in the
- *   video stream. Only the 33 least significant bits have to be valid.
- *   If @a pts is negative the function converts @a capture_time to a
- *   PTS.
- *
- * This function decodes two bytes of Closed Caption data and updates
- * the decoder state. It may send one VBI_EVENT_CC608 and one or more
- * VBI_EVENT_CC608_STREAM.
- *
- * @returns
- * @c FALSE if the caption byte pair contained errors.
- */
-vbi_bool
-_vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
+/* Implementation of _vbi_cc608_decoder_feed(). */
+static vbi_bool
+decode_pair			(_vbi_cc608_decoder *	cd,
 				 const uint8_t		buffer[2],
 				 unsigned int		line,
 				 double			capture_time,
@@ -2180,8 +2220,6 @@ _vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
 	enum field_num f;
 	vbi_bool all_successful;
 
-	assert (NULL != cd);
-
 	if (0) {
 		fprintf (stdout, "%s:%u: %s "
 			 "buffer={ 0x%02x 0x%02x '%c%c' } "
@@ -2329,6 +2367,77 @@ _vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
 	return FALSE;
 }
 
+/**
+ * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
+ * @param buffer A caption byte pair with parity bits.
+ * @param line ITU-R line number this data originated from,
+ *   usually 21 or 284.
+ * @param capture_time System time in seconds when the sliced data was
+ *   captured.
+ * @param pts ISO 13818-1 Presentation Time Stamp of the sliced
+ *   data. @a pts counts 1/90000 seconds from an arbitrary point in the
+ *   video stream. Only the 33 least significant bits have to be valid.
+ *   If @a pts is negative the function converts @a capture_time to a
+ *   PTS.
+ *
+ * This function decodes two bytes of Closed Caption data and updates
+ * the decoder state. It may send one VBI_EVENT_CC608 and one or more
+ * VBI_EVENT_CC608_STREAM.
+ *
+ * @returns
+ * @c FALSE if the caption byte pair contained errors.
+ */
+vbi_bool
+_vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
+				 const uint8_t		buffer[2],
+				 unsigned int		line,
+				 double			capture_time,
+				 int64_t		pts)
+{
+	assert (NULL != cd);
+	assert (NULL != buffer);
+
+	return decode_pair (cd, buffer, line, capture_time, pts);
+}
+
+/**
+ * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
+ * @param pairs Array of caption byte pairs. The @a stream field of
+ *   the elements is ignored.
+ * @param n_pairs Number of elements in the @a pairs array.
+ *
+ * This function works like calling _vbi_cc608_decoder_feed() for
+ * each element of the @a pairs array in order, but with less
+ * overhead.
+ *
+ * @returns
+ * @c FALSE if any caption byte pair contained errors. Unlike
+ * _vbi_cc608_decoder_feed_frame() the function decodes the
+ * remaining pairs nevertheless.
+ */
+vbi_bool
+_vbi_cc608_decoder_feed_batch	(_vbi_cc608_decoder *	cd,
+				 const _vbi_cc608_pair *pairs,
+				 unsigned int		n_pairs)
+{
+	const _vbi_cc608_pair *end;
+	vbi_bool all_successful;
+
+	assert (NULL != cd);
+	assert (NULL != pairs);
+
+	all_successful = TRUE;
+
+	for (end = pairs + n_pairs; pairs < end; ++pairs) {
+		all_successful &= decode_pair (cd, pairs->buffer,
+					       pairs->line,
+					       pairs->capture_time,
+					       pairs->pts);
+	}
+
+	return all_successful;
+}
+
 /**
  * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
  * @param sliced Sliced VBI data.
@@ -2575,6 +2684,176 @@ _vbi_cc608_decoder_new		(void)
 	return cd;
 }
 
+/**
+ * @internal
+ * A set of caption decoders for multiple streams, stored in a
+ * contiguous array.
+ */
+struct _vbi_cc608_multi_decoder {
+	_vbi_cc608_decoder *	decoders;
+	unsigned int		n_decoders;
+};
+
+/**
+ * @param md Multi-stream caption decoder allocated with
+ *   _vbi_cc608_multi_decoder_new().
+ * @param stream Stream number, 0 ... @a n_streams - 1.
+ *
+ * Returns the caption decoder of @a stream, for example to add an
+ * event handler with _vbi_cc608_decoder_add_event_handler() or to
+ * call _vbi_cc608_decoder_get_page(). The decoder belongs to @a md
+ * and must not be deleted.
+ *
+ * @returns
+ * @c NULL if @a stream is invalid.
+ */
+_vbi_cc608_decoder *
+_vbi_cc608_multi_decoder_get	(_vbi_cc608_multi_decoder *md,
+				 unsigned int		stream)
+{
+	assert (NULL != md);
+
+	if (unlikely (stream >= md->n_decoders))
+		return NULL;
+
+	return &md->decoders[stream];
+}
+
+/**
+ * @param md Multi-stream caption decoder allocated with
+ *   _vbi_cc608_multi_decoder_new().
+ * @param pairs Array of caption byte pairs. The @a stream field of
+ *   each element selects the decoder.
+ * @param n_pairs Number of elements in the @a pairs array.
+ *
+ * This function works like calling _vbi_cc608_decoder_feed() with
+ * the decoder of each stream for each element of the @a pairs array
+ * in order. Pairs of different streams can be interleaved in any way.
+ *
+ * @returns
+ * @c FALSE if any caption byte pair contained errors or an invalid
+ * stream number. The function decodes the remaining pairs
+ * nevertheless.
+ */
+vbi_bool
+_vbi_cc608_multi_decoder_feed	(_vbi_cc608_multi_decoder *md,
+				 const _vbi_cc608_pair *pairs,
+				 unsigned int		n_pairs)
+{
+	const _vbi_cc608_pair *end;
+	vbi_bool all_successful;
+
+	assert (NULL != md);
+	assert (NULL != pairs);
+
+	all_successful = TRUE;
+
+	for (end = pairs + n_pairs; pairs < end; ++pairs) {
+		if (unlikely (pairs->stream >= md->n_decoders)) {
+			all_successful = FALSE;
+			continue;
+		}
+
+		all_successful &= decode_pair (&md->decoders[pairs->stream],
+					       pairs->buffer,
+					       pairs->line,
+					       pairs->capture_time,
+					       pairs->pts);
+	}
+
+	return all_successful;
+}
+
+/**
+ * @param md Multi-stream caption decoder allocated with
+ *   _vbi_cc608_multi_decoder_new().
+ *
+ * Resets the caption decoders of all streams.
+ */
+void
+_vbi_cc608_multi_decoder_reset	(_vbi_cc608_multi_decoder *md)
+{
+	unsigned int i;
+
+	assert (NULL != md);
+
+	for (i = 0; i < md->n_decoders; ++i)
+		_vbi_cc608_decoder_reset (&md->decoders[i]);
+}
+
+/**
+ * @param md Multi-stream caption decoder allocated with
+ *   _vbi_cc608_multi_decoder_new(), can be @a NULL.
+ *
+ * Frees all resources associated with @a md.
+ */
+void
+_vbi_cc608_multi_decoder_delete	(_vbi_cc608_multi_decoder *md)
+{
+	unsigned int i;
+
+	if (NULL == md)
+		return;
+
+	for (i = 0; i < md->n_decoders; ++i)
+		_vbi_cc608_decoder_destroy (&md->decoders[i]);
+
+	vbi_free (md->decoders);
+
+	CLEAR (*md);
+
+	vbi_free (md);
+}
+
+/**
+ * @param n_streams Number of streams to decode.
+ *
+ * Allocates a set of @a n_streams EIA 608-B Closed Caption decoders.
+ * This is more cache efficient than allocating separate decoders
+ * with _vbi_cc608_decoder_new() when decoding many streams, and
+ * _vbi_cc608_multi_decoder_feed() accepts the data of all streams
+ * in one call.
+ *
+ * @returns
+ * Pointer to a newly allocated multi-stream caption decoder which
+ * must be freed with _vbi_cc608_multi_decoder_delete() when done.
+ * @c NULL on failure (out of memory).
+ */
+_vbi_cc608_multi_decoder *
+_vbi_cc608_multi_decoder_new	(unsigned int		n_streams)
+{
+	_vbi_cc608_multi_decoder *md;
+	unsigned int i;
+
+	md = vbi_malloc (sizeof (*md));
+	if (NULL == md)
+		return NULL;
+
+	CLEAR (*md);
+
+	if (n_streams > 0) {
+		if (unlikely (n_streams > UINT_MAX / sizeof (*md->decoders)))
+			goto failed;
+
+		md->decoders = vbi_malloc (n_streams
+					   * sizeof (*md->decoders));
+		if (NULL == md->decoders)
+			goto failed;
+	}
+
+	for (i = 0; i < n_streams; ++i)
+		_vbi_cc608_decoder_init (&md->decoders[i]);
+
+	md->n_decoders = n_streams;
+
+	return md;
+
+ failed:
+	vbi_free (md);
+
+	return NULL;
+}
+
 /*
 Local variables:
 c-set-style: K&R
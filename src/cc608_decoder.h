@@ -57,11 +57,17 @@ typedef enum {
 
 /** @internal */
 typedef enum {
-	_VBI_CC608_START_ROLLING = (1 << 0)
+	_VBI_CC608_START_ROLLING = (1 << 0),
+
+	/* The displayed memory has been erased, by EDM, TR or a
+	   switch from pop-on or paint-on to roll-up mode. */
+	_VBI_CC608_DISPLAY_ERASED = (1 << 1)
 } _vbi_cc608_event_flags;
 
 /** @internal */
 struct _vbi_event_cc608_page {
+	double				capture_time;
+	int64_t				pts;
 	int				channel;
 	_vbi_cc608_mode			mode;
 	_vbi_cc608_event_flags		flags;
@@ -78,6 +84,22 @@ struct _vbi_event_cc608_stream {
 
 typedef struct _vbi_cc608_decoder _vbi_cc608_decoder;
 
+/** @internal */
+typedef struct {
+	/** Stream number for _vbi_cc608_multi_decoder_feed(). */
+	unsigned int			stream;
+
+	/** ITU-R line number, usually 21 or 284. */
+	unsigned int			line;
+
+	/** Caption byte pair with parity bits. */
+	uint8_t				buffer[2];
+
+	/** See _vbi_cc608_decoder_feed(). */
+	double				capture_time;
+	int64_t				pts;
+} _vbi_cc608_pair;
+
 extern void
 _vbi_cc608_dump			(FILE *			fp,
 				 unsigned int		c1,
@@ -87,6 +109,12 @@ _vbi_cc608_decoder_get_page	(_vbi_cc608_decoder *	cd,
 				 vbi_page *		pg,
 				 vbi_pgno		channel,
 				 vbi_bool		padding);
+extern unsigned int
+_vbi_cc608_decoder_get_roll_up_window
+				(_vbi_cc608_decoder *	cd,
+				 vbi_char		text[][32],
+				 unsigned int		max_rows,
+				 vbi_pgno		channel);
 extern vbi_bool
 _vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
 				 const uint8_t		buffer[2],
@@ -94,6 +122,10 @@ _vbi_cc608_decoder_feed		(_vbi_cc608_decoder *	cd,
 				 double			capture_time,
 				 int64_t		pts);
 extern vbi_bool
+_vbi_cc608_decoder_feed_batch	(_vbi_cc608_decoder *	cd,
+				 const _vbi_cc608_pair *pairs,
+				 unsigned int		n_pairs);
+extern vbi_bool
 _vbi_cc608_decoder_feed_frame	(_vbi_cc608_decoder *	cd,
 				 const vbi_sliced *	sliced,
 				 unsigned int		n_lines,
@@ -117,6 +149,22 @@ _vbi_cc608_decoder_delete	(_vbi_cc608_decoder *	cd);
 extern _vbi_cc608_decoder *
 _vbi_cc608_decoder_new		(void);
 
+typedef struct _vbi_cc608_multi_decoder _vbi_cc608_multi_decoder;
+
+extern _vbi_cc608_decoder *
+_vbi_cc608_multi_decoder_get	(_vbi_cc608_multi_decoder *md,
+				 unsigned int		stream);
+extern vbi_bool
+_vbi_cc608_multi_decoder_feed	(_vbi_cc608_multi_decoder *md,
+				 const _vbi_cc608_pair *pairs,
+				 unsigned int		n_pairs);
+extern void
+_vbi_cc608_multi_decoder_reset	(_vbi_cc608_multi_decoder *md);
+extern void
+_vbi_cc608_multi_decoder_delete	(_vbi_cc608_multi_decoder *md);
+extern _vbi_cc608_multi_decoder *
+_vbi_cc608_multi_decoder_new	(unsigned int		n_streams);
+
 /* Private */
 
 VBI_END_DECLS
@@ -0,0 +1,723 @@
+/*
+ *  libzvbi - Closed Caption subtitle file writer
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ *  Boston, MA  02110-1301  USA.
+ */
+
+/* This code is experimental and not yet part of the library. */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <stdio.h>		/* snprintf() */
+
+#include "misc.h"
+#include "cc608_writer.h"
+
+/* A cue contains the rows of one pop-on caption, the rows of the
+   roll-up window, or one row of paint-on or text mode caption. */
+#define MAX_CUE_LINES 15
+
+/* RU4. */
+#define MAX_ROLL_UP_ROWS 4
+
+/* Worst case: every character toggles the italic attribute and
+   expands to an entity, plus the line separator. */
+#define MAX_LINE_SIZE (32 * (sizeof (TTML_ITALIC_ON) - 1	\
+			     + sizeof (TTML_ITALIC_OFF) - 1	\
+			     + sizeof ("&amp;") - 1) + 8)
+
+#define TTML_ITALIC_ON "<span tts:fontStyle=\"italic\">"
+#define TTML_ITALIC_OFF "</span>"
+
+/* Cue timing line or element, or the TTML header. */
+#define MAX_TIMING_SIZE 256
+
+/* RFC 5646 language tag, see _vbi_cc608_writer_set_language(). */
+#define MAX_LANG_SIZE 36
+
+#define DEFAULT_MAX_DURATION 5000 /* ms */
+
+/**
+ * @internal
+ * Converts Closed Caption stream events to subtitle file cues.
+ */
+struct _vbi_cc608_writer {
+	_vbi_cc608_decoder *	cd;
+	vbi_pgno		channel;
+	_vbi_cc608_writer_format format;
+
+	_vbi_cc608_writer_cb *	callback;
+	void *			user_data;
+
+	/* Longest time a cue remains on screen, in milliseconds. */
+	int64_t			max_duration;
+
+	/* TTML xml:lang, empty if unknown. */
+	char			lang[MAX_LANG_SIZE];
+
+	/* The file header has been written. */
+	vbi_bool		header_written;
+
+	/* The callback failed since the last _sync() or _finish(). */
+	vbi_bool		failed;
+
+	/* Number of cues written to the current file. */
+	unsigned int		n_cues;
+
+	/* The pending cue, 0 == cue_n_lines if none. */
+	int64_t			cue_start;
+	int64_t			cue_deadline;
+	vbi_bool		cue_start_is_pts;
+	unsigned int		cue_n_lines;
+	unsigned int		cue_size;
+	char			cue_text[MAX_CUE_LINES * MAX_LINE_SIZE];
+
+	char			out[MAX_TIMING_SIZE + MAX_CUE_LINES
+				    * MAX_LINE_SIZE];
+};
+
+/* Returns the time in milliseconds: the PTS if valid, otherwise
+   the capture time. */
+static int64_t
+cue_time			(double			capture_time,
+				 int64_t		pts)
+{
+	if (pts >= 0)
+		return pts / 90;
+	else
+		return (int64_t)(capture_time * 1000 + 0.5);
+}
+
+static void
+format_time			(char			buffer[32],
+				 int64_t		ms,
+				 char			decimal_sep)
+{
+	if (ms < 0)
+		ms = 0;
+
+	snprintf (buffer, 32, "%02u:%02u:%02u%c%03u",
+		  (unsigned int)(ms / 3600000),
+		  (unsigned int)(ms / 60000 % 60),
+		  (unsigned int)(ms / 1000 % 60),
+		  decimal_sep,
+		  (unsigned int)(ms % 1000));
+}
+
+static void
+output				(_vbi_cc608_writer *	cw,
+				 const char *		data,
+				 unsigned int		size)
+{
+	if (!cw->callback (cw, cw->user_data, data, size))
+		cw->failed = TRUE;
+}
+
+static void
+write_header			(_vbi_cc608_writer *	cw,
+				 vbi_bool		pts)
+{
+	unsigned int n;
+
+	cw->header_written = TRUE;
+
+	switch (cw->format) {
+	case _VBI_CC608_WRITER_SRT:
+		break;
+
+	case _VBI_CC608_WRITER_WEBVTT:
+		/* Our cue times are PTS / 90 if available. HLS
+		   requires a mapping for the segment in that case. */
+		if (pts) {
+			static const char header[] =
+				"WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:0,"
+				"LOCAL:00:00:00.000\n\n";
+
+			output (cw, header, sizeof (header) - 1);
+		} else {
+			output (cw, "WEBVTT\n\n", 8);
+		}
+		break;
+
+	case _VBI_CC608_WRITER_TTML:
+		n = snprintf (cw->out, MAX_TIMING_SIZE,
+			      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			      "<tt xml:lang=\"%s\" "
+			      "xmlns=\"http://www.w3.org/ns/ttml\" "
+			      "xmlns:tts=\"http://www.w3.org/ns/ttml#styling\">\n"
+			      "<body>\n<div>\n", cw->lang);
+		assert (n < MAX_TIMING_SIZE);
+		output (cw, cw->out, n);
+		break;
+	}
+}
+
+/* Writes the pending cue, ending at time @a end. */
+static void
+write_cue			(_vbi_cc608_writer *	cw,
+				 int64_t		end)
+{
+	char start_str[32];
+	char end_str[32];
+	unsigned int n;
+
+	if (!cw->header_written)
+		write_header (cw, cw->cue_start_is_pts);
+
+	++cw->n_cues;
+
+	switch (cw->format) {
+	case _VBI_CC608_WRITER_SRT:
+		format_time (start_str, cw->cue_start, ',');
+		format_time (end_str, end, ',');
+		n = snprintf (cw->out, MAX_TIMING_SIZE, "%u\n%s --> %s\n",
+			      cw->n_cues, start_str, end_str);
+		memcpy (cw->out + n, cw->cue_text, cw->cue_size);
+		n += cw->cue_size;
+		memcpy (cw->out + n, "\n\n", 2);
+		n += 2;
+		break;
+
+	case _VBI_CC608_WRITER_WEBVTT:
+		format_time (start_str, cw->cue_start, '.');
+		format_time (end_str, end, '.');
+		n = snprintf (cw->out, MAX_TIMING_SIZE, "%s --> %s\n",
+			      start_str, end_str);
+		memcpy (cw->out + n, cw->cue_text, cw->cue_size);
+		n += cw->cue_size;
+		memcpy (cw->out + n, "\n\n", 2);
+		n += 2;
+		break;
+
+	case _VBI_CC608_WRITER_TTML:
+		format_time (start_str, cw->cue_start, '.');
+		format_time (end_str, end, '.');
+		n = snprintf (cw->out, MAX_TIMING_SIZE,
+			      "<p begin=\"%s\" end=\"%s\">",
+			      start_str, end_str);
+		memcpy (cw->out + n, cw->cue_text, cw->cue_size);
+		n += cw->cue_size;
+		memcpy (cw->out + n, "</p>\n", 5);
+		n += 5;
+		break;
+
+	default:
+		assert (0);
+	}
+
+	assert (n <= sizeof (cw->out));
+
+	output (cw, cw->out, n);
+}
+
+/* Ends the pending cue at time @a t, or when its maximum duration
+   expires if that is earlier. */
+static void
+end_cue				(_vbi_cc608_writer *	cw,
+				 int64_t		t)
+{
+	int64_t end;
+
+	end = cw->cue_deadline;
+	if (t > cw->cue_start && t < end)
+		end = t;
+
+	write_cue (cw, end);
+
+	cw->cue_n_lines = 0;
+	cw->cue_size = 0;
+}
+
+static char *
+put_utf8			(char *			d,
+				 unsigned int		c)
+{
+	if (c < 0x80) {
+		*d++ = c;
+	} else if (c < 0x800) {
+		d[0] = 0xC0 | (c >> 6);
+		d[1] = 0x80 | (c & 0x3F);
+		d += 2;
+	} else {
+		d[0] = 0xE0 | (c >> 12);
+		d[1] = 0x80 | ((c >> 6) & 0x3F);
+		d[2] = 0x80 | (c & 0x3F);
+		d += 3;
+	}
+
+	return d;
+}
+
+static vbi_bool
+is_blank			(const vbi_char *	ac)
+{
+	return (VBI_TRANSPARENT_SPACE == ac->opacity
+		|| 0x20 == ac->unicode);
+}
+
+/* Appends one row of caption to the pending cue. */
+static void
+append_line			(_vbi_cc608_writer *	cw,
+				 const vbi_char		text[32])
+{
+	const char *italic_on;
+	const char *italic_off;
+	unsigned int italic_on_size;
+	unsigned int italic_off_size;
+	vbi_bool escape;
+	vbi_bool italic;
+	char *d;
+	unsigned int first;
+	unsigned int end;
+	unsigned int i;
+
+	for (first = 0; first < 32; ++first) {
+		if (!is_blank (&text[first]))
+			break;
+	}
+
+	for (end = 32; end > first; --end) {
+		if (!is_blank (&text[end - 1]))
+			break;
+	}
+
+	if (first >= end)
+		return;
+
+	if (_VBI_CC608_WRITER_TTML == cw->format) {
+		italic_on = TTML_ITALIC_ON;
+		italic_off = TTML_ITALIC_OFF;
+	} else {
+		italic_on = "<i>";
+		italic_off = "</i>";
+	}
+
+	italic_on_size = strlen (italic_on);
+	italic_off_size = strlen (italic_off);
+
+	/* SubRip has no escape mechanism. */
+	escape = (_VBI_CC608_WRITER_SRT != cw->format);
+
+	d = cw->cue_text + cw->cue_size;
+
+	if (cw->cue_n_lines > 0) {
+		if (_VBI_CC608_WRITER_TTML == cw->format) {
+			memcpy (d, "<br/>", 5);
+			d += 5;
+		} else {
+			*d++ = '\n';
+		}
+	}
+
+	italic = FALSE;
+
+	for (i = first; i < end; ++i) {
+		unsigned int c;
+
+		/* Spaces do not end an italic run. */
+		if (italic != text[i].italic && !is_blank (&text[i])) {
+			italic = text[i].italic;
+			if (italic) {
+				memcpy (d, italic_on, italic_on_size);
+				d += italic_on_size;
+			} else {
+				memcpy (d, italic_off, italic_off_size);
+				d += italic_off_size;
+			}
+		}
+
+		if (VBI_TRANSPARENT_SPACE == text[i].opacity)
+			c = 0x20;
+		else
+			c = text[i].unicode;
+
+		if (escape && ('&' == c || '<' == c || '>' == c)) {
+			const char *s;
+
+			s = ('&' == c) ? "&amp;" : ('<' == c) ? "&lt;" : "&gt;";
+			while (0 != *s)
+				*d++ = *s++;
+		} else {
+			d = put_utf8 (d, c);
+		}
+	}
+
+	if (italic) {
+		memcpy (d, italic_off, italic_off_size);
+		d += italic_off_size;
+	}
+
+	cw->cue_size = d - cw->cue_text;
+	assert (cw->cue_size <= sizeof (cw->cue_text));
+
+	++cw->cue_n_lines;
+}
+
+/* Appends the rows of the roll-up window to the pending cue. */
+static void
+append_roll_up_window		(_vbi_cc608_writer *	cw)
+{
+	vbi_char text[MAX_ROLL_UP_ROWS][32];
+	unsigned int n_rows;
+	unsigned int i;
+
+	n_rows = _vbi_cc608_decoder_get_roll_up_window
+		(cw->cd, text, N_ELEMENTS (text), cw->channel);
+
+	for (i = 0; i < n_rows; ++i)
+		append_line (cw, text[i]);
+}
+
+static void
+stream_event			(_vbi_cc608_writer *	cw,
+				 const struct _vbi_event_cc608_stream *cs)
+{
+	int64_t t;
+
+	t = cue_time (cs->capture_time, cs->pts);
+
+	if (_VBI_CC608_MODE_ROLL_UP == cs->mode) {
+		/* The decoder sends one event for each completed row,
+		   but the rows above it remain visible. Each cue shows
+		   the entire window until the next row rolls in. */
+		if (cw->cue_n_lines > 0) {
+			if (t == cw->cue_start) {
+				/* Superseded. */
+				cw->cue_n_lines = 0;
+				cw->cue_size = 0;
+			} else {
+				end_cue (cw, t);
+			}
+		}
+
+		cw->cue_start = t;
+		cw->cue_deadline = t + cw->max_duration;
+		cw->cue_start_is_pts = (cs->pts >= 0);
+
+		append_roll_up_window (cw);
+
+		return;
+	}
+
+	if (cw->cue_n_lines > 0) {
+		/* The decoder sends one event for each row of a
+		   pop-on caption, with the same time stamp. */
+		if (t == cw->cue_start
+		    && cw->cue_n_lines < MAX_CUE_LINES) {
+			append_line (cw, cs->text);
+			return;
+		}
+
+		end_cue (cw, t);
+	}
+
+	cw->cue_start = t;
+	cw->cue_deadline = t + cw->max_duration;
+	cw->cue_start_is_pts = (cs->pts >= 0);
+
+	append_line (cw, cs->text);
+}
+
+static void
+event_handler			(vbi_event *		ev,
+				 void *			user_data)
+{
+	_vbi_cc608_writer *cw = user_data;
+
+	switch (ev->type) {
+	case _VBI_EVENT_CC608:
+	{
+		const struct _vbi_event_cc608_page *cp = ev->ev._cc608;
+
+		/* EDM and the like remove the caption from the
+		   screen before the maximum duration expires. */
+		if ((vbi_pgno) cp->channel == cw->channel
+		    && 0 != (cp->flags & _VBI_CC608_DISPLAY_ERASED)
+		    && cw->cue_n_lines > 0)
+			end_cue (cw, cue_time (cp->capture_time, cp->pts));
+		break;
+	}
+
+	case _VBI_EVENT_CC608_STREAM:
+		if ((vbi_pgno) ev->ev._cc608_stream->channel == cw->channel)
+			stream_event (cw, ev->ev._cc608_stream);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/**
+ * @param cw Caption writer allocated with _vbi_cc608_writer_new().
+ * @param capture_time Current system time in seconds.
+ * @param pts Current presentation time stamp, or -1 if unknown.
+ *
+ * The caption decoder sends a stream event when a caption row is
+ * complete, but the writer does not know when the row disappears
+ * from the screen until the next row arrives. To bound the output
+ * latency, call this function periodically, for example after each
+ * video frame. It writes the pending cue when its maximum duration
+ * has expired.
+ *
+ * @returns
+ * @c FALSE if the output callback failed since the last call of
+ * this function or _vbi_cc608_writer_finish().
+ */
+vbi_bool
+_vbi_cc608_writer_sync		(_vbi_cc608_writer *	cw,
+				 double			capture_time,
+				 int64_t		pts)
+{
+	vbi_bool success;
+
+	assert (NULL != cw);
+
+	if (cw->cue_n_lines > 0) {
+		int64_t t;
+
+		t = cue_time (capture_time, pts);
+		if (t >= cw->cue_deadline)
+			end_cue (cw, t);
+	}
+
+	success = !cw->failed;
+	cw->failed = FALSE;
+
+	return success;
+}
+
+/**
+ * @param cw Caption writer allocated with _vbi_cc608_writer_new().
+ * @param capture_time Current system time in seconds.
+ * @param pts Current presentation time stamp, or -1 if unknown.
+ *
+ * Completes the current subtitle file. The pending cue is written
+ * ending at the given time. If its maximum duration has not expired
+ * yet it continues at this time in the next file, so files can be
+ * cut at HLS segment boundaries without losing captions. Any further
+ * output starts a new file with a new header.
+ *
+ * @returns
+ * @c FALSE if the output callback failed since the last call of
+ * this function or _vbi_cc608_writer_sync().
+ */
+vbi_bool
+_vbi_cc608_writer_finish	(_vbi_cc608_writer *	cw,
+				 double			capture_time,
+				 int64_t		pts)
+{
+	static const char ttml_trailer[] = "</div>\n</body>\n</tt>\n";
+	vbi_bool success;
+	int64_t t;
+
+	assert (NULL != cw);
+
+	t = cue_time (capture_time, pts);
+
+	if (cw->cue_n_lines > 0) {
+		if (t > cw->cue_start && t < cw->cue_deadline) {
+			write_cue (cw, t);
+
+			/* To be continued. */
+			cw->cue_start = t;
+			cw->cue_start_is_pts = (pts >= 0);
+		} else {
+			end_cue (cw, t);
+		}
+	}
+
+	if (!cw->header_written)
+		write_header (cw, pts >= 0);
+
+	if (_VBI_CC608_WRITER_TTML == cw->format)
+		output (cw, ttml_trailer, sizeof (ttml_trailer) - 1);
+
+	cw->header_written = FALSE;
+	cw->n_cues = 0;
+
+	success = !cw->failed;
+	cw->failed = FALSE;
+
+	return success;
+}
+
+/**
+ * @param cw Caption writer allocated with _vbi_cc608_writer_new().
+ * @param seconds Maximum cue duration.
+ *
+ * Sets the longest time a cue remains on screen when no new caption
+ * row replaces it. The default is five seconds.
+ */
+void
+_vbi_cc608_writer_set_max_duration
+				(_vbi_cc608_writer *	cw,
+				 double			seconds)
+{
+	assert (NULL != cw);
+
+	cw->max_duration = MAX ((int64_t)(seconds * 1000 + 0.5),
+				(int64_t) 1);
+}
+
+/**
+ * @param cw Caption writer allocated with _vbi_cc608_writer_new().
+ * @param lang RFC 5646 language tag of the caption channel, for
+ *   example "en" or "es", or @c NULL if unknown.
+ *
+ * Sets the language TTML files declare in the xml:lang attribute
+ * of the root element. The default is an empty string, which means
+ * the language is unknown. The setting takes effect with the next
+ * file header.
+ *
+ * @returns
+ * @c FALSE if @a lang is not a valid language tag.
+ */
+vbi_bool
+_vbi_cc608_writer_set_language	(_vbi_cc608_writer *	cw,
+				 const char *		lang)
+{
+	unsigned int i;
+
+	assert (NULL != cw);
+
+	if (NULL == lang)
+		lang = "";
+
+	for (i = 0; 0 != lang[i]; ++i) {
+		int c = lang[i];
+
+		if (i >= MAX_LANG_SIZE - 1)
+			return FALSE;
+
+		if (!((c >= 'a' && c <= 'z')
+		      || (c >= 'A' && c <= 'Z')
+		      || (c >= '0' && c <= '9')
+		      || '-' == c))
+			return FALSE;
+	}
+
+	memcpy (cw->lang, lang, i + 1);
+
+	return TRUE;
+}
+
+/**
+ * @param cw Caption writer allocated with _vbi_cc608_writer_new(),
+ *   can be @c NULL.
+ *
+ * Frees all resources associated with @a cw, without writing the
+ * pending cue. Call _vbi_cc608_writer_finish() first if necessary.
+ */
+void
+_vbi_cc608_writer_delete	(_vbi_cc608_writer *	cw)
+{
+	if (NULL == cw)
+		return;
+
+	_vbi_cc608_decoder_remove_event_handler (cw->cd,
+						 event_handler, cw);
+
+	CLEAR (*cw);
+
+	vbi_free (cw);
+}
+
+/**
+ * @param cd Caption decoder allocated with _vbi_cc608_decoder_new().
+ * @param channel Caption channel to write, @c VBI_CAPTION_CC1 ...
+ *   @c VBI_CAPTION_T4.
+ * @param format Subtitle file format.
+ * @param callback Function to be called with the output data.
+ * @param user_data User pointer passed through to the @a callback.
+ *
+ * Allocates a caption writer which converts the stream events of
+ * caption decoder @a cd directly into SubRip, WebVTT or TTML cues.
+ * A cue begins when a pop-on caption or a caption row is complete,
+ * and ends when the next one arrives, the caption is erased from the
+ * screen or its maximum duration expires, see
+ * _vbi_cc608_writer_set_max_duration(). Roll-up cues contain all
+ * rows of the roll-up window. The writer outputs each cue with one
+ * @a callback call as soon as it ends.
+ *
+ * Cue times are the presentation time stamps passed to
+ * _vbi_cc608_decoder_feed() converted to milliseconds, or the
+ * capture time if no PTS is available.
+ *
+ * @returns
+ * Pointer to a newly allocated caption writer which must be freed
+ * with _vbi_cc608_writer_delete() before @a cd. @c NULL on failure
+ * (invalid parameters or out of memory).
+ */
+_vbi_cc608_writer *
+_vbi_cc608_writer_new		(_vbi_cc608_decoder *	cd,
+				 vbi_pgno		channel,
+				 _vbi_cc608_writer_format format,
+				 _vbi_cc608_writer_cb *	callback,
+				 void *			user_data)
+{
+	_vbi_cc608_writer *cw;
+
+	assert (NULL != cd);
+	assert (NULL != callback);
+
+	if (unlikely (channel < VBI_CAPTION_CC1
+		      || channel > VBI_CAPTION_T4))
+		return NULL;
+
+	switch (format) {
+	case _VBI_CC608_WRITER_SRT:
+	case _VBI_CC608_WRITER_WEBVTT:
+	case _VBI_CC608_WRITER_TTML:
+		break;
+
+	default:
+		return NULL;
+	}
+
+	cw = vbi_malloc (sizeof (*cw));
+	if (NULL == cw)
+		return NULL;
+
+	CLEAR (*cw);
+
+	cw->cd = cd;
+	cw->channel = channel;
+	cw->format = format;
+	cw->callback = callback;
+	cw->user_data = user_data;
+	cw->max_duration = DEFAULT_MAX_DURATION;
+
+	if (!_vbi_cc608_decoder_add_event_handler
+	    (cd, _VBI_EVENT_CC608 | _VBI_EVENT_CC608_STREAM,
+	     event_handler, cw)) {
+		vbi_free (cw);
+		return NULL;
+	}
+
+	return cw;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -0,0 +1,106 @@
+/*
+ *  libzvbi - Closed Caption subtitle file writer
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ *  Boston, MA  02110-1301  USA.
+ */
+
+/* This code is experimental and not yet part of the library. */
+
+#ifndef __ZVBI_CC608_WRITER_H__
+#define __ZVBI_CC608_WRITER_H__
+
+#include "cc608_decoder.h"
+
+VBI_BEGIN_DECLS
+
+/* Public */
+
+/** @internal */
+typedef enum {
+	/** SubRip (.srt). */
+	_VBI_CC608_WRITER_SRT = 1,
+
+	/** WebVTT (.vtt), with an X-TIMESTAMP-MAP for HLS. */
+	_VBI_CC608_WRITER_WEBVTT,
+
+	/** Timed Text Markup Language 1.0 (.ttml). */
+	_VBI_CC608_WRITER_TTML
+} _vbi_cc608_writer_format;
+
+typedef struct _vbi_cc608_writer _vbi_cc608_writer;
+
+/**
+ * @internal
+ * @param cw Caption writer calling this function.
+ * @param user_data User pointer passed through by
+ *   _vbi_cc608_writer_new().
+ * @param data Output data, in UTF-8 encoding. This is a complete
+ *   cue, or the file header or trailer.
+ * @param size Number of bytes in the @a data buffer.
+ *
+ * The caption writer calls a function of this type to output
+ * subtitle file data.
+ *
+ * @returns
+ * @c FALSE on failure, for example a write error. The writer will
+ * report the failure by returning @c FALSE from the next
+ * _vbi_cc608_writer_sync() or _vbi_cc608_writer_finish() call.
+ */
+typedef vbi_bool
+_vbi_cc608_writer_cb		(_vbi_cc608_writer *	cw,
+				 void *			user_data,
+				 const char *		data,
+				 unsigned int		size);
+
+extern vbi_bool
+_vbi_cc608_writer_sync		(_vbi_cc608_writer *	cw,
+				 double			capture_time,
+				 int64_t		pts);
+extern vbi_bool
+_vbi_cc608_writer_finish	(_vbi_cc608_writer *	cw,
+				 double			capture_time,
+				 int64_t		pts);
+extern vbi_bool
+_vbi_cc608_writer_set_language	(_vbi_cc608_writer *	cw,
+				 const char *		lang);
+extern void
+_vbi_cc608_writer_set_max_duration
+				(_vbi_cc608_writer *	cw,
+				 double			seconds);
+extern void
+_vbi_cc608_writer_delete	(_vbi_cc608_writer *	cw);
+extern _vbi_cc608_writer *
+_vbi_cc608_writer_new		(_vbi_cc608_decoder *	cd,
+				 vbi_pgno		channel,
+				 _vbi_cc608_writer_format format,
+				 _vbi_cc608_writer_cb *	callback,
+				 void *			user_data)
+  _vbi_alloc _vbi_nonnull ((1, 4));
+
+/* Private */
+
+VBI_END_DECLS
+
+#endif /* __ZVBI_CC608_WRITER_H__ */
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -257,6 +257,12 @@ struct frame {
 	 */
 	uint8_t *		rp;
 
+	/**
+	 * Raw VBI samples have been stored in the @a raw buffer
+	 * since the last reset_frame().
+	 */
+	vbi_bool		raw_written;
+
 	/**
 	 * Data units can contain at most 251 bytes of payload,
 	 * so raw VBI data is transmitted in segments. This field
@@ -364,6 +370,16 @@ struct _vbi_dvb_demux {
 	uint8_t *		ts_pes_bp;
 	unsigned int		ts_pes_todo;
 
+	/**
+	 * The payload of the current PES packet has not been copied
+	 * into pes_buffer. It is still in the source buffer, at the
+	 * ts_pes_n_chunks transport_packet payloads ts_pes_chunks[],
+	 * see demux_ts_packet().
+	 */
+	vbi_bool		ts_pes_in_place;
+	const uint8_t *		ts_pes_chunks[(6 + 65535 + 183) / 184];
+	unsigned int		ts_pes_n_chunks;
+
 	/**
 	 * Next expected transport_packet continuity_counter.
 	 * Value may be greater than 15, so you must compare
@@ -374,6 +390,18 @@ struct _vbi_dvb_demux {
 	/** PID of VBI data to be filtered out of a TS. */
 	unsigned int		ts_pid;
 
+	/**
+	 * Raw VBI buffers of the caller, see
+	 * _vbi_dvb_demux_set_raw_buffers(). frame.raw points to
+	 * raw_buffer[raw_index]. raw_written remembers if the other
+	 * buffer needs clearing before we can use it again.
+	 */
+	uint8_t *		raw_buffer[2];
+	vbi_bool		raw_written[2];
+	unsigned int		raw_index;
+	unsigned int		raw_start[2];
+	unsigned int		raw_count[2];
+
 	/** demux_pes_packet() or demux_ts_packet(). */
 	demux_packet_fn *	demux_packet;
 
@@ -770,6 +798,7 @@ demux_samples			(struct frame *		f,
 	n_pixels = MIN (n_pixels, 720 - first_pixel_position);
 
 	memcpy (f->rp + first_pixel_position, p + 6, n_pixels);
+	f->raw_written = TRUE;
 
 	/* last_segment_flag */
 	if (0 != (p[2] & (1 << 6))) {
@@ -878,7 +907,6 @@ extract_data_units		(struct frame *		f,
 		unsigned int data_unit_id;
 		unsigned int data_unit_length;
 		vbi_sliced *s;
-		unsigned int i;
 
 		data_unit_id = p[0];
 		data_unit_length = p[1];
@@ -934,8 +962,7 @@ extract_data_units		(struct frame *		f,
 			   pass the (always valid) field number. */
 			s->id = VBI_SLICED_TELETEXT_B;
 
-			for (i = 0; i < 42; ++i)
-				s->data[i] = vbi_rev8 (p[4 + i]);
+			_vbi_rev8_block (s->data, p + 4, 42);
 
 			if (f->log.mask & VBI_LOG_DEBUG2)
 				log_du_ttx (f, s);
@@ -1181,11 +1208,13 @@ reset_frame			(struct frame *		f)
 	f->sp = f->sliced_begin;
 
 	/* Take a shortcut if no raw data was ever stored here. */
-	if (f->rp > f->raw) {
+	if (f->raw_written) {
 		unsigned int n_lines;
 
 		n_lines = f->raw_count[0] + f->raw_count[1];
 		memset (f->raw, 0, n_lines * 720);
+
+		f->raw_written = FALSE;
 	}
 
 	f->rp = f->raw;
@@ -1460,6 +1489,22 @@ valid_vbi_pes_packet_header	(vbi_dvb_demux *	dx,
 	return TRUE;
 }
 
+static void
+swap_raw_buffers		(vbi_dvb_demux *	dx)
+{
+	unsigned int i = dx->raw_index;
+
+	dx->raw_written[i] = dx->frame.raw_written;
+
+	i ^= 1;
+
+	dx->raw_index = i;
+
+	dx->frame.raw = dx->raw_buffer[i];
+	dx->frame.rp = dx->raw_buffer[i];
+	dx->frame.raw_written = dx->raw_written[i];
+}
+
 /**
  * @internal
  * @param dx DVB demultiplexer context.
@@ -1523,6 +1568,13 @@ demux_pes_packet_frame		(vbi_dvb_demux *	dx,
 		if (dx->new_frame) {
 			/* New frame commences in this packet. */
 
+			if (NULL != dx->raw_buffer[1]) {
+				/* The caller may still work with the
+				   raw data of the previous frame, we
+				   continue in the other buffer. */
+				swap_raw_buffers (dx);
+			}
+
 			reset_frame (&dx->frame);
 
 			dx->frame_pts = dx->packet_pts;
@@ -1737,6 +1789,193 @@ demux_pes_packet		(vbi_dvb_demux *	dx,
 	return err;
 }
 
+/**
+ * @internal
+ * Returns @c TRUE if the data units between @a p and @a p_end end
+ * exactly at @a p_end, such that extract_data_units() can convert
+ * them without looking at the next transport_packet. EN 300 472
+ * section 4.3 arranges Teletext data units this way.
+ */
+static vbi_bool
+ts_payload_aligned		(const uint8_t *	p,
+				 const uint8_t *	p_end)
+{
+	while (p + 1 < p_end)
+		p += p[1] + 2;
+
+	return (p == p_end);
+}
+
+/**
+ * @internal
+ * Copies the TS payload collected in place so far into
+ * dx->pes_buffer and continues the PES packet on the copying path.
+ */
+static void
+ts_pes_spill			(vbi_dvb_demux *	dx)
+{
+	unsigned int i;
+
+	for (i = 0; i < dx->ts_pes_n_chunks; ++i)
+		memcpy (dx->ts_pes_bp + i * 184, dx->ts_pes_chunks[i], 184);
+
+	dx->ts_pes_bp += dx->ts_pes_n_chunks * 184;
+
+	dx->ts_pes_in_place = FALSE;
+	dx->ts_pes_n_chunks = 0;
+}
+
+/**
+ * @internal
+ * @param last_size Size of the payload in the last chunk.
+ *
+ * Converts a complete PES packet collected in place. This works
+ * exactly like the copying path in demux_ts_packet(), only the
+ * data units are extracted from the chunks in the source buffer.
+ *
+ * @returns
+ * @c 0 or VBI_ERR_CALLBACK like demux_pes_packet_frame(). In the
+ * latter case the remaining data units have been copied into
+ * dx->pes_buffer because the caller may reuse the source buffer.
+ */
+static int
+demux_ts_pes_in_place		(vbi_dvb_demux *	dx,
+				 unsigned int		last_size)
+{
+	unsigned int n_chunks;
+	unsigned int i;
+
+	n_chunks = dx->ts_pes_n_chunks;
+
+	dx->ts_pes_in_place = FALSE;
+	dx->ts_pes_n_chunks = 0;
+
+	if (!valid_vbi_pes_packet_header (dx, dx->ts_pes_chunks[0])) {
+		/* Discard the data collected so far. */
+		dx->new_frame = TRUE;
+		return 0;
+	}
+
+	dx->frame.n_data_units_extracted_from_packet = 0;
+
+	for (i = 0; i < n_chunks; ++i) {
+		const uint8_t *du;
+		unsigned int du_left;
+		int err;
+
+		du = dx->ts_pes_chunks[i];
+		du_left = (i + 1 < n_chunks) ? 184 : last_size;
+
+		if (0 == i) {
+			/* Start after data_identifier byte. */
+			du += 46;
+			du_left -= 46;
+		}
+
+		err = demux_pes_packet_frame (dx, &du, &du_left);
+
+		if (VBI_ERR_CALLBACK == err) {
+			uint8_t *bp;
+
+			/* We will return to the caller, who may reuse
+			   the source buffer. Continue with a copy of
+			   the remaining data units. */
+			memcpy (dx->pes_buffer, du, du_left);
+			bp = dx->pes_buffer + du_left;
+
+			while (++i < n_chunks) {
+				unsigned int size;
+
+				size = (i + 1 < n_chunks) ? 184 : last_size;
+				memcpy (bp, dx->ts_pes_chunks[i], size);
+				bp += size;
+			}
+
+			dx->ts_frame_bp = dx->pes_buffer;
+			dx->ts_frame_todo = bp - dx->pes_buffer;
+
+			return err;
+		} else if (0 != err) {
+			/* Discard the data collected so far
+			   and the rest of the PES packet. */
+			dx->new_frame = TRUE;
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @internal
+ * @param h The first three bytes of a transport_packet,
+ *   most significant byte first.
+ * @param pid PID of the VBI data.
+ *
+ * Returns @c TRUE if demux_ts_packet() would skip this packet
+ * without further ado: It starts with a sync_byte, the
+ * transport_error_indicator is not set and it belongs to
+ * another PID.
+ */
+#define TS_OTHER_PID(h, pid)						\
+	(0x470000 == ((h) & 0xFF8000) && (pid) != ((h) & 0x1FFF))
+
+_vbi_inline uint32_t
+ts_header			(const uint8_t *	p)
+{
+	return (p[0] << 16) | (p[1] << 8) | p[2];
+}
+
+/**
+ * @internal
+ * @param src Source buffer, pointing at the expected sync_byte
+ *   of a transport_packet.
+ * @param src_left Number of bytes in the @a src buffer.
+ * @param pid PID of the VBI data.
+ *
+ * When we receive a complete multiplex, as much as 99 percent of the
+ * transport_packets belong to other PIDs. This function scans the
+ * headers of a block of packets at once and returns how many bytes
+ * of whole packets can be discarded, before demux_ts_packet() sets
+ * up its wrap-around state for any of them.
+ */
+static unsigned int
+ts_prefilter			(const uint8_t *	src,
+				 unsigned int		src_left,
+				 unsigned int		pid)
+{
+	const uint8_t *p;
+	unsigned int n_packets;
+
+	p = src;
+	n_packets = src_left / 188;
+
+	/* Four headers at a time, testing them with a single
+	   branch. */
+	while (n_packets >= 4) {
+		uint32_t h0, h1, h2, h3;
+
+		h0 = ts_header (p + 0 * 188);
+		h1 = ts_header (p + 1 * 188);
+		h2 = ts_header (p + 2 * 188);
+		h3 = ts_header (p + 3 * 188);
+
+		if (!(TS_OTHER_PID (h0, pid) & TS_OTHER_PID (h1, pid)
+		      & TS_OTHER_PID (h2, pid) & TS_OTHER_PID (h3, pid)))
+			break;
+
+		p += 4 * 188;
+		n_packets -= 4;
+	}
+
+	while (n_packets > 0 && TS_OTHER_PID (ts_header (p), pid)) {
+		p += 188;
+		--n_packets;
+	}
+
+	return p - src;
+}
+
 /**
  * @internal
  * @param src *src points to DVB PES data, will be incremented by the
@@ -1804,6 +2043,7 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 		unsigned int skip;
 		unsigned int adaptation_field_control;
 		unsigned int pid;
+		vbi_bool in_place;
 		uint8_t b1, b3;
 
 		consume = dx->ts_wrap.consume;
@@ -1913,6 +2153,37 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 
 		dx->ts_wrap.skip = 0;
 
+		if (likely (dx->ts_in_sync)
+		    && dx->ts_wrap.bp == dx->ts_buffer
+		    && 0 == (dx->frame.log.mask & VBI_LOG_DEBUG2)) {
+			unsigned int n_bytes;
+
+			/* Discard transport_packets of other PIDs
+			   right in the source buffer. */
+			n_bytes = ts_prefilter (s, s_left, dx->ts_pid);
+
+			s += n_bytes;
+			s_left -= n_bytes;
+		}
+
+		in_place = (likely (dx->ts_in_sync)
+			    && dx->ts_wrap.bp == dx->ts_buffer
+			    && s_left >= 188
+			    && 0x47 == s[0]);
+
+		if (in_place) {
+			/* The entire transport_packet is in the source
+			   buffer. Look at the header right there. */
+
+			p = s;
+			avail = TS_HEADER_LOOKAHEAD;
+
+			s += TS_HEADER_LOOKAHEAD;
+			s_left -= TS_HEADER_LOOKAHEAD;
+
+			goto examine_header;
+		}
+
 		/* NB. always > zero. */
 		lookahead = dx->ts_wrap.lookahead;
 
@@ -1955,6 +2226,7 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 				dx->new_frame = TRUE;
 
 				dx->ts_pes_todo = 0;
+				dx->ts_pes_in_place = FALSE;
 				dx->ts_wrap.consume = 0;
 
 				dx->ts_continuity = -1; /* unknown */
@@ -2020,6 +2292,7 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 			avail = dx->ts_wrap.bp - p;
 		}
 
+	examine_header:
 		b1 = p[1];
 		pid = (b1 * 256 + p[2]) & 0x1FFF;
 		b3 = p[3];
@@ -2155,6 +2428,10 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 
 			dx->ts_pes_bp = dx->pes_buffer;
 			dx->ts_pes_todo = packet_length + 6;
+
+			/* Try to collect the payload in place. */
+			dx->ts_pes_in_place = in_place;
+			dx->ts_pes_n_chunks = 0;
 		} else {
 			/* payload_unit_start_indicator */
 			if (unlikely (0 != (b1 & 0x40))) {
@@ -2169,6 +2446,56 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 			}
 		}
 
+		if (dx->ts_pes_in_place) {
+			const uint8_t *du;
+			unsigned int offset;
+
+			consume = MIN (dx->ts_pes_todo, 184u);
+
+			du = p + 4;
+
+			/* PES header, data_identifier. */
+			offset = (0 == dx->ts_pes_n_chunks) ? 46 : 0;
+
+			if (!in_place
+			    || !ts_payload_aligned (du + offset,
+						    du + consume)) {
+				/* Data units straddle transport_packets
+				   or calls. Copy the PES packet into
+				   dx->pes_buffer after all. */
+				ts_pes_spill (dx);
+
+				goto copy_payload;
+			}
+
+			/* Remember where the payload is, we extract
+			   the data units when the PES packet is
+			   complete. Like the copying path we must
+			   not touch the frame before that, in case
+			   the PES packet turns out to be broken. */
+			dx->ts_pes_chunks[dx->ts_pes_n_chunks++] = du;
+			dx->ts_pes_todo -= consume;
+
+			/* Skip the payload we consumed, the copying
+			   path reads at least the TS_HEADER_LOOKAHEAD
+			   bytes we already looked at. */
+			dx->ts_wrap.skip = 4 + MAX (consume, 6u)
+				- TS_HEADER_LOOKAHEAD;
+
+			dx->ts_wrap.bp = dx->ts_buffer;
+			dx->ts_wrap.lookahead = TS_HEADER_LOOKAHEAD;
+
+			if (dx->ts_pes_todo > 0)
+				continue;
+
+			err = demux_ts_pes_in_place (dx, consume);
+			if (VBI_ERR_CALLBACK == err)
+				goto error_return;
+
+			continue;
+		}
+
+	copy_payload:
 		if (likely (avail <= 188)) {
 			consume = MIN (dx->ts_pes_todo, 184u);
 			fragment = MIN (avail - 4, consume);
@@ -2213,6 +2540,7 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 
 		/* Skip to next PES packet header. */
 		dx->ts_pes_todo = 0;
+		dx->ts_pes_in_place = FALSE;
 		dx->ts_wrap.consume = 0;
 
 	skip_ts_packet:
@@ -2241,6 +2569,11 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 	assert (0);
 
  need_more_data_return:
+	if (dx->ts_pes_in_place) {
+		/* The caller may reuse the source buffer. */
+		ts_pes_spill (dx);
+	}
+
 	*src = s + s_left;
 	*src_left = 0;
 
@@ -2252,6 +2585,7 @@ demux_ts_packet			(vbi_dvb_demux *	dx,
 
 	/* Skip to next PES packet header. */
 	dx->ts_pes_todo = 0;
+	dx->ts_pes_in_place = FALSE;
 	dx->ts_wrap.consume = 0;
 
 	if (likely (avail <= 188)) {
@@ -2361,6 +2695,96 @@ vbi_dvb_demux_cor		(vbi_dvb_demux *	dx,
 	return 0; /* need more data */
 }
 
+/**
+ * @internal
+ * @param dx DVB demultiplexer context allocated with
+ *   vbi_dvb_pes_demux_new() or _vbi_dvb_ts_demux_new(), without
+ *   a callback function.
+ * @param frames Information about the demultiplexed frames will be
+ *   stored here.
+ * @param max_frames At most this number of frames will be stored
+ *   in the @a frames array.
+ * @param sliced Demultiplexed sliced data of all frames will be
+ *   stored here, one frame after the other.
+ * @param max_lines Number of elements in the @a sliced array. Should
+ *   be at least 64 times @a max_frames.
+ * @param buffer *buffer points to DVB PES or TS data, will be
+ *   incremented by the number of bytes read from the buffer.
+ * @param buffer_left *buffer_left is the number of bytes left in
+ *   @a buffer, will be decremented by the number of bytes read.
+ *
+ * Like vbi_dvb_demux_cor() but returns the sliced data of more
+ * than one frame per call. The function stops when it has stored
+ * @a max_frames frames, when the space left in the @a sliced array
+ * may be insufficient for another frame, or when it has consumed all
+ * data in the @a buffer. Lines of frame n are stored at
+ * @a sliced[@a frames[n].first_line] and following.
+ *
+ * When @a max_lines is too small for even one frame, the function
+ * truncates the frame like vbi_dvb_demux_cor().
+ *
+ * @returns
+ * The number of elements stored in the @a frames array.
+ */
+unsigned int
+_vbi_dvb_demux_cor_batch	(vbi_dvb_demux *	dx,
+				 _vbi_dvb_demux_frame *	frames,
+				 unsigned int		max_frames,
+				 vbi_sliced *		sliced,
+				 unsigned int		max_lines,
+				 const uint8_t **	buffer,
+				 unsigned int *		buffer_left)
+{
+	unsigned int frame_capacity;
+	unsigned int n_frames;
+	unsigned int n_lines;
+
+	assert (NULL != dx);
+	assert (NULL != frames);
+	assert (NULL != sliced);
+	assert (NULL != buffer);
+	assert (NULL != buffer_left);
+
+	assert (NULL == dx->callback);
+
+	frame_capacity = dx->frame.sliced_end - dx->frame.sliced_begin;
+
+	n_frames = 0;
+	n_lines = 0;
+
+	while (n_frames < max_frames && *buffer_left > 0) {
+		unsigned int n;
+
+		/* A complete frame cannot wait until the next call,
+		   we must have room for the largest possible one. */
+		if (n_frames > 0 && max_lines - n_lines < frame_capacity)
+			break;
+
+		if (0 == dx->demux_packet (dx, buffer, buffer_left))
+			continue; /* need more data */
+
+		n = dx->frame.sp - dx->frame.sliced_begin;
+		n = MIN (n, max_lines - n_lines); /* XXX error msg */
+
+		if (0 == n)
+			continue;
+
+		memcpy (sliced + n_lines, dx->frame.sliced_begin,
+			n * sizeof (*sliced));
+
+		dx->frame.sp = dx->frame.sliced_begin;
+
+		frames[n_frames].pts = dx->frame_pts;
+		frames[n_frames].first_line = n_lines;
+		frames[n_frames].n_lines = n;
+
+		++n_frames;
+		n_lines += n;
+	}
+
+	return n_frames;
+}
+
 /**
  * @brief Feeds DVB VBI demux with data.
  * @param dx DVB demultiplexer context allocated with vbi_dvb_pes_demux_new().
@@ -2434,7 +2858,21 @@ vbi_dvb_demux_reset		(vbi_dvb_demux *	dx)
 
 	dx->frame.sp = dx->sliced;
 
-	/* Raw data ignored for now. */
+	if (NULL != dx->raw_buffer[0]) {
+		unsigned int i = dx->raw_index;
+
+		dx->frame.raw = dx->raw_buffer[i];
+		dx->frame.rp = dx->raw_buffer[i];
+
+		dx->frame.raw_start[0] = dx->raw_start[0];
+		dx->frame.raw_start[1] = dx->raw_start[1];
+		dx->frame.raw_count[0] = dx->raw_count[0];
+		dx->frame.raw_count[1] = dx->raw_count[1];
+
+		/* Contents unknown. */
+		dx->frame.raw_written = TRUE;
+		dx->raw_written[i ^ 1] = TRUE;
+	}
 
 	dx->frame_pts = 0;
 	dx->packet_pts = 0;
@@ -2448,6 +2886,8 @@ vbi_dvb_demux_reset		(vbi_dvb_demux *	dx)
 
 	dx->ts_pes_bp = NULL;
 	dx->ts_pes_todo = 0;
+	dx->ts_pes_in_place = FALSE;
+	dx->ts_pes_n_chunks = 0;
 
 	dx->ts_continuity = -1; /* unknown */
 }
@@ -2488,6 +2928,141 @@ vbi_dvb_demux_set_log_fn	(vbi_dvb_demux *	dx,
 	dx->frame.log.user_data = user_data;
 }
 
+/**
+ * @internal
+ * @param dx DVB demultiplexer context allocated with
+ *   vbi_dvb_pes_demux_new() or _vbi_dvb_ts_demux_new().
+ * @param buffer0 Raw VBI buffer.
+ * @param buffer1 Second raw VBI buffer for double buffering.
+ *   Can be @c NULL.
+ * @param sp Describes the layout of the buffers. Can be @c NULL
+ *   if @a buffer0 and @a buffer1 are @c NULL. Otherwise
+ *   - .scanning must be 625 or 525,
+ *   - .sampling_format must be @c VBI_PIXFMT_YUV420 (only the
+ *     luminance samples are stored),
+ *   - .sampling_rate must be @c 13500000,
+ *   - .bytes_per_line must be @c 720,
+ *   - .offset must be the start of the digital active line
+ *     as defined in ITU-R BT.601 (132 for 625 line,
+ *     122 for 525 line systems),
+ *   - .start[] and .count[] must cover only lines 7 to 23 of
+ *     either field,
+ *   - .interlaced must be @c FALSE and .synchronous @c TRUE.
+ *
+ * By default the DVB demultiplexer discards raw VBI data
+ * (EN 301 775 "monochrome 4:2:2 samples" data units). With this
+ * function you can give the demultiplexer buffers to store the raw
+ * VBI lines of a frame. Each buffer must have room for
+ * (@a sp->count[0] + @a sp->count[1]) * 720 bytes. Lines not
+ * transmitted in a frame are cleared to zero, and the sliced
+ * data of the frame contains a @c VBI_SLICED_VBI_625 or
+ * @c VBI_SLICED_VBI_525 element for each line transmitted.
+ *
+ * When a frame is complete _vbi_dvb_demux_get_raw() returns the
+ * buffer containing its raw data, which can be passed to
+ * vbi_raw_decode() (or vbi3_raw_decoder_decode()) with @a sp without
+ * copying. With one buffer the data remains valid until the
+ * demultiplexer begins to store the next frame, that is until the
+ * callback function returns or until the next vbi_dvb_demux_cor()
+ * call. With two buffers the demultiplexer alternates between them,
+ * and the data remains valid until the next frame is complete.
+ *
+ * The buffers must remain allocated until the demultiplexer is
+ * deleted or this function is called again. Calling it resets the
+ * demultiplexer.
+ *
+ * @returns
+ * @c FALSE if the @a sp parameters are invalid.
+ */
+vbi_bool
+_vbi_dvb_demux_set_raw_buffers	(vbi_dvb_demux *	dx,
+				 uint8_t *		buffer0,
+				 uint8_t *		buffer1,
+				 const vbi_sampling_par *sp)
+{
+	assert (NULL != dx);
+
+	if (NULL == buffer0) {
+		buffer0 = buffer1;
+		buffer1 = NULL;
+	}
+
+	if (NULL != buffer0) {
+		unsigned int f2_start;
+		unsigned int offset;
+
+		assert (NULL != sp);
+
+		if (625 == sp->scanning) {
+			f2_start = 313;
+			offset = 864 - 12 - 720;
+		} else if (525 == sp->scanning) {
+			f2_start = 263;
+			offset = 858 - 16 - 720;
+		} else {
+			return FALSE;
+		}
+
+		if (VBI_PIXFMT_YUV420 != sp->sampling_format
+		    || 13500000 != sp->sampling_rate
+		    || 720 != sp->bytes_per_line
+		    || offset != (unsigned int) sp->offset
+		    || sp->interlaced
+		    || !sp->synchronous)
+			return FALSE;
+
+		if (sp->count[0] < 0 || sp->count[1] < 0
+		    || 0 == sp->count[0] + sp->count[1])
+			return FALSE;
+
+		if (sp->count[0] > 0
+		    && (sp->start[0] < 7
+			|| sp->start[0] + sp->count[0] > 24))
+			return FALSE;
+
+		if (sp->count[1] > 0
+		    && (sp->start[1] < (int)(f2_start + 7)
+			|| sp->start[1] + sp->count[1]
+			> (int)(f2_start + 24)))
+			return FALSE;
+
+		dx->raw_start[0] = sp->start[0];
+		dx->raw_start[1] = sp->start[1];
+		dx->raw_count[0] = sp->count[0];
+		dx->raw_count[1] = sp->count[1];
+	}
+
+	dx->raw_buffer[0] = buffer0;
+	dx->raw_buffer[1] = buffer1;
+	dx->raw_index = 0;
+
+	vbi_dvb_demux_reset (dx);
+
+	return TRUE;
+}
+
+/**
+ * @internal
+ * @param dx DVB demultiplexer context allocated with
+ *   vbi_dvb_pes_demux_new() or _vbi_dvb_ts_demux_new().
+ *
+ * Returns the raw VBI buffer containing the data of the frame just
+ * passed to the callback function, or returned by
+ * vbi_dvb_demux_cor(). See _vbi_dvb_demux_set_raw_buffers().
+ *
+ * @returns
+ * Pointer to one of the buffers passed to
+ * _vbi_dvb_demux_set_raw_buffers(), @c NULL if none were
+ * given.
+ */
+uint8_t *
+_vbi_dvb_demux_get_raw		(const vbi_dvb_demux *	dx)
+{
+	assert (NULL != dx);
+
+	return dx->frame.raw;
+}
+
 /**
  * @brief Deletes DVB VBI demux.
  * @param dx DVB demultiplexer context allocated with
@@ -2587,6 +3162,409 @@ vbi_dvb_pes_demux_new		(vbi_dvb_demux_cb *	callback,
 	return dx;
 }
 
+/** @internal */
+struct _vbi_dvb_multi_demux {
+	/**
+	 * Demultiplexer of each PID, @c NULL if the PID is not
+	 * wanted. Indexed by the 13 bit PID of the transport_packet.
+	 */
+	vbi_dvb_demux *		pid_dx[0x2000];
+
+	/** Incomplete transport_packet left over from the last call. */
+	uint8_t			packet[188];
+	unsigned int		packet_size;
+
+	/** The next incoming byte should be a sync_byte. */
+	vbi_bool		in_sync;
+
+	/** For _vbi_dvb_multi_demux_feed(). */
+	_vbi_dvb_multi_demux_cb *callback;
+	void *			user_data;
+
+	_vbi_log_hook		log;
+};
+
+static vbi_bool
+multi_demux_frame		(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	_vbi_dvb_multi_demux *mx = (_vbi_dvb_multi_demux *) user_data;
+
+	return mx->callback (mx, mx->user_data, dx->ts_pid,
+			     sliced, sliced_lines, pts);
+}
+
+/**
+ * @internal
+ * Resets a PID demultiplexer of @a mx. It only ever sees complete
+ * transport_packets starting with a sync_byte, so we can skip
+ * the sync_byte search of demux_ts_packet().
+ */
+static void
+multi_demux_reset_pid		(_vbi_dvb_multi_demux *	mx,
+				 vbi_dvb_demux *	dx)
+{
+	vbi_dvb_demux_reset (dx);
+
+	dx->frame.log = mx->log;
+
+	dx->ts_in_sync = TRUE;
+	dx->ts_wrap.lookahead = TS_HEADER_LOOKAHEAD;
+}
+
+static void
+multi_demux_sync_lost		(_vbi_dvb_multi_demux *	mx)
+{
+	unsigned int pid;
+
+	debug2 (&mx->log, "TS sync lost.");
+
+	mx->in_sync = FALSE;
+
+	/* Discard the data collected so far, so we don't
+	   accidentally combine PES packets of different frames. */
+	for (pid = 0; pid < N_ELEMENTS (mx->pid_dx); ++pid) {
+		if (NULL != mx->pid_dx[pid])
+			multi_demux_reset_pid (mx, mx->pid_dx[pid]);
+	}
+}
+
+/**
+ * @internal
+ * Searches for a sync_byte which is followed by another one 188
+ * bytes later, or by the end of the buffer.
+ *
+ * @returns
+ * @c FALSE if more data is needed, *src_left will be zero.
+ */
+static vbi_bool
+multi_demux_sync		(_vbi_dvb_multi_demux *	mx,
+				 const uint8_t **	src,
+				 unsigned int *		src_left)
+{
+	const uint8_t *p;
+	const uint8_t *p_end;
+
+	p = *src;
+	p_end = p + *src_left;
+
+	for (; p < p_end; ++p) {
+		if (0x47 == p[0]
+		    && (p + 188 >= p_end || 0x47 == p[188])) {
+			*src_left -= p - *src;
+			*src = p;
+
+			mx->in_sync = TRUE;
+
+			return TRUE;
+		}
+	}
+
+	*src = p_end;
+	*src_left = 0;
+
+	return FALSE;
+}
+
+/**
+ * @internal
+ * Passes one complete transport_packet to the demultiplexer of its
+ * PID, if any.
+ *
+ * @returns
+ * @c FALSE if the callback function returned @c FALSE.
+ */
+static vbi_bool
+multi_demux_packet		(_vbi_dvb_multi_demux *	mx,
+				 const uint8_t		packet[188])
+{
+	vbi_dvb_demux *dx;
+	const uint8_t *s;
+	unsigned int s_left;
+	unsigned int pid;
+	vbi_bool success;
+
+	pid = (packet[1] * 256 + packet[2]) & 0x1FFF;
+
+	dx = mx->pid_dx[pid];
+	if (NULL == dx)
+		return TRUE;
+
+	s = packet;
+	s_left = 188;
+
+	success = TRUE;
+
+	/* VBI_ERR_CALLBACK is the only error demux_ts_packet()
+	   reports at this time. Just continue after it. */
+	do {
+		if (0 != demux_ts_packet (dx, &s, &s_left))
+			success = FALSE;
+	} while (s_left > 0);
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new().
+ * @param buffer DVB TS data, need not align with packet boundaries.
+ * @param buffer_size Number of bytes in @a buffer, need not align
+ *   with packet size.
+ *
+ * Like vbi_dvb_demux_feed(), but examines each transport_packet
+ * only once and passes it to the demultiplexer of its PID. The
+ * callback function given to _vbi_dvb_multi_demux_new() is called
+ * when a new frame of any PID is complete.
+ *
+ * @returns
+ * @c FALSE if the callback function returned @c FALSE.
+ */
+vbi_bool
+_vbi_dvb_multi_demux_feed	(_vbi_dvb_multi_demux *	mx,
+				 const uint8_t *	buffer,
+				 unsigned int		buffer_size)
+{
+	const uint8_t *s;
+	unsigned int s_left;
+	vbi_bool success;
+
+	assert (NULL != mx);
+	assert (NULL != buffer);
+
+	s = buffer;
+	s_left = buffer_size;
+
+	success = TRUE;
+
+	if (mx->packet_size > 0) {
+		unsigned int n;
+
+		/* Complete the packet left over from the last call. */
+
+		n = MIN (188 - mx->packet_size, s_left);
+
+		memcpy (mx->packet + mx->packet_size, s, n);
+		mx->packet_size += n;
+
+		s += n;
+		s_left -= n;
+
+		if (mx->packet_size < 188)
+			return TRUE;
+
+		mx->packet_size = 0;
+
+		if (likely (0x47 == mx->packet[0])) {
+			success &= multi_demux_packet (mx, mx->packet);
+		} else {
+			multi_demux_sync_lost (mx);
+		}
+	}
+
+	while (s_left > 0) {
+		if (unlikely (!mx->in_sync)) {
+			if (!multi_demux_sync (mx, &s, &s_left))
+				break;
+		}
+
+		if (s_left < 188) {
+			memcpy (mx->packet, s, s_left);
+			mx->packet_size = s_left;
+			break;
+		}
+
+		if (unlikely (0x47 != s[0])) {
+			multi_demux_sync_lost (mx);
+			continue;
+		}
+
+		success &= multi_demux_packet (mx, s);
+
+		s += 188;
+		s_left -= 188;
+	}
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new().
+ * @param pid Transport stream PID of a VBI elementary stream.
+ *
+ * Adds @a pid to the set of PIDs demultiplexed by @a mx. Adding
+ * a PID twice has no effect.
+ *
+ * @returns
+ * @c FALSE if @a pid is invalid or memory is exhausted.
+ */
+vbi_bool
+_vbi_dvb_multi_demux_add_pid	(_vbi_dvb_multi_demux *	mx,
+				 unsigned int		pid)
+{
+	vbi_dvb_demux *dx;
+
+	assert (NULL != mx);
+
+	if (pid >= N_ELEMENTS (mx->pid_dx))
+		return FALSE;
+
+	if (NULL != mx->pid_dx[pid])
+		return TRUE;
+
+	/* Checks the pid too. */
+	dx = _vbi_dvb_ts_demux_new (multi_demux_frame, mx, pid);
+	if (NULL == dx)
+		return FALSE;
+
+	multi_demux_reset_pid (mx, dx);
+
+	mx->pid_dx[pid] = dx;
+
+	return TRUE;
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new().
+ * @param pid Transport stream PID.
+ *
+ * Removes @a pid from the set of PIDs demultiplexed by @a mx,
+ * discarding any data collected for this PID so far.
+ */
+void
+_vbi_dvb_multi_demux_remove_pid	(_vbi_dvb_multi_demux *	mx,
+				 unsigned int		pid)
+{
+	assert (NULL != mx);
+
+	if (pid >= N_ELEMENTS (mx->pid_dx))
+		return;
+
+	vbi_dvb_demux_delete (mx->pid_dx[pid]);
+	mx->pid_dx[pid] = NULL;
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new().
+ *
+ * Resets @a mx and the demultiplexers of all PIDs to the initial
+ * state, useful for example after a channel change. The set of
+ * PIDs remains unchanged.
+ */
+void
+_vbi_dvb_multi_demux_reset	(_vbi_dvb_multi_demux *	mx)
+{
+	assert (NULL != mx);
+
+	multi_demux_sync_lost (mx);
+
+	mx->packet_size = 0;
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new().
+ * @param mask Which kind of information to log. Can be @c 0.
+ * @param log_fn This function is called with log messages. Can be
+ *   @c NULL to disable logging.
+ * @param user_data User pointer passed through to the @a log_fn function.
+ *
+ * Like vbi_dvb_demux_set_log_fn(), for @a mx and all its PIDs.
+ */
+void
+_vbi_dvb_multi_demux_set_log_fn	(_vbi_dvb_multi_demux *	mx,
+				 vbi_log_mask		mask,
+				 vbi_log_fn *		log_fn,
+				 void *			user_data)
+{
+	unsigned int pid;
+
+	assert (NULL != mx);
+
+	if (NULL == log_fn)
+		mask = 0;
+
+	mx->log.mask = mask;
+	mx->log.fn = log_fn;
+	mx->log.user_data = user_data;
+
+	for (pid = 0; pid < N_ELEMENTS (mx->pid_dx); ++pid) {
+		if (NULL != mx->pid_dx[pid])
+			mx->pid_dx[pid]->frame.log = mx->log;
+	}
+}
+
+/**
+ * @internal
+ * @param mx Multi-PID demultiplexer allocated with
+ *   _vbi_dvb_multi_demux_new(), can be @c NULL.
+ *
+ * Frees all resources associated with @a mx.
+ */
+void
+_vbi_dvb_multi_demux_delete	(_vbi_dvb_multi_demux *	mx)
+{
+	unsigned int pid;
+
+	if (NULL == mx)
+		return;
+
+	for (pid = 0; pid < N_ELEMENTS (mx->pid_dx); ++pid)
+		vbi_dvb_demux_delete (mx->pid_dx[pid]);
+
+	CLEAR (*mx);
+
+	vbi_free (mx);
+}
+
+/**
+ * @internal
+ * @param callback Function to be called by _vbi_dvb_multi_demux_feed()
+ *   when a new frame is available.
+ * @param user_data User pointer passed through to @a callback function.
+ *
+ * Allocates a new DVB VBI demultiplexer taking a Transport Stream
+ * with any number of VBI PIDs as input, for example a complete DVB
+ * multiplex. Call _vbi_dvb_multi_demux_add_pid() to select the PIDs.
+ *
+ * @returns
+ * Pointer to newly allocated demux context which must be freed with
+ * _vbi_dvb_multi_demux_delete() when done. @c NULL on failure
+ * (out of memory).
+ */
+_vbi_dvb_multi_demux *
+_vbi_dvb_multi_demux_new	(_vbi_dvb_multi_demux_cb *callback,
+				 void *			user_data)
+{
+	_vbi_dvb_multi_demux *mx;
+
+	assert (NULL != callback);
+
+	mx = vbi_malloc (sizeof (*mx));
+	if (NULL == mx) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	CLEAR (*mx);
+
+	mx->callback = callback;
+	mx->user_data = user_data;
+
+	return mx;
+}
+
 /* For compatibility with Zapping 0.8 */
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -27,6 +27,7 @@
 #include <inttypes.h>		/* uintN_t */
 #include "bcd.h"		/* vbi_bool */
 #include "sliced.h"		/* vbi_sliced, vbi_service_set */
+#include "sampling_par.h"	/* vbi_sampling_par */
 
 VBI_BEGIN_DECLS
 
@@ -105,11 +106,97 @@ _vbi_dvb_demultiplex_sliced	(vbi_sliced *		sliced,
 				 unsigned int *		buffer_left)
   _vbi_nonnull ((1, 2, 4, 5));
 /* Experimental. */
+typedef struct {
+	/* Presentation Time Stamp of the frame. */
+	int64_t			pts;
+
+	/* Index of the first line of the frame in the sliced array. */
+	unsigned int		first_line;
+
+	/* Number of lines. */
+	unsigned int		n_lines;
+} _vbi_dvb_demux_frame;
+
+extern unsigned int
+_vbi_dvb_demux_cor_batch	(vbi_dvb_demux *	dx,
+				 _vbi_dvb_demux_frame *	frames,
+				 unsigned int		max_frames,
+				 vbi_sliced *		sliced,
+				 unsigned int		max_lines,
+				 const uint8_t **	buffer,
+				 unsigned int *		buffer_left)
+  _vbi_nonnull ((1, 2, 4, 6, 7));
+/* Experimental. */
+extern vbi_bool
+_vbi_dvb_demux_set_raw_buffers	(vbi_dvb_demux *	dx,
+				 uint8_t *		buffer0,
+				 uint8_t *		buffer1,
+				 const vbi_sampling_par *sp)
+  _vbi_nonnull ((1));
+extern uint8_t *
+_vbi_dvb_demux_get_raw		(const vbi_dvb_demux *	dx)
+  _vbi_nonnull ((1));
+/* Experimental. */
 extern vbi_dvb_demux *
 _vbi_dvb_ts_demux_new		(vbi_dvb_demux_cb *	callback,
 				 void *			user_data,
 				 unsigned int		pid);
 
+/* Experimental. */
+typedef struct _vbi_dvb_multi_demux _vbi_dvb_multi_demux;
+typedef vbi_bool
+_vbi_dvb_multi_demux_cb		(_vbi_dvb_multi_demux *	mx,
+				 void *			user_data,
+				 unsigned int		pid,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts);
+extern vbi_bool
+_vbi_dvb_multi_demux_feed	(_vbi_dvb_multi_demux *	mx,
+				 const uint8_t *	buffer,
+				 unsigned int		buffer_size)
+  _vbi_nonnull ((1, 2));
+extern vbi_bool
+_vbi_dvb_multi_demux_add_pid	(_vbi_dvb_multi_demux *	mx,
+				 unsigned int		pid)
+  _vbi_nonnull ((1));
+extern void
+_vbi_dvb_multi_demux_remove_pid	(_vbi_dvb_multi_demux *	mx,
+				 unsigned int		pid)
+  _vbi_nonnull ((1));
+extern void
+_vbi_dvb_multi_demux_reset	(_vbi_dvb_multi_demux *	mx)
+  _vbi_nonnull ((1));
+extern void
+_vbi_dvb_multi_demux_set_log_fn	(_vbi_dvb_multi_demux *	mx,
+				 vbi_log_mask		mask,
+				 vbi_log_fn *		log_fn,
+				 void *			user_data)
+  _vbi_nonnull ((1));
+extern void
+_vbi_dvb_multi_demux_delete	(_vbi_dvb_multi_demux *	mx);
+extern _vbi_dvb_multi_demux *
+_vbi_dvb_multi_demux_new	(_vbi_dvb_multi_demux_cb *callback,
+				 void *			user_data)
+  _vbi_alloc _vbi_nonnull ((1));
+
+/* Experimental. dvb_demux_file.c */
+extern vbi_bool
+_vbi_dvb_demux_buffer		(const uint8_t *	buffer,
+				 size_t			buffer_size,
+				 unsigned int		ts_pid,
+				 unsigned int		n_threads,
+				 vbi_dvb_demux_cb *	callback,
+				 void *			user_data)
+  _vbi_nonnull ((1, 5));
+extern vbi_bool
+_vbi_dvb_demux_file		(const char *		file_name,
+				 unsigned int		ts_pid,
+				 unsigned int		n_threads,
+				 vbi_dvb_demux_cb *	callback,
+				 void *			user_data)
+  _vbi_nonnull ((1, 4));
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_DVB_DEMUX_H__ */
@@ -0,0 +1,545 @@
+/*
+ *  libzvbi -- Parallel DVB VBI file demultiplexer
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ *  Boston, MA  02110-1301  USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "misc.h"
+#include "dvb.h"
+#include "dvb_demux.h"
+
+/* Archive recordings can be many gigabytes large. We split the file
+   into chunks at the beginning of VBI PES packets, demultiplex a
+   batch of chunks in parallel with independent vbi_dvb_demux
+   instances, then pass the frames of each chunk to the caller in
+   stream order, which is PTS order. Each chunk holds the frames
+   starting in that chunk, so memory consumption is bounded by the
+   chunk size times the number of threads. */
+
+/* Approximate chunk size in bytes. */
+#define CHUNK_SIZE (8 << 20)
+
+/** @internal */
+struct file_frame {
+	int64_t			pts;
+
+	/** Lines in struct file_chunk.sliced. */
+	unsigned int		first_line;
+	unsigned int		n_lines;
+};
+
+/** @internal */
+struct file_chunk {
+	/** Data of this chunk, first byte of a PES packet. */
+	const uint8_t *		begin;
+	const uint8_t *		end;
+
+	/** End of the file. */
+	const uint8_t *		buffer_end;
+
+	/** PID of the VBI stream, 0 if the file is a PES stream. */
+	unsigned int		ts_pid;
+
+	/** Frames found in this chunk. */
+	struct file_frame *	frames;
+	unsigned int		n_frames;
+	unsigned int		max_frames;
+
+	vbi_sliced *		sliced;
+	unsigned int		n_lines;
+	unsigned int		max_lines;
+
+	/**
+	 * We are looking at data beyond the end of the chunk, waiting
+	 * for the demultiplexer to flush the last frame starting in
+	 * the chunk.
+	 */
+	vbi_bool		in_tail;
+	vbi_bool		tail_done;
+
+	/** FALSE if we ran out of memory. */
+	vbi_bool		success;
+};
+
+static vbi_bool
+chunk_add_frame			(struct file_chunk *	ch,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	struct file_frame *fr;
+
+	if (ch->n_frames >= ch->max_frames) {
+		struct file_frame *new_frames;
+		unsigned int new_max;
+
+		new_max = MAX (ch->max_frames * 2, 256u);
+		new_frames = vbi_realloc (ch->frames,
+					  new_max * sizeof (*new_frames));
+		if (NULL == new_frames)
+			return FALSE;
+
+		ch->frames = new_frames;
+		ch->max_frames = new_max;
+	}
+
+	if (ch->n_lines + sliced_lines > ch->max_lines) {
+		vbi_sliced *new_sliced;
+		unsigned int new_max;
+
+		new_max = MAX (ch->max_lines * 2,
+			       ch->n_lines + sliced_lines);
+		new_max = MAX (new_max, 256u * 32);
+		new_sliced = vbi_realloc (ch->sliced,
+					  new_max * sizeof (*new_sliced));
+		if (NULL == new_sliced)
+			return FALSE;
+
+		ch->sliced = new_sliced;
+		ch->max_lines = new_max;
+	}
+
+	fr = &ch->frames[ch->n_frames++];
+
+	fr->pts = pts;
+	fr->first_line = ch->n_lines;
+	fr->n_lines = sliced_lines;
+
+	memcpy (ch->sliced + ch->n_lines, sliced,
+		sliced_lines * sizeof (*sliced));
+	ch->n_lines += sliced_lines;
+
+	return TRUE;
+}
+
+static vbi_bool
+chunk_frame_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	struct file_chunk *ch = (struct file_chunk *) user_data;
+
+	dx = dx; /* unused */
+
+	if (!chunk_add_frame (ch, sliced, sliced_lines, pts)) {
+		ch->success = FALSE;
+		return FALSE;
+	}
+
+	if (ch->in_tail) {
+		/* That was the last frame starting in this chunk,
+		   the next one belongs to the next chunk. */
+		ch->tail_done = TRUE;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void *
+chunk_thread			(void *			arg)
+{
+	struct file_chunk *ch = (struct file_chunk *) arg;
+	vbi_dvb_demux *dx;
+	const uint8_t *p;
+
+	if (0 != ch->ts_pid) {
+		dx = _vbi_dvb_ts_demux_new (chunk_frame_cb, ch, ch->ts_pid);
+	} else {
+		dx = vbi_dvb_pes_demux_new (chunk_frame_cb, ch);
+	}
+
+	if (NULL == dx) {
+		ch->success = FALSE;
+		return NULL;
+	}
+
+	vbi_dvb_demux_feed (dx, ch->begin, ch->end - ch->begin);
+
+	/* A frame is complete when the next one begins. Feed the
+	   demultiplexer a little at a time until it flushes the
+	   last frame of this chunk. */
+
+	ch->in_tail = TRUE;
+
+	for (p = ch->end; ch->success && !ch->tail_done
+		     && p < ch->buffer_end; p += 188) {
+		unsigned int size;
+
+		size = ch->buffer_end - p;
+		size = MIN (size, 188u);
+		vbi_dvb_demux_feed (dx, p, size);
+	}
+
+	vbi_dvb_demux_delete (dx);
+
+	return NULL;
+}
+
+/**
+ * @internal
+ * Returns the PTS in the VBI PES packet header at @a p, or -1 if
+ * @a p does not look like a VBI PES packet with a PTS.
+ */
+static int64_t
+pes_packet_pts			(const uint8_t *	p,
+				 const uint8_t *	p_end)
+{
+	if (p_end - p < 9 + 5)
+		return -1;
+
+	/* packet_start_code_prefix, stream_id, '10', PTS_DTS_flags,
+	   EN 300 472 section 4.2 PES_header_data_length. */
+	if (0x00 != p[0] || 0x00 != p[1] || 0x01 != p[2]
+	    || PRIVATE_STREAM_1 != p[3]
+	    || 0x80 != (p[6] & 0xC0)
+	    || 0 == (p[7] & 0x80)
+	    || 36 != p[8])
+		return -1;
+
+	return ((int64_t)(p[9] & 0x0E) << 29)
+		| (p[10] << 22) | ((p[11] & ~1) << 14)
+		| (p[12] << 7) | (p[13] >> 1);
+}
+
+/**
+ * @internal
+ * Finds the first VBI PES packet at or after @a p which
+ * carries a different PTS than the one before it. We split the
+ * file there, assuming the packet begins a new frame.
+ *
+ * @returns
+ * Pointer to the first byte of the PES or TS packet, or @a p_end
+ * if no such packet was found.
+ */
+static const uint8_t *
+find_chunk_boundary		(const uint8_t *	p,
+				 const uint8_t *	p_end,
+				 unsigned int		ts_pid)
+{
+	int64_t last_pts;
+
+	last_pts = -1;
+
+	if (0 != ts_pid) {
+		/* sync_byte search. */
+		for (; p_end - p >= 3 * 188; ++p) {
+			if (0x47 == p[0]
+			    && 0x47 == p[188]
+			    && 0x47 == p[2 * 188])
+				break;
+		}
+
+		for (; p_end - p >= 188; p += 188) {
+			unsigned int pid;
+			int64_t pts;
+
+			pid = (p[1] * 256 + p[2]) & 0x1FFF;
+
+			/* Our PID, payload_unit_start_indicator,
+			   payload only. */
+			if (pid != ts_pid
+			    || 0x40 != (p[1] & 0xC0)
+			    || 0x10 != (p[3] & 0x30))
+				continue;
+
+			pts = pes_packet_pts (p + 4, p + 188);
+			if (pts < 0)
+				continue;
+
+			if (last_pts >= 0 && pts != last_pts)
+				return p;
+
+			last_pts = pts;
+		}
+	} else {
+		for (; p_end - p >= 4; ++p) {
+			unsigned int packet_length;
+			const uint8_t *next;
+			int64_t pts;
+
+			pts = pes_packet_pts (p, p_end);
+			if (pts < 0)
+				continue;
+
+			/* The next PES packet should follow this one,
+			   otherwise we may have found a start code in
+			   the payload. */
+			packet_length = p[4] * 256 + p[5];
+			next = p + 6 + packet_length;
+			if (p_end - next >= 3
+			    && (0x00 != next[0] || 0x00 != next[1]
+				|| 0x01 != next[2]))
+				continue;
+
+			if (last_pts >= 0 && pts != last_pts)
+				return p;
+
+			last_pts = pts;
+
+			if (next > p_end)
+				break;
+
+			p = next - 1;
+		}
+	}
+
+	return p_end;
+}
+
+/**
+ * @internal
+ * @param buffer DVB PES or TS stream, usually a memory mapped file.
+ * @param buffer_size Number of bytes in @a buffer.
+ * @param ts_pid PID of the VBI stream in a TS, or 0 if
+ *   @a buffer contains a PES stream.
+ * @param n_threads Number of chunks to demultiplex in parallel.
+ *   0 selects the number of online CPUs.
+ * @param callback Function to be called with each frame of sliced
+ *   data. The @a dx parameter will be @c NULL.
+ * @param user_data User pointer passed through to @a callback.
+ *
+ * Demultiplexes an entire DVB stream in memory. The function splits
+ * the stream into chunks at the beginning of VBI PES packets,
+ * demultiplexes the chunks in parallel threads and calls @a callback
+ * with the frames in the order they appear in the stream, which
+ * should be PTS order.
+ *
+ * @returns
+ * @c FALSE if @a callback returned @c FALSE, or if memory or threads
+ * could not be allocated.
+ */
+vbi_bool
+_vbi_dvb_demux_buffer		(const uint8_t *	buffer,
+				 size_t			buffer_size,
+				 unsigned int		ts_pid,
+				 unsigned int		n_threads,
+				 vbi_dvb_demux_cb *	callback,
+				 void *			user_data)
+{
+	struct file_chunk *chunks;
+	pthread_t *threads;
+	const uint8_t *p;
+	const uint8_t *p_end;
+	vbi_bool success;
+	unsigned int i;
+
+	assert (NULL != buffer);
+	assert (NULL != callback);
+
+	if (0 == n_threads) {
+		long n_cpus;
+
+		n_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+		n_threads = (n_cpus > 0) ? (unsigned int) n_cpus : 1;
+	}
+
+	chunks = vbi_malloc (n_threads * sizeof (*chunks));
+	threads = vbi_malloc (n_threads * sizeof (*threads));
+	if (NULL == chunks || NULL == threads) {
+		vbi_free (threads);
+		vbi_free (chunks);
+		errno = ENOMEM;
+		return FALSE;
+	}
+
+	memset (chunks, 0, n_threads * sizeof (*chunks));
+
+	success = TRUE;
+
+	p = buffer;
+	p_end = buffer + buffer_size;
+
+	while (success && p < p_end) {
+		unsigned int n_chunks;
+
+		/* Split the next batch. */
+
+		for (n_chunks = 0; n_chunks < n_threads
+			     && p < p_end; ++n_chunks) {
+			struct file_chunk *ch = &chunks[n_chunks];
+
+			ch->begin = p;
+
+			if ((size_t)(p_end - p) <= CHUNK_SIZE) {
+				p = p_end;
+			} else {
+				p = find_chunk_boundary (p + CHUNK_SIZE,
+							 p_end, ts_pid);
+			}
+
+			ch->end = p;
+			ch->buffer_end = p_end;
+			ch->ts_pid = ts_pid;
+
+			ch->n_frames = 0;
+			ch->n_lines = 0;
+
+			ch->in_tail = FALSE;
+			ch->tail_done = FALSE;
+			ch->success = TRUE;
+		}
+
+		/* Demultiplex the chunks. */
+
+		for (i = 0; i < n_chunks; ++i) {
+			if (0 != pthread_create (&threads[i], NULL,
+						 chunk_thread, &chunks[i])) {
+				chunk_thread (&chunks[i]);
+				threads[i] = pthread_self ();
+			}
+		}
+
+		for (i = 0; i < n_chunks; ++i) {
+			if (!pthread_equal (threads[i], pthread_self ()))
+				pthread_join (threads[i], NULL);
+		}
+
+		/* Output in stream order. */
+
+		for (i = 0; i < n_chunks; ++i) {
+			struct file_chunk *ch = &chunks[i];
+			unsigned int j;
+
+			if (!ch->success) {
+				errno = ENOMEM;
+				success = FALSE;
+				break;
+			}
+
+			for (j = 0; j < ch->n_frames; ++j) {
+				const struct file_frame *fr = &ch->frames[j];
+
+				if (!callback (/* dx */ NULL, user_data,
+					       ch->sliced + fr->first_line,
+					       fr->n_lines, fr->pts)) {
+					success = FALSE;
+					break;
+				}
+			}
+
+			if (!success)
+				break;
+		}
+	}
+
+	for (i = 0; i < n_threads; ++i) {
+		vbi_free (chunks[i].sliced);
+		vbi_free (chunks[i].frames);
+	}
+
+	vbi_free (threads);
+	vbi_free (chunks);
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param file_name Name of a DVB PES or TS file.
+ * @param ts_pid PID of the VBI stream in a TS, or 0 if the file
+ *   contains a PES stream.
+ * @param n_threads Number of chunks to demultiplex in parallel.
+ *   0 selects the number of online CPUs.
+ * @param callback Function to be called with each frame of sliced
+ *   data. The @a dx parameter will be @c NULL.
+ * @param user_data User pointer passed through to @a callback.
+ *
+ * Maps the file into memory and demultiplexes it with
+ * _vbi_dvb_demux_buffer().
+ *
+ * @returns
+ * @c FALSE if the file could not be mapped, if @a callback returned
+ * @c FALSE, or if memory or threads could not be allocated. errno
+ * may contain the reason.
+ */
+vbi_bool
+_vbi_dvb_demux_file		(const char *		file_name,
+				 unsigned int		ts_pid,
+				 unsigned int		n_threads,
+				 vbi_dvb_demux_cb *	callback,
+				 void *			user_data)
+{
+	struct stat st;
+	void *buffer;
+	vbi_bool success;
+	int saved_errno;
+	int fd;
+
+	assert (NULL != file_name);
+	assert (NULL != callback);
+
+	fd = open (file_name, O_RDONLY);
+	if (-1 == fd)
+		return FALSE;
+
+	if (-1 == fstat (fd, &st)) {
+		saved_errno = errno;
+		close (fd);
+		errno = saved_errno;
+		return FALSE;
+	}
+
+	if (0 == st.st_size) {
+		close (fd);
+		return TRUE;
+	}
+
+	buffer = mmap (NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	saved_errno = errno;
+	close (fd);
+
+	if (MAP_FAILED == buffer) {
+		errno = saved_errno;
+		return FALSE;
+	}
+
+#ifdef MADV_SEQUENTIAL
+	madvise (buffer, st.st_size, MADV_SEQUENTIAL);
+#endif
+
+	success = _vbi_dvb_demux_buffer (buffer, st.st_size, ts_pid,
+					 n_threads, callback, user_data);
+
+	saved_errno = errno;
+	munmap (buffer, st.st_size);
+	errno = saved_errno;
+
+	return success;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -26,6 +26,7 @@
 #endif
 
 #include <errno.h>
+#include <sys/uio.h>		/* struct iovec */
 
 #include "misc.h"
 #include "hamm.h"		/* vbi_rev8() */
@@ -112,6 +113,20 @@ static const unsigned int BT601_625_OFFSET = 864 - 12 - 720;
 static const unsigned int MAX_PES_PACKET_SIZE =
 	6 + 65535 - (6 + 65535) % 184;
 
+/* Max. number of TS packets per PES packet. */
+#define MAX_TS_PACKETS ((6 + 65535) / 184)
+
+/* Teletext data unit header, EN 301 775 section 4.5.2:
+   data_unit_id [8], data_unit_length [8],
+   reserved [2], field_parity, line_offset [5] (to be filled in),
+   framing_code [8] = vbi_rev8 (0x27),
+   followed by magazine_and_packet_address [16] and
+   data_block [320] (msb is first bit in VBI). */
+static const uint8_t
+teletext_du_template [4] = {
+	DATA_UNIT_EBU_TELETEXT_NON_SUBTITLE, 0x2C, 0xC0, 0xE4
+};
+
 /**
  * @internal
  * @param p Must point to the output buffer where the stuffing data
@@ -262,6 +277,7 @@ insert_sliced_data_units	(uint8_t **		packet,
 		const unsigned int f2_start = 313;
 		unsigned int du_size;
 		unsigned int line;
+		unsigned int line_byte;
 		unsigned int i;
 
 		/* Also skips VBI_SLICED_NONE (0). */
@@ -405,30 +421,26 @@ insert_sliced_data_units	(uint8_t **		packet,
 			break;
 		}
 
-		/* EN 301 775 table 1: N * stuffing_byte. */
-		if (fixed_length)
-			memset (p, 0xFF, du_size);
-
 		if (0 == line) {
 			/* EN 301 775 section 4.5.2 (Teletext data
 			   unit): Undefined line. */
 			if (last_line >= f2_start) {
 				/* Second field. */
-				p[2] = (3 << 6) + (0 << 5);
+				line_byte = (3 << 6) + (0 << 5);
 			} else {
 				/* First field. */
-				p[2] = (3 << 6) + (1 << 5);
+				line_byte = (3 << 6) + (1 << 5);
 			}
 		} else if (line < 32) {
 			/* Line 1 ... 31 of the first field. */
-			p[2] = (3 << 6) + (1 << 5) + line;
+			line_byte = (3 << 6) + (1 << 5) + line;
 		} else if (line < f2_start) {
 			goto bad_line;
 		} else if (line < f2_start + 32) {
 			/* reserved [2] = '11',
 			   field_parity = '0' (second field),
 			   line_offset [5]. */
-			p[2] = (3 << 6) + (0 << 5) + line - f2_start;
+			line_byte = (3 << 6) + (0 << 5) + line - f2_start;
 		} else {
 		bad_line:
 			*packet = p;
@@ -437,21 +449,33 @@ insert_sliced_data_units	(uint8_t **		packet,
 			return VBI_ERR_LINE_NUMBER;
 		}
 
+		if (s->id & VBI_SLICED_TELETEXT_B_625) {
+			/* Teletext data units are always 46 bytes
+			   long, no stuffing_bytes. */
+			memcpy (p, teletext_du_template,
+				sizeof (teletext_du_template));
+			p[2] = line_byte;
+
+			_vbi_rev8_block (p + 4, s->data, 42);
+
+			p += du_size;
+			p_left -= du_size;
+
+			*last_du_size = du_size;
+
+			continue;
+		}
+
+		/* EN 301 775 table 1: N * stuffing_byte. */
+		if (fixed_length)
+			memset (p, 0xFF, du_size);
+
 		/* data_unit_length [8] */
 		p[1] = du_size - 2;
 
-		if (s->id & VBI_SLICED_TELETEXT_B_625) {
-			/* data_unit_id [8], data_unit_length [8],
-			   reserved [2], field_parity, line_offset [5],
-			   framing_code [8],
-			   magazine_and_packet_address [16],
-			   data_block [320] (msb is first bit in VBI) */
-			p[0] = DATA_UNIT_EBU_TELETEXT_NON_SUBTITLE;
-			p[3] = 0xE4; /* vbi_rev8 (0x27); */
-
-			for (i = 0; i < 42; ++i)
-				p[4 + i] = vbi_rev8 (s->data[i]);
-		} else if (s->id & (VBI_SLICED_VPS | VBI_SLICED_VPS_F2)) {
+		p[2] = line_byte;
+
+		if (s->id & (VBI_SLICED_VPS | VBI_SLICED_VPS_F2)) {
 			/* data_unit_id [8], data_unit_length [8],
 			   reserved [2], field_parity, line_offset [5],
 			   vps_data_block [104] (msb first) */
@@ -1107,6 +1131,32 @@ struct _vbi_dvb_mux {
 	   stored in the TS packet header. */
 	unsigned int		continuity_counter;
 
+	/* TS packet headers for _vbi_dvb_mux_feed_iov(). The
+	   payload remains in the packet[] buffer. */
+	uint8_t			iov_ts_header[MAX_TS_PACKETS][4];
+
+	/* Constant bit rate mode, see _vbi_dvb_mux_set_ts_bit_rate(). */
+
+	/* Bits per second, 0 if disabled. */
+	unsigned int		cbr_bit_rate;
+
+	/* PTS of the previous frame, -1 if none. */
+	int64_t			cbr_pts;
+
+	/* Fraction of a TS packet slot left over from the previous
+	   frame period, in units of 1 / (90000 * 188 * 8) packets. */
+	uint64_t		cbr_acc;
+
+	/* Number of packets we sent in excess of the bit rate. */
+	unsigned int		cbr_debt;
+
+	/* Scheduled transmission time of the TS packet passed to
+	   the callback, in 27 MHz units, or -1. */
+	int64_t			cbr_pcr;
+
+	/* A null packet. */
+	uint8_t			cbr_null_packet[188];
+
 	/* Coroutine status. */
 
 	/* Current position in the packet[] buffer. */
@@ -1148,6 +1198,10 @@ vbi_dvb_mux_reset		(vbi_dvb_mux *		mx)
 
 	mx->cor_offset = 0;
 	mx->cor_end = 0;
+
+	mx->cbr_pts = -1;
+	mx->cbr_acc = 0;
+	mx->cbr_debt = 0;
 }
 
 static int
@@ -1604,12 +1658,9 @@ generate_pes_packet		(vbi_dvb_mux *		mx,
 
 static void
 generate_ts_packet_header	(vbi_dvb_mux *		mx,
-				 unsigned int		offset)
+				 uint8_t *		p,
+				 vbi_bool		unit_start)
 {
-	uint8_t *p;
-
-	p = mx->packet + offset;
-
 	/* sync_byte [8] = 0x47 */
 	p[0] = 0x47;
 
@@ -1617,7 +1668,7 @@ generate_ts_packet_header	(vbi_dvb_mux *		mx,
 	   "payload_unit_start_indicator is set if exactly one
 	   PES packet commences in this TS packet immediately
 	   after the header." */
-	if (0 == offset) {
+	if (unit_start) {
 		/* transport_error_indicator = '0' (no error),
 		   payload_unit_start_indicator = '1',
 		   transport_priority,
@@ -1836,7 +1887,9 @@ vbi_dvb_mux_cor		(vbi_dvb_mux *		mx,
 
 			if (0 == ts_left) {
 				offset -= 4;
-				generate_ts_packet_header (mx, offset);
+				generate_ts_packet_header (mx,
+							   mx->packet + offset,
+							   0 == offset);
 				ts_left = 188;
 			}
 
@@ -1867,6 +1920,114 @@ vbi_dvb_mux_cor		(vbi_dvb_mux *		mx,
 	return TRUE;
 }
 
+/* Max. PTS difference between two frames in CBR mode. Larger
+   differences and negative ones are discontinuities. */
+#define CBR_MAX_PTS_DELTA (10 * 90000)
+
+/**
+ * @internal
+ * @param mx DVB VBI multiplexer context.
+ * @param packet_size Size of the PES packet in mx->packet[] + 4.
+ * @param pts PTS of the frame.
+ *
+ * Sends the TS packets of a PES packet in constant bit rate mode.
+ * The packets are spread evenly over the period between the
+ * previous and this frame, padded with null packets.
+ */
+static vbi_bool
+cbr_output			(vbi_dvb_mux *		mx,
+				 unsigned int		packet_size,
+				 int64_t		pts)
+{
+	static const uint64_t slot_units = 90000 * 188 * 8;
+	unsigned int n_data;
+	unsigned int n_slots;
+	unsigned int i;
+	unsigned int j;
+	int64_t period;
+	int64_t pcr;
+
+	pts &= ((int64_t) 1 << 33) - 1;
+
+	n_data = packet_size / 184;
+	n_slots = 0;
+
+	if (mx->cbr_pts >= 0) {
+		int64_t delta;
+
+		delta = (pts - mx->cbr_pts) & (((int64_t) 1 << 33) - 1);
+
+		if (likely (delta <= CBR_MAX_PTS_DELTA)) {
+			mx->cbr_acc += (uint64_t) delta * mx->cbr_bit_rate;
+			n_slots = mx->cbr_acc / slot_units;
+			mx->cbr_acc %= slot_units;
+			pcr = mx->cbr_pts * 300;
+		} else {
+			warning (&mx->log,
+				 "PTS discontinuity %" PRId64 " -> %" PRId64 ".",
+				 mx->cbr_pts, pts);
+			mx->cbr_acc = 0;
+			mx->cbr_debt = 0;
+			pcr = pts * 300;
+		}
+	} else {
+		pcr = pts * 300;
+	}
+
+	mx->cbr_pts = pts;
+
+	/* Transmission times in 27 MHz units. */
+	period = pts * 300 - pcr;
+	if (period < 0) /* wrapped around */
+		period += ((int64_t) 1 << 33) * 300;
+
+	/* Catch up if we exceeded the bit rate earlier. */
+	if (mx->cbr_debt >= n_slots) {
+		mx->cbr_debt -= n_slots;
+		n_slots = 0;
+	} else {
+		n_slots -= mx->cbr_debt;
+		mx->cbr_debt = 0;
+	}
+
+	if (n_slots < n_data) {
+		/* We cannot drop VBI data, so we exceed the bit rate
+		   and send fewer packets later. */
+		mx->cbr_debt += n_data - n_slots;
+		n_slots = n_data;
+	}
+
+	for (i = 0, j = 0; i < n_slots; ++i) {
+		const uint8_t *packet;
+
+		/* Evenly spaced, also when we exceed the bit rate. */
+		mx->cbr_pcr = pcr + (int64_t) i * period / n_slots;
+
+		/* Data in slot i when j / n_data <= i / n_slots. */
+		if (j < n_data && (uint64_t) j * n_slots
+		    <= (uint64_t) i * n_data) {
+			/* The PES packet starts at mx->packet + 4, we
+			   prepend the TS packet header without copying
+			   as in vbi_dvb_mux_feed(). */
+			packet = mx->packet + j * 184;
+			generate_ts_packet_header (mx, mx->packet + j * 184,
+						   0 == j);
+			++j;
+		} else {
+			packet = mx->cbr_null_packet;
+		}
+
+		if (!mx->callback (mx, mx->user_data, packet, 188)) {
+			mx->cbr_pcr = -1;
+			return FALSE;
+		}
+	}
+
+	mx->cbr_pcr = -1;
+
+	return TRUE;
+}
+
 /**
  * @param mx DVB VBI multiplexer context allocated with
  *   vbi_dvb_pes_mux_new() or vbi_dvb_ts_mux_new().
@@ -2000,6 +2161,8 @@ vbi_dvb_mux_feed		(vbi_dvb_mux *		mx,
 	if (0 == mx->pid) {
 		return mx->callback (mx, mx->user_data,
 				     mx->packet + 4, packet_size);
+	} else if (mx->cbr_bit_rate > 0) {
+		return cbr_output (mx, packet_size, pts);
 	} else {
 		unsigned int offset;
 
@@ -2012,7 +2175,8 @@ vbi_dvb_mux_feed		(vbi_dvb_mux *		mx,
 		offset = 0;
 
 		do {
-			generate_ts_packet_header (mx, offset);
+			generate_ts_packet_header (mx, mx->packet + offset,
+						   0 == offset);
 
 			if (!mx->callback (mx, mx->user_data,
 					   mx->packet + offset, 188))
@@ -2025,6 +2189,217 @@ vbi_dvb_mux_feed		(vbi_dvb_mux *		mx,
 	return TRUE;
 }
 
+/**
+ * @internal
+ * @param mx DVB VBI multiplexer context allocated with
+ *   vbi_dvb_pes_mux_new() or vbi_dvb_ts_mux_new().
+ * @param iov The function stores pointers to the generated packets
+ *   in this array.
+ * @param max_iov Number of elements in the @a iov array. When
+ *   generating a PES stream this must be at least 1, for a TS stream
+ *   at least vbi_dvb_mux_get_max_pes_packet_size() / 184 * 2.
+ * @param sliced Pointer to the sliced VBI data to be
+ *   converted. All data must belong to the same video frame.
+ * @param sliced_lines The number of vbi_sliced structures
+ *   in the @a sliced array.
+ * @param service_mask Only data services in this set will be
+ *   encoded.
+ * @param raw Raw VBI frame, see vbi_dvb_mux_feed().
+ * @param sp Describes the data in the @a raw buffer, see
+ *   vbi_dvb_mux_feed().
+ * @param pts This Presentation Time Stamp will be encoded into the
+ *   PES packet. Bits 33 ... 63 are discarded.
+ *
+ * Like vbi_dvb_mux_feed() this function converts raw and/or sliced
+ * VBI data to one DVB VBI PES packet or one or more TS packets, but
+ * instead of calling the callback function once for each packet it
+ * stores the location of all packets in the @a iov array, suitable
+ * for writev() or sendmsg(). The packets are not copied.
+ *
+ * A PES packet is described by one iovec. Each TS packet is
+ * described by two iovecs, the first pointing at the 4 byte
+ * TS packet header, the second at the 184 bytes of payload. So
+ * @a iov[2 * n] and @a iov[2 * n + 1] describe the n-th TS packet,
+ * and groups of 14 iovecs can be passed to sendmmsg() to send
+ * seven TS packets per UDP datagram.
+ *
+ * The iovecs point into the multiplexer context and remain valid
+ * until the next call of a vbi_dvb_mux function with @a mx.
+ *
+ * @returns
+ * The number of iovecs stored in the @a iov array, or -1 on
+ * failure. The function fails for the reasons listed at
+ * vbi_dvb_mux_feed(), except there is no callback function,
+ * and if @a max_iov is too small.
+ */
+int
+_vbi_dvb_mux_feed_iov		(vbi_dvb_mux *		mx,
+				 struct iovec *		iov,
+				 unsigned int		max_iov,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 vbi_service_set	service_mask,
+				 const uint8_t *	raw,
+				 const vbi_sampling_par *sp,
+				 int64_t		pts)
+{
+	const vbi_sliced *s;
+	unsigned int s_left;
+	unsigned int packet_size;
+	unsigned int n_packets;
+	unsigned int i;
+	int err;
+
+	assert (NULL != mx);
+	assert (NULL != iov);
+
+	if (0 == mx->pid) {
+		if (unlikely (max_iov < 1)) {
+			/* errno = VBI_ERR_BUFFER_OVERFLOW; */
+			return -1;
+		}
+	} else {
+		if (unlikely (max_iov < mx->max_packet_size / 184 * 2)) {
+			/* errno = VBI_ERR_BUFFER_OVERFLOW; */
+			return -1;
+		}
+	}
+
+	if (NULL != sp && !valid_sampling_par (mx, sp)) {
+		/* errno = VBI_ERR_SAMPLING_PAR; */
+		return -1;
+	}
+
+	if (unlikely (mx->cor_offset < mx->cor_end)) {
+		warning (&mx->log,
+			 "Lost unconsumed data from a previous "
+			 "vbi_dvb_mux_cor() call.");
+		mx->cor_end = 0;
+	}
+
+	s = sliced;
+	s_left = sliced_lines;
+
+	if (NULL == s)
+		s_left = 0;
+
+	err = generate_pes_packet (mx, &packet_size,
+				   &s, &s_left,
+				   service_mask,
+				   raw, sp,
+				   pts);
+	if (unlikely (0 != err)) {
+		/* errno = err; */
+		return -1;
+	}
+
+	if (unlikely (s_left > 0)) {
+		/* errno = VBI_ERR_BUFFER_OVERFLOW; */
+		return -1;
+	}
+
+	if (0 == mx->pid) {
+		iov[0].iov_base = mx->packet + 4;
+		iov[0].iov_len = packet_size;
+
+		return 1;
+	}
+
+	/* The PES packet size is a multiple of 184. */
+	n_packets = packet_size / 184;
+
+	for (i = 0; i < n_packets; ++i) {
+		uint8_t *h = mx->iov_ts_header[i];
+
+		generate_ts_packet_header (mx, h, 0 == i);
+
+		iov[i * 2 + 0].iov_base = h;
+		iov[i * 2 + 0].iov_len = 4;
+		iov[i * 2 + 1].iov_base = mx->packet + 4 + i * 184;
+		iov[i * 2 + 1].iov_len = 184;
+	}
+
+	return n_packets * 2;
+}
+
+/**
+ * @internal
+ * @param mx DVB VBI multiplexer context allocated with
+ *   vbi_dvb_ts_mux_new().
+ * @param bit_rate Bit rate of the VBI stream in bits per second,
+ *   or zero to disable constant bit rate mode.
+ *
+ * By default vbi_dvb_mux_feed() outputs the TS packets of a frame
+ * in a burst. In constant bit rate mode it outputs TS packets at a
+ * constant rate instead, as a broadcast multiplexer expects. The
+ * packet rate is determined by @a bit_rate and the time elapsed
+ * since the previous frame, derived from the @a pts passed to
+ * vbi_dvb_mux_feed(). The TS packets of a frame are spread evenly
+ * over this period, which precedes the PTS of the frame, and padded
+ * with null packets (PID 0x1FFF).
+ *
+ * When the VBI data of a frame does not fit into its period the
+ * function sends all packets nonetheless and compensates by sending
+ * fewer null packets in the following periods. A PTS decreasing or
+ * advancing by more than ten seconds is taken as a discontinuity
+ * and restarts the schedule.
+ *
+ * The callback function can call _vbi_dvb_mux_get_pcr() to
+ * determine when a packet is scheduled for transmission.
+ * Constant bit rate mode does not apply to vbi_dvb_mux_cor() and
+ * _vbi_dvb_mux_feed_iov().
+ *
+ * @returns
+ * @c FALSE if @a mx generates a PES stream or @a bit_rate is
+ * greater than 1 Gbit/s.
+ */
+vbi_bool
+_vbi_dvb_mux_set_ts_bit_rate	(vbi_dvb_mux *		mx,
+				 unsigned int		bit_rate)
+{
+	assert (NULL != mx);
+
+	if (unlikely (0 == mx->pid || bit_rate > 1000000000)) {
+		/* errno = VBI_ERR_INVALID_ARG; */
+		return FALSE;
+	}
+
+	mx->cbr_bit_rate = bit_rate;
+
+	mx->cbr_pts = -1;
+	mx->cbr_acc = 0;
+	mx->cbr_debt = 0;
+
+	return TRUE;
+}
+
+/**
+ * @internal
+ * @param mx DVB VBI multiplexer context allocated with
+ *   vbi_dvb_ts_mux_new().
+ *
+ * In constant bit rate mode, when called by the vbi_dvb_mux_feed()
+ * callback function, returns the time at which the TS packet passed
+ * to the callback is scheduled for transmission. The time is given
+ * in 27 MHz units on the PTS time base (PTS * 300), as
+ * program_clock_reference_base * 300 + program_clock_reference_extension,
+ * and wraps around at 2 ** 33 * 300.
+ *
+ * @returns
+ * Transmission time, or -1 if not called from the callback function
+ * in constant bit rate mode.
+ */
+int64_t
+_vbi_dvb_mux_get_pcr		(const vbi_dvb_mux *	mx)
+{
+	assert (NULL != mx);
+
+	if (mx->cbr_pcr < 0)
+		return -1;
+
+	return mx->cbr_pcr % (((int64_t) 1 << 33) * 300);
+}
+
 /**
  * @param mx DVB VBI multiplexer context allocated with
  *   vbi_dvb_pes_mux_new() or vbi_dvb_ts_mux_new().
@@ -2241,6 +2616,24 @@ vbi_dvb_pes_mux_new		(vbi_dvb_mux_cb *	callback,
 
 	init_pes_packet_header (mx);
 
+	mx->cbr_pts = -1;
+	mx->cbr_pcr = -1;
+
+	/* sync_byte [8] = 0x47,
+	   transport_error_indicator = '0',
+	   payload_unit_start_indicator = '0',
+	   transport_priority = '0',
+	   PID [13] = 0x1FFF (null packet),
+	   transport_scrambling_control [2] = '00',
+	   adaptation_field_control [2] = '01' (payload only),
+	   continuity_counter [4] = 0 (undefined),
+	   data_byte [8 * 184] */
+	memset (mx->cbr_null_packet, 0xFF, sizeof (mx->cbr_null_packet));
+	mx->cbr_null_packet[0] = 0x47;
+	mx->cbr_null_packet[1] = 0x1F;
+	mx->cbr_null_packet[2] = 0xFF;
+	mx->cbr_null_packet[3] = 0x10;
+
 	mx->callback = callback;
 	mx->user_data = user_data;
 
@@ -144,6 +144,29 @@ vbi_dvb_ts_mux_new		(unsigned int		pid,
 
 /* Private */
 
+struct iovec;
+
+/* Experimental. */
+extern int
+_vbi_dvb_mux_feed_iov		(vbi_dvb_mux *		mx,
+				 struct iovec *		iov,
+				 unsigned int		max_iov,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 vbi_service_set	service_mask,
+				 const uint8_t *	raw,
+				 const vbi_sampling_par *sampling_par,
+				 int64_t		pts)
+  _vbi_nonnull ((1, 2));
+/* Experimental. */
+extern vbi_bool
+_vbi_dvb_mux_set_ts_bit_rate	(vbi_dvb_mux *		mx,
+				 unsigned int		bit_rate)
+  _vbi_nonnull ((1));
+extern int64_t
+_vbi_dvb_mux_get_pcr		(const vbi_dvb_mux *	mx)
+  _vbi_nonnull ((1));
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_DVB_MUX_H__ */
@@ -396,6 +396,60 @@ typedef struct vbi_page {
 	vbi_opacity		boxed_opacity[2];
 } vbi_page;
 
+/**
+ * @ingroup Page
+ * @brief Compact Level 1 Teletext page.
+ *
+ * Clients which only need the text and basic attributes of a page,
+ * for example subtitle extractors, can fetch pages with
+ * vbi_fetch_vt_text_page() into this structure. Unlike vbi_page it
+ * contains no navigation links, color map or enhancements. Each
+ * character cell is described by a Unicode value and a packed
+ * attribute word, which can be decoded with the VBI_TEXT_ macros.
+ * Colors are always Teletext Level 1 vbi_color values.
+ */
+typedef struct vbi_text_page {
+	/**
+	 * Page number, see vbi_pgno.
+	 */
+	int			pgno;
+	/**
+	 * Subpage number, see vbi_subno.
+	 */
+	int			subno;
+	/**
+	 * Number of valid character rows, 1 ... 25.
+	 */
+	int			rows;
+	/**
+	 * The opacity of the page border, VBI_TRANSPARENT_SPACE
+	 * for subtitle and newsflash pages, VBI_OPAQUE otherwise.
+	 */
+	vbi_opacity		screen_opacity;
+	/**
+	 * Character code of each cell, @a rows x 40 without padding
+	 * between the rows. See vbi_char->unicode for details.
+	 */
+	uint16_t		unicode[25 * 40];
+	/**
+	 * Attributes of each cell in the same order as @a unicode.
+	 */
+	uint16_t		attr[25 * 40];
+} vbi_text_page;
+
+/** Foreground vbi_color of a vbi_text_page attribute word. */
+#define VBI_TEXT_FOREGROUND(attr) ((vbi_color)((attr) & 7))
+/** Background vbi_color of a vbi_text_page attribute word. */
+#define VBI_TEXT_BACKGROUND(attr) ((vbi_color)(((attr) >> 3) & 7))
+/** vbi_size of a vbi_text_page attribute word. */
+#define VBI_TEXT_SIZE(attr) ((vbi_size)(((attr) >> 6) & 7))
+/** vbi_opacity of a vbi_text_page attribute word. */
+#define VBI_TEXT_OPACITY(attr) ((vbi_opacity)(((attr) >> 9) & 3))
+/** Flash attribute bit in a vbi_text_page attribute word. */
+#define VBI_TEXT_FLASH 0x0800
+/** Conceal attribute bit in a vbi_text_page attribute word. */
+#define VBI_TEXT_CONCEAL 0x1000
+
 /* Private */
 
 #endif /* FORMAT_H */
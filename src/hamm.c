@@ -26,10 +26,20 @@
 #endif
 
 #include <limits.h>		/* CHAR_BIT */
+#include <string.h>		/* memcpy() */
 
 #include "hamm.h"
 #include "hamm-tables.h"
 
+/* GCC 4.9 and Clang permit SSSE3 intrinsics in functions compiled
+   for that target without -mssse3 for the whole file. */
+#if (defined (__x86_64__) || defined (__i386__))			\
+    && ((__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || __GNUC__ >= 5	\
+	|| defined (__clang__))
+#  define HAVE_SSSE3_REV8 1
+#  include <tmmintrin.h>
+#endif
+
 /**
  * @ingroup Error
  *
@@ -159,6 +169,154 @@ vbi_unham24p			(const uint8_t *	p)
 	return d ^ (int) _vbi_hamm24_inv_err[ABCDEF];
 }
 
+static void
+rev8_block			(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+{
+	static const uint64_t m1 = 0x5555555555555555ULL;
+	static const uint64_t m2 = 0x3333333333333333ULL;
+	static const uint64_t m4 = 0x0F0F0F0F0F0F0F0FULL;
+
+	while (n >= 8) {
+		uint64_t x;
+
+		memcpy (&x, src, 8);
+
+		x = ((x >> 1) & m1) | ((x & m1) << 1);
+		x = ((x >> 2) & m2) | ((x & m2) << 2);
+		x = ((x >> 4) & m4) | ((x & m4) << 4);
+
+		memcpy (dst, &x, 8);
+
+		src += 8;
+		dst += 8;
+		n -= 8;
+	}
+
+	while (n-- > 0)
+		*dst++ = vbi_rev8 (*src++);
+}
+
+#ifdef HAVE_SSSE3_REV8
+
+/* Reverses sixteen bytes at a time, looking up the reversed low and
+   high nibbles with pshufb. */
+__attribute__ ((target ("ssse3")))
+static void
+rev8_block_ssse3		(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+{
+	const __m128i rev4 = _mm_setr_epi8 (0x0, 0x8, 0x4, 0xC,
+					    0x2, 0xA, 0x6, 0xE,
+					    0x1, 0x9, 0x5, 0xD,
+					    0x3, 0xB, 0x7, 0xF);
+	const __m128i m4 = _mm_set1_epi8 (0x0F);
+
+	while (n >= 16) {
+		__m128i x, lo, hi;
+
+		x = _mm_loadu_si128 ((const __m128i *) src);
+
+		lo = _mm_shuffle_epi8 (rev4, _mm_and_si128 (x, m4));
+		hi = _mm_shuffle_epi8 (rev4, _mm_and_si128
+				       (_mm_srli_epi16 (x, 4), m4));
+
+		/* The nibbles are < 16, no bits cross byte boundaries. */
+		x = _mm_or_si128 (_mm_slli_epi16 (lo, 4), hi);
+
+		_mm_storeu_si128 ((__m128i *) dst, x);
+
+		src += 16;
+		dst += 16;
+		n -= 16;
+	}
+
+	rev8_block (dst, src, n);
+}
+
+#endif /* HAVE_SSSE3_REV8 */
+
+/**
+ * @internal
+ * @param dst Output buffer.
+ * @param src Input buffer. May be the same as @a dst but must not
+ *   overlap it otherwise.
+ * @param n Number of bytes to copy.
+ *
+ * Copies @a n bytes, reversing the order of the bits in each byte
+ * like vbi_rev8(). On x86 CPUs with SSSE3 the function reverses
+ * sixteen bytes at a time with pshufb, otherwise eight bytes at a
+ * time with a few shifts and masks.
+ *
+ * Experimental.
+ */
+void
+_vbi_rev8_block			(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+{
+#ifdef HAVE_SSSE3_REV8
+	if (__builtin_cpu_supports ("ssse3")) {
+		rev8_block_ssse3 (dst, src, n);
+		return;
+	}
+#endif
+	rev8_block (dst, src, n);
+}
+
+/**
+ * @internal
+ * @param dst Output buffer.
+ * @param src Hamming 8/4 protected bytes. May be the same as @a dst
+ *   but must not overlap it otherwise.
+ * @param n Number of bytes to decode.
+ *
+ * Decodes @a n bytes like vbi_unham8(). Instead of testing each
+ * result, the results are ORed together and checked once.
+ *
+ * Experimental.
+ *
+ * @returns
+ * A negative value if any byte contained incorrectable errors. Then
+ * the contents of @a dst are undefined.
+ */
+int
+_vbi_unham8_block		(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+{
+	int r = 0;
+
+	while (n >= 4) {
+		int d0 = _vbi_hamm8_inv[src[0]];
+		int d1 = _vbi_hamm8_inv[src[1]];
+		int d2 = _vbi_hamm8_inv[src[2]];
+		int d3 = _vbi_hamm8_inv[src[3]];
+
+		dst[0] = d0;
+		dst[1] = d1;
+		dst[2] = d2;
+		dst[3] = d3;
+
+		r |= d0 | d1 | d2 | d3;
+
+		src += 4;
+		dst += 4;
+		n -= 4;
+	}
+
+	while (n-- > 0) {
+		int d = _vbi_hamm8_inv[*src++];
+
+		*dst++ = d;
+		r |= d;
+	}
+
+	return r;
+}
+
 /*
 Local variables:
 c-set-style: K&R
@@ -221,6 +221,18 @@ vbi_unham24p			(const uint8_t *	p)
 
 /* Private */
 
+/* Experimental. */
+extern void
+_vbi_rev8_block			(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+  _vbi_nonnull ((1, 2));
+extern int
+_vbi_unham8_block		(uint8_t *		dst,
+				 const uint8_t *	src,
+				 unsigned int		n)
+  _vbi_nonnull ((1, 2));
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_HAMM_H__ */
@@ -25,15 +25,21 @@
 #  include "config.h"
 #endif
 
+#include <pthread.h>
+
 #include "misc.h"
 #include "hamm.h"		/* vbi_unham8() */
 #include "idl_demux.h"
 
+/* Fills table[0] with the CRC of each byte value, and table[k] with
+   the CRC of the byte value followed by k zero bytes, so we can
+   compute the CRC of eight bytes at once (slice-by-8). */
 static void
-init_crc16_table		(uint16_t		table[256],
+init_crc16_table		(uint16_t		table[8][256],
 				 unsigned int		poly)
 {
 	unsigned int i;
+	unsigned int k;
 
 	for (i = 0; i < 256; ++i) {
 		unsigned int crc;
@@ -48,10 +54,43 @@ init_crc16_table		(uint16_t		table[256],
 			val >>= 1;
 		}
 
-		table[i] = crc;
+		table[0][i] = crc;
+	}
+
+	for (k = 1; k < 8; ++k) {
+		for (i = 0; i < 256; ++i) {
+			unsigned int crc = table[k - 1][i];
+
+			table[k][i] = (crc >> 8) ^ table[0][crc & 0xFF];
+		}
 	}
 }
 
+static unsigned int
+crc16				(const uint16_t		table[8][256],
+				 unsigned int		crc,
+				 const uint8_t *	p,
+				 unsigned int		n)
+{
+	while (n >= 8) {
+		crc = (table[7][(crc ^ p[0]) & 0xFF]
+		       ^ table[6][((crc >> 8) ^ p[1]) & 0xFF]
+		       ^ table[5][p[2]]
+		       ^ table[4][p[3]]
+		       ^ table[3][p[4]]
+		       ^ table[2][p[5]]
+		       ^ table[1][p[6]]
+		       ^ table[0][p[7]]);
+		p += 8;
+		n -= 8;
+	}
+
+	while (n-- > 0)
+		crc = (crc >> 8) ^ table[0][(crc ^ *p++) & 0xFF];
+
+	return crc;
+}
+
 /* EN 300 708 section 6.5 IDL Format A */
 
 #define FT_HAVE_RI		(1 << 1)
@@ -63,57 +102,63 @@ init_crc16_table		(uint16_t		table[256],
 /* 6.5.7.1 Dummy bytes */
 #define SKIP_DUMMY_BYTES	1
 
-static uint16_t			idl_a_crc_table [256];
+static uint16_t			idl_a_crc_table [8][256];
+static pthread_once_t		idl_a_crc_once = PTHREAD_ONCE_INIT;
+
+static void
+init_idl_a_crc_table		(void)
+{
+	/* x16 + x9 + x7 + x4 + 1 */
+	init_crc16_table (idl_a_crc_table, 0x8940);
+}
+
+/* Returns the service packet address of an IDL Format A packet,
+   a negative value on error. */
+static int
+idl_a_address			(const uint8_t		buffer[42],
+				 unsigned int		spa_length)
+{
+	uint8_t spa_buf[7];
+	int spa;
+	unsigned int i;
+
+	if (_vbi_unham8_block (spa_buf, buffer + 4, spa_length) < 0)
+		return -1;
+
+	spa = 0;
+
+	for (i = 0; i < spa_length; ++i)
+		spa |= spa_buf[i] << (4 * i);
+
+	return spa;
+}
 
 static vbi_bool
-idl_a_demux_feed		(vbi_idl_demux *	dx,
+idl_a_demux_decode		(vbi_idl_demux *	dx,
 				 const uint8_t		buffer[42],
-				 int			ft)
+				 int			ft,
+				 int			ial)
 {
 	uint8_t buf[40];
 	uint8_t hist[256];
-	int ial;		/* interpretation and address length */
-	unsigned int spa_length;
-	int spa;		/* service packet address */
 	unsigned int ri;	/* repeat indicator */
 	unsigned int ci;	/* continuity indicator */
 	unsigned int dl;	/* data length */
 	unsigned int crc;
 	unsigned int flags;
+	const uint8_t *data;
 	unsigned int i;
 	unsigned int j;
+	unsigned int k;
 
-	ial = vbi_unham8 (buffer[3]);
-	if (ial < 0) {
-		return FALSE;
-	}
-
-	spa_length = (unsigned int) ial & 7;
-	if (7 == spa_length) /* reserved */
-		return TRUE;
-
-	spa = 0;
-
-	for (i = 0; i < spa_length; ++i)
-		spa |= vbi_unham8 (buffer[4 + i]) << (4 * i);
-
-	if (spa < 0) {
-		return FALSE;
-	}
-
-	if (spa != dx->address)
-		return TRUE;
+	i = (unsigned int) ial & 7; /* spa_length */
 
 	ri = 0;
 	if (ft & FT_HAVE_RI) {
 		ri = buffer[4 + i++];
 	}
 
-	crc = 0;
-
-	for (j = 4 + i; j < 42; ++j) {
-		crc = (crc >> 8) ^ idl_a_crc_table[(crc & 0xFF) ^ buffer[j]];
-	}
+	crc = crc16 (idl_a_crc_table, 0, buffer + 4 + i, 38 - i);
 
 	if (ft & FT_HAVE_CI) {
 		ci = buffer[4 + i++];
@@ -181,12 +226,15 @@ idl_a_demux_feed		(vbi_idl_demux *	dx,
 		dl = 36 - i;
 	}
 
+	/* Unless we have to skip dummy bytes we pass the user data
+	   in place, without copying. */
+	data = buffer + 4 + i;
 	j = 0;
 
-	while (dl-- > 0) {
+	for (k = 0; k < dl; ++k) {
 		unsigned int t;
 
-		t = buffer[4 + i++];
+		t = buffer[4 + i + k];
 
 		if (SKIP_DUMMY_BYTES) {
 			++hist[t];
@@ -198,17 +246,53 @@ idl_a_demux_feed		(vbi_idl_demux *	dx,
 				hist[0x00] = 0;
 				hist[0xFF] = 0;
 
+				if (data != buf) {
+					memcpy (buf, data, j);
+					data = buf;
+				}
+
 				continue;
 			}
 		}
 
-		buf[j++] = t;
+		if (data == buf)
+			buf[j] = t;
+		++j;
 	}
 
 	flags = dx->flags | (ial & VBI_IDL_DEPENDENT);
 	dx->flags &= ~VBI_IDL_DATA_LOST;
 
-	return dx->callback (dx, buf, j, dx->flags, dx->user_data);
+	return dx->callback (dx, data, j, flags, dx->user_data);
+}
+
+static vbi_bool
+idl_a_demux_feed		(vbi_idl_demux *	dx,
+				 const uint8_t		buffer[42],
+				 int			ft)
+{
+	int ial;		/* interpretation and address length */
+	unsigned int spa_length;
+	int spa;		/* service packet address */
+
+	ial = vbi_unham8 (buffer[3]);
+	if (ial < 0) {
+		return FALSE;
+	}
+
+	spa_length = (unsigned int) ial & 7;
+	if (7 == spa_length) /* reserved */
+		return TRUE;
+
+	spa = idl_a_address (buffer, spa_length);
+	if (spa < 0) {
+		return FALSE;
+	}
+
+	if (spa != dx->address)
+		return TRUE;
+
+	return idl_a_demux_decode (dx, buffer, ft, ial);
 }
 
 
@@ -389,6 +473,288 @@ vbi_idl_demux_feed_frame	(vbi_idl_demux *	dx,
 	return TRUE;
 }
 
+/* Multiple IDL channels */
+
+#define MAX_IDL_DEMUXES 255
+
+/**
+ * @internal
+ * A set of IDL Format A demultiplexers fed from one Teletext stream.
+ */
+struct _vbi_idl_multi_demux {
+	/* Index + 1 in demuxes[] of the first demux of each channel,
+	   0 if none. */
+	uint8_t			first[16];
+
+	/* Index + 1 of the next demux of the same channel, 0 if none. */
+	uint8_t			next[MAX_IDL_DEMUXES];
+
+	vbi_idl_demux *		demuxes[MAX_IDL_DEMUXES];
+	unsigned int		n_demuxes;
+};
+
+static void
+rebuild_channel_table		(_vbi_idl_multi_demux *	md)
+{
+	unsigned int i;
+
+	CLEAR (md->first);
+
+	for (i = md->n_demuxes; i-- > 0;) {
+		unsigned int channel = md->demuxes[i]->channel;
+
+		md->next[i] = md->first[channel];
+		md->first[channel] = i + 1;
+	}
+}
+
+static vbi_bool
+multi_demux_feed		(_vbi_idl_multi_demux *	md,
+				 const uint8_t		buffer[42])
+{
+	uint8_t hdr[2];
+	int ft;
+	int ial;
+	unsigned int spa_length;
+	int spa;
+	unsigned int i;
+
+	/* Channel, designation. */
+	if (_vbi_unham8_block (hdr, buffer, 2) < 0)
+		return FALSE;
+
+	if (15 != hdr[1] /* packet 30 or 31 */)
+		return TRUE;
+
+	i = md->first[hdr[0]];
+	if (0 == i)
+		return TRUE;
+
+	/* Like vbi_idl_demux_feed() look at the interpretation and
+	   address length only in Format A packets. */
+	ft = vbi_unham8 (buffer[2]);
+	if (ft < 0)
+		return FALSE;
+
+	if (0 != (ft & 1))
+		return TRUE; /* not Format A */
+
+	ial = vbi_unham8 (buffer[3]);
+	if (ial < 0)
+		return FALSE;
+
+	spa_length = (unsigned int) ial & 7;
+	if (7 == spa_length) /* reserved */
+		return TRUE;
+
+	spa = idl_a_address (buffer, spa_length);
+	if (spa < 0)
+		return FALSE;
+
+	for (; i > 0; i = md->next[i - 1]) {
+		vbi_idl_demux *dx = md->demuxes[i - 1];
+
+		if (spa == dx->address)
+			return idl_a_demux_decode (dx, buffer, ft, ial);
+	}
+
+	return TRUE;
+}
+
+/**
+ * @internal
+ * @param md IDL multi demultiplexer allocated with
+ *   _vbi_idl_multi_demux_new().
+ * @param sliced Sliced VBI data.
+ * @param n_lines Number of lines in the @a sliced array.
+ *
+ * This function works like calling vbi_idl_demux_feed_frame() for
+ * each demultiplexer added with _vbi_idl_multi_demux_add(), but it
+ * decodes each packet header only once and passes the packet only
+ * to the demultiplexer of the transmitted channel and address, found
+ * through a channel table. Unlike vbi_idl_demux_feed_frame() it
+ * continues after errors.
+ *
+ * @returns
+ * @c FALSE if any Teletext lines of the requested channels contained
+ * incorrectable errors or a callback function returned @c FALSE.
+ */
+vbi_bool
+_vbi_idl_multi_demux_feed_frame	(_vbi_idl_multi_demux *	md,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines)
+{
+	const vbi_sliced *end;
+	vbi_bool success;
+
+	assert (NULL != md);
+	assert (NULL != sliced);
+
+	success = TRUE;
+
+	for (end = sliced + n_lines; sliced < end; ++sliced) {
+		if (sliced->id & VBI_SLICED_TELETEXT_B_625)
+			success &= multi_demux_feed (md, sliced->data);
+	}
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param md IDL multi demultiplexer allocated with
+ *   _vbi_idl_multi_demux_new().
+ * @param dx Demultiplexer returned by _vbi_idl_multi_demux_add().
+ *
+ * Removes and deletes the demultiplexer @a dx.
+ */
+void
+_vbi_idl_multi_demux_remove	(_vbi_idl_multi_demux *	md,
+				 vbi_idl_demux *	dx)
+{
+	unsigned int i;
+
+	assert (NULL != md);
+
+	if (NULL == dx)
+		return;
+
+	for (i = 0; i < md->n_demuxes; ++i) {
+		if (dx == md->demuxes[i])
+			break;
+	}
+
+	assert (i < md->n_demuxes);
+
+	md->demuxes[i] = md->demuxes[--md->n_demuxes];
+
+	rebuild_channel_table (md);
+
+	vbi_idl_demux_delete (dx);
+}
+
+/**
+ * @internal
+ * @param md IDL multi demultiplexer allocated with
+ *   _vbi_idl_multi_demux_new().
+ * @param channel Filter out packets of this channel, 0 ... 15.
+ * @param address Filter out packets with this service packet address.
+ * @param callback Function to be called by
+ *   _vbi_idl_multi_demux_feed_frame() when new data of this channel
+ *   and address is available.
+ * @param user_data User pointer passed through to @a callback.
+ *
+ * Adds an IDL Format A demultiplexer for another channel and address
+ * to @a md.
+ *
+ * @returns
+ * The new demultiplexer, which is passed to @a callback and belongs
+ * to @a md. @c NULL if the parameters are invalid, the channel and
+ * address has already been added, or on failure (out of memory).
+ */
+vbi_idl_demux *
+_vbi_idl_multi_demux_add	(_vbi_idl_multi_demux *	md,
+				 unsigned int		channel,
+				 unsigned int		address,
+				 vbi_idl_demux_cb *	callback,
+				 void *			user_data)
+{
+	vbi_idl_demux *dx;
+	unsigned int i;
+
+	assert (NULL != md);
+	assert (NULL != callback);
+
+	if (channel >= (1 << 4))
+		return NULL;
+
+	if (md->n_demuxes >= MAX_IDL_DEMUXES)
+		return NULL;
+
+	for (i = md->first[channel]; i > 0; i = md->next[i - 1]) {
+		if ((int) address == md->demuxes[i - 1]->address)
+			return NULL;
+	}
+
+	dx = vbi_idl_a_demux_new (channel, address, callback, user_data);
+	if (NULL == dx)
+		return NULL;
+
+	md->demuxes[md->n_demuxes++] = dx;
+
+	rebuild_channel_table (md);
+
+	return dx;
+}
+
+/**
+ * @internal
+ * @param md IDL multi demultiplexer allocated with
+ *   _vbi_idl_multi_demux_new().
+ *
+ * Resets all demultiplexers of @a md, useful for example after a
+ * channel change.
+ */
+void
+_vbi_idl_multi_demux_reset	(_vbi_idl_multi_demux *	md)
+{
+	unsigned int i;
+
+	assert (NULL != md);
+
+	for (i = 0; i < md->n_demuxes; ++i)
+		vbi_idl_demux_reset (md->demuxes[i]);
+}
+
+/**
+ * @internal
+ * @param md IDL multi demultiplexer allocated with
+ *   _vbi_idl_multi_demux_new(), can be @c NULL.
+ *
+ * Frees all resources associated with @a md, including the
+ * demultiplexers added with _vbi_idl_multi_demux_add().
+ */
+void
+_vbi_idl_multi_demux_delete	(_vbi_idl_multi_demux *	md)
+{
+	unsigned int i;
+
+	if (NULL == md)
+		return;
+
+	for (i = 0; i < md->n_demuxes; ++i)
+		vbi_idl_demux_delete (md->demuxes[i]);
+
+	CLEAR (*md);
+
+	vbi_free (md);
+}
+
+/**
+ * @internal
+ *
+ * Allocates a set of Independent Data Line Format A demultiplexers,
+ * initially empty. Add demultiplexers with _vbi_idl_multi_demux_add().
+ *
+ * @returns
+ * Pointer to a newly allocated IDL multi demultiplexer which must be
+ * freed with _vbi_idl_multi_demux_delete() when done. @c NULL on
+ * failure (out of memory).
+ */
+_vbi_idl_multi_demux *
+_vbi_idl_multi_demux_new	(void)
+{
+	_vbi_idl_multi_demux *md;
+
+	md = vbi_malloc (sizeof (*md));
+	if (NULL == md)
+		return NULL;
+
+	CLEAR (*md);
+
+	return md;
+}
+
 /** @internal */
 void
 _vbi_idl_demux_destroy		(vbi_idl_demux *	dx)
@@ -418,10 +784,8 @@ _vbi_idl_demux_init		(vbi_idl_demux *	dx,
 		if (address >= (1 << 24))
 			return FALSE;
 
-		if (0 == idl_a_crc_table[1]) {
-			/* x16 + x9 + x7 + x4 + 1 */
-			init_crc16_table (idl_a_crc_table, 0x8940);
-		}
+		/* Demuxes may be created in different threads. */
+		pthread_once (&idl_a_crc_once, init_idl_a_crc_table);
 
 		break;
 
@@ -440,6 +804,8 @@ _vbi_idl_demux_init		(vbi_idl_demux *	dx,
 	dx->channel		= channel;
 	dx->address		= address;
 
+	dx->flags		= 0;
+
 	vbi_idl_demux_reset (dx);
 
 	dx->callback		= callback;
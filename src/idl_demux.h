@@ -178,6 +178,33 @@ _vbi_idl_demux_init		(vbi_idl_demux *	dx,
 				 void *			user_data)
   _vbi_nonnull ((1, 5));
 
+typedef struct _vbi_idl_multi_demux _vbi_idl_multi_demux;
+
+extern vbi_bool
+_vbi_idl_multi_demux_feed_frame	(_vbi_idl_multi_demux *	md,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines)
+  _vbi_nonnull ((1, 2));
+extern void
+_vbi_idl_multi_demux_remove	(_vbi_idl_multi_demux *	md,
+				 vbi_idl_demux *	dx)
+  _vbi_nonnull ((1));
+extern vbi_idl_demux *
+_vbi_idl_multi_demux_add	(_vbi_idl_multi_demux *	md,
+				 unsigned int		channel,
+				 unsigned int		address,
+				 vbi_idl_demux_cb *	callback,
+				 void *			user_data)
+  _vbi_nonnull ((1, 4));
+extern void
+_vbi_idl_multi_demux_reset	(_vbi_idl_multi_demux *	md)
+  _vbi_nonnull ((1));
+extern void
+_vbi_idl_multi_demux_delete	(_vbi_idl_multi_demux *	md);
+extern _vbi_idl_multi_demux *
+_vbi_idl_multi_demux_new	(void)
+  _vbi_alloc;
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_IDL_DEMUX_H__ */
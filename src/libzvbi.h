@@ -841,6 +841,28 @@ typedef struct vbi_page {
 	vbi_opacity		boxed_opacity[2];
 } vbi_page;
 
+typedef struct vbi_text_page {
+	int			pgno;
+	int			subno;
+	int			rows;
+	vbi_opacity		screen_opacity;
+	uint16_t		unicode[25 * 40];
+	uint16_t		attr[25 * 40];
+} vbi_text_page;
+
+
+#define VBI_TEXT_FOREGROUND(attr) ((vbi_color)((attr) & 7))
+
+#define VBI_TEXT_BACKGROUND(attr) ((vbi_color)(((attr) >> 3) & 7))
+
+#define VBI_TEXT_SIZE(attr) ((vbi_size)(((attr) >> 6) & 7))
+
+#define VBI_TEXT_OPACITY(attr) ((vbi_opacity)(((attr) >> 9) & 3))
+
+#define VBI_TEXT_FLASH 0x0800
+
+#define VBI_TEXT_CONCEAL 0x1000
+
 /* lang.h */
 
 typedef struct vbi_font_descr vbi_font_descr;
@@ -2030,6 +2052,10 @@ extern vbi_bool		vbi_fetch_vt_page(vbi_decoder *vbi, vbi_page *pg,
 					  vbi_pgno pgno, vbi_subno subno,
 					  vbi_wst_level max_level, int display_rows,
 					  vbi_bool navigation);
+extern vbi_bool		vbi_fetch_vt_text_page(vbi_decoder *vbi,
+					       vbi_text_page *tp,
+					       vbi_pgno pgno, vbi_subno subno,
+					       int display_rows);
 extern int		vbi_page_title(vbi_decoder *vbi, int pgno, int subno, char *buf);
 
 extern void		vbi_resolve_link(vbi_page *pg, int column, int row,
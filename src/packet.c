@@ -868,8 +868,50 @@ parse_btt(vbi_decoder *vbi, uint8_t *raw, int packet)
 	return TRUE;
 }
 
+static void
+index_ait_title			(cache_network *	cn,
+				 const cache_page *	vtp,
+				 const struct ttx_ait_title *ait)
+{
+	struct ttx_ait_index *ai;
+
+	ai = cache_network_ait_index (cn, ait->link.pgno);
+
+	if (0 == ai->title.link.pgno)
+		++cn->n_ait_titles;
+
+	ai->title = *ait;
+	ai->ait_pgno = vtp->pgno;
+	ai->national = vtp->national;
+}
+
+/* A complete AIT page replaces all titles it transmitted before. */
+static void
+reindex_ait_page		(cache_network *	cn,
+				 const cache_page *	vtp)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_ELEMENTS (cn->_ait_index); ++i) {
+		struct ttx_ait_index *ai = &cn->_ait_index[i];
+
+		if (0 != ai->title.link.pgno
+		    && ai->ait_pgno == vtp->pgno) {
+			CLEAR (*ai);
+			--cn->n_ait_titles;
+		}
+	}
+
+	for (i = 0; i < N_ELEMENTS (vtp->data.ait.title); ++i) {
+		const struct ttx_ait_title *ait = &vtp->data.ait.title[i];
+
+		if (0 != ait->link.pgno)
+			index_ait_title (cn, vtp, ait);
+	}
+}
+
 static vbi_bool
-parse_ait(cache_page *vtp, uint8_t *raw, int packet)
+parse_ait(cache_network *cn, cache_page *vtp, uint8_t *raw, int packet)
 {
 	int i, n;
 	struct ttx_ait_title *ait;
@@ -883,12 +925,16 @@ parse_ait(cache_page *vtp, uint8_t *raw, int packet)
 		for (i = 0; i < 12; i++)
 			if ((n = vbi_unpar8 (raw[i + 8])) >= 0)
 				ait[0].text[i] = n;
+
+		index_ait_title (cn, vtp, &ait[0]);
 	}
 
 	if (unham_top_page_link(&ait[1].link, raw + 20)) {
 		for (i = 0; i < 12; i++)
 			if ((n = vbi_unpar8 (raw[i + 28])) >= 0)
 				ait[1].text[i] = n;
+
+		index_ait_title (cn, vtp, &ait[1]);
 	}
 
 	return TRUE;
@@ -1038,7 +1084,8 @@ vbi_convert_page(vbi_decoder *vbi, cache_page *vtp,
 
 		for (i = 1; i <= 23; i++)
 			if (vtp->lop_packets & (1 << i))
-				if (!parse_ait(&page, vtp->data.unknown.raw[i], i))
+				if (!parse_ait(vbi->cn, &page,
+					       vtp->data.unknown.raw[i], i))
 					return FALSE;
 		break;
 
@@ -2072,6 +2119,26 @@ parse_8_30(vbi_decoder *vbi, uint8_t *buffer, int packet)
 	return TRUE;
 }
 
+static vbi_bool
+keep_page			(const vbi_page_table *	pt,
+				 vbi_pgno		pgno,
+				 vbi_subno		subno)
+{
+	switch (pgno & 0xFF) {
+	case 0xFD: /* MIP */
+	case 0xFE: /* MOT */
+		return TRUE;
+
+	default:
+		/* TOP BTT, needed to classify pages. */
+		if (0x1F0 == pgno)
+			return TRUE;
+		break;
+	}
+
+	return vbi_page_table_contains_subpage (pt, pgno, subno);
+}
+
 /**
  * @internal
  * @param vbi Initialized vbi decoding context.
@@ -2181,6 +2248,11 @@ vbi_decode_teletext(vbi_decoder *vbi, uint8_t *buffer)
 				eacem_trigger(vbi, vtp);
 				break;
 
+			case PAGE_FUNCTION_AIT:
+				reindex_ait_page (vbi->cn, vtp);
+
+				/* fall through */
+
 			default:
 			{
 				cache_page *new_cp;
@@ -2216,6 +2288,14 @@ vbi_decode_teletext(vbi_decoder *vbi, uint8_t *buffer)
 		cvtp->national = vbi_rev8 (flags) & 7;
 		cvtp->flags = (flags << 16) + subpage;
 
+		if (vbi->vt.page_filter
+		    && !keep_page (vbi->vt.page_filter, pgno, cvtp->subno)) {
+			/* Packets 1 ... 28 of this page will be
+			   ignored, nothing goes into the cache. */
+			cvtp->function = PAGE_FUNCTION_DISCARD;
+			return TRUE;
+		}
+
 		if (0 && ((page & 15) > 9 || page > 0x99))
 			printf("data page %03x/%04x n%d\n",
 			       cvtp->pgno, cvtp->subno, cvtp->national);
@@ -2447,7 +2527,7 @@ vbi_decode_teletext(vbi_decoder *vbi, uint8_t *buffer)
 			break;
 
 		case PAGE_FUNCTION_AIT:
-			if (!(parse_ait(cvtp, p, packet)))
+			if (!(parse_ait(vbi->cn, cvtp, p, packet)))
 				return FALSE;
 			break;
 
@@ -2678,6 +2758,35 @@ vbi_teletext_set_level(vbi_decoder *vbi, int level)
 	vbi->vt.max_level = level;
 }
 
+/**
+ * @internal
+ * @param vbi Initialized vbi decoding context.
+ * @param pt Table of pages to decode, or @c NULL to decode all pages.
+ *
+ * By default the Teletext decoder assembles and caches every page
+ * it receives. Applications interested in a few pages only, for
+ * example subtitle extractors, can pass a page table here. Pages
+ * not in the table are then discarded right after decoding their
+ * page header, before any packets are copied or the cache is
+ * accessed. Magazine inventory and TOP basic table pages are always
+ * decoded since they are needed to classify pages. Note no
+ * Teletext page events will be sent for discarded pages, and
+ * the rolling header and clock are only updated by pages in the
+ * table.
+ *
+ * The decoder does not copy the table, it must remain valid until
+ * this function is called again or the decoder is deleted.
+ * Changes to the table take effect with the next page header.
+ *
+ * Experimental.
+ */
+void
+_vbi_teletext_set_page_filter	(vbi_decoder *		vbi,
+				 const vbi_page_table *	pt)
+{
+	vbi->vt.page_filter = pt;
+}
+
 /**
  * @internal
  * @param vbi Initialized vbi decoding context.
@@ -2768,6 +2877,9 @@ vbi_teletext_channel_switched(vbi_decoder *vbi)
 	for (i = 0; i < N_ELEMENTS (vbi->cn->_pages); ++i)
 		ttx_page_stat_init (vbi->cn->_pages + i);
 
+	CLEAR (vbi->cn->_ait_index);
+	vbi->cn->n_ait_titles = 0;
+
 	/* Magazine defaults */
 
 	for (i = 0; i < N_ELEMENTS (vbi->cn->_magazines); ++i)
@@ -47,7 +47,9 @@
  * the caller wishes to keep or drop.
  *
  * The vbi_page_table is optimized for fast queries, while adding or
- * removing pages and especially subpages may take longer.
+ * removing pages and especially subpages may take longer. Whether
+ * a page is in the table, or has subpages in the table, takes a
+ * single bit test.
  */
 
 /* 0 ... 0x3F7E; 0x3F7F == VBI_ANY_SUBNO. */
@@ -79,6 +81,10 @@ struct _vbi_page_table {
 	/* Number of set bits in the pages[] array. */
 	unsigned int		pages_popcnt;
 
+	/* One bit for each Teletext page with entries in the
+	   subpages vector, same layout as pages[]. */
+	uint32_t		subpage_pages[(0x900 - 0x100) / 32];
+
 	/* A vector of subpages, current size and capacity
 	   (counting struct subpage_range). */
 	struct subpage_range *	subpages;
@@ -105,6 +111,34 @@ contains_all_subpages		(const vbi_page_table *pt,
 	return (0 != (pt->pages[offset] & mask));
 }
 
+static vbi_bool
+has_subpages			(const vbi_page_table *pt,
+				 vbi_pgno		pgno)
+{
+	uint32_t mask;
+	unsigned int offset;
+
+	mask = 1 << (pgno & 31);
+	offset = (pgno - 0x100) >> 5;
+
+	return (0 != (pt->subpage_pages[offset] & mask));
+}
+
+/* Must be called after any change of the subpages vector. */
+static void
+update_subpage_pages		(vbi_page_table *	pt)
+{
+	unsigned int i;
+
+	memset (pt->subpage_pages, 0, sizeof (pt->subpage_pages));
+
+	for (i = 0; i < pt->subpages_size; ++i) {
+		vbi_pgno pgno = pt->subpages[i].pgno;
+
+		pt->subpage_pages[(pgno - 0x100) >> 5] |= 1 << (pgno & 31);
+	}
+}
+
 /**
  * @param pt Teletext page table allocated with vbi_page_table_new().
  * @param pgno The page number in question. Need not be a valid
@@ -151,18 +185,17 @@ vbi_page_table_contains_subpage	(const vbi_page_table *pt,
 	if (contains_all_subpages (pt, pgno))
 		return TRUE;
 
-	if (VBI_ANY_SUBNO == subno) {
-		for (i = 0; i < pt->subpages_size; ++i) {
-			if (pgno == pt->subpages[i].pgno)
-				return TRUE;
-		}
-	} else {
-		for (i = 0; i < pt->subpages_size; ++i) {
-			if (pgno == pt->subpages[i].pgno
-			    && subno >= pt->subpages[i].first
-			    && subno <= pt->subpages[i].last)
-				return TRUE;
-		}
+	if (likely (!has_subpages (pt, pgno)))
+		return FALSE;
+
+	if (VBI_ANY_SUBNO == subno)
+		return TRUE;
+
+	for (i = 0; i < pt->subpages_size; ++i) {
+		if (pgno == pt->subpages[i].pgno
+		    && subno >= pt->subpages[i].first
+		    && subno <= pt->subpages[i].last)
+			return TRUE;
 	}
 
 	return FALSE;
@@ -402,7 +435,7 @@ extend_vector			(void **		vector,
 	if (unlikely (new_capacity > (max_capacity / 2))) {
 		new_capacity = max_capacity;
 	} else {
-		new_capacity = MIN (min_capacity, new_capacity * 2);
+		new_capacity = MAX (min_capacity, new_capacity * 2);
 	}
 
 	new_vec = vbi_realloc (*vector, new_capacity * element_size);
@@ -527,9 +560,14 @@ vbi_page_table_remove_subpages	(vbi_page_table *	pt,
 
 		pt->subpages_size = i;
 
+		update_subpage_pages (pt);
+
 		return TRUE;
 	}
 
+	if (!has_subpages (pt, pgno))
+		return TRUE;
+
 	for (i = 0; i < pt->subpages_size; ++i) {
 		if (pgno != pt->subpages[i].pgno)
 			continue;
@@ -551,7 +589,7 @@ vbi_page_table_remove_subpages	(vbi_page_table *	pt,
 				 (pt->subpages_size - i)
 				 * sizeof (*pt->subpages));
 
-			pt->subpages[i].last = first_subno;
+			pt->subpages[i].last = first_subno - 1;
 			pt->subpages[i + 1].first = last_subno + 1;
 
 			++pt->subpages_size;
@@ -560,16 +598,16 @@ vbi_page_table_remove_subpages	(vbi_page_table *	pt,
 			continue;
 		}
 
-		if (first_subno > pt->subpages[i].first)
-			pt->subpages[i].first = first_subno;
-
-		if (last_subno < pt->subpages[i].last)
-			pt->subpages[i].last = last_subno;
-
-		if (pt->subpages[i].first > pt->subpages[i].last) {
+		if (first_subno > pt->subpages[i].first) {
+			/* Remove the tail. */
+			pt->subpages[i].last = first_subno - 1;
+		} else if (last_subno < pt->subpages[i].last) {
+			/* Remove the head. */
+			pt->subpages[i].first = last_subno + 1;
+		} else {
 			memmove (&pt->subpages[i],
 				 &pt->subpages[i + 1],
-				 (pt->subpages_size - i)
+				 (pt->subpages_size - i - 1)
 				 * sizeof (*pt->subpages));
 
 			--pt->subpages_size;
@@ -577,6 +615,8 @@ vbi_page_table_remove_subpages	(vbi_page_table *	pt,
 		}
 	}
 
+	update_subpage_pages (pt);
+
 	shrink_subpages_vector (pt);
 
 	return TRUE;
@@ -616,7 +656,7 @@ vbi_page_table_add_subpages	(vbi_page_table *	pt,
 	if (unlikely (!valid_subpage_range (pgno, first_subno, last_subno)))
 		return FALSE;
 
-	if (vbi_page_table_contains_page (pt, pgno))
+	if (contains_all_subpages (pt, pgno))
 		return TRUE;
 
 	if (first_subno > last_subno)
@@ -645,6 +685,8 @@ vbi_page_table_add_subpages	(vbi_page_table *	pt,
 
 	pt->subpages_size = i + 1;
 
+	pt->subpage_pages[(pgno - 0x100) >> 5] |= 1 << (pgno & 31);
+
 	return TRUE;
 }
 
@@ -671,6 +713,8 @@ remove_subpages_in_page_range	(vbi_page_table *	pt,
 
 	pt->subpages_size = j;
 
+	update_subpage_pages (pt);
+
 	shrink_subpages_vector (pt);
 }
 
@@ -723,6 +767,8 @@ vbi_page_table_remove_pages	(vbi_page_table *	pt,
 	if (0x8FF == last_pgno && 0x100 == first_pgno) {
 		pt->subpages_size = 0;
 
+		update_subpage_pages (pt);
+
 		shrink_subpages_vector (pt);
 
 		memset (pt->pages, 0, sizeof (pt->pages));
@@ -798,6 +844,8 @@ vbi_page_table_add_pages	(vbi_page_table *	pt,
 	if (0x8FF == last_pgno && 0x100 == first_pgno) {
 		pt->subpages_size = 0;
 
+		update_subpage_pages (pt);
+
 		shrink_subpages_vector (pt);
 
 		memset (pt->pages, -1, sizeof (pt->pages));
@@ -905,6 +953,183 @@ vbi_page_table_add_all_pages	(vbi_page_table *	pt)
 	vbi_page_table_add_pages (pt, 0x100, 0x8FF);
 }
 
+static unsigned int
+pages_popcnt			(const vbi_page_table *pt)
+{
+	unsigned int count;
+	unsigned int i;
+
+	count = 0;
+
+	for (i = 0; i < N_ELEMENTS (pt->pages); ++i)
+		count += popcnt (pt->pages[i]);
+
+	return count;
+}
+
+/**
+ * @internal
+ * @param pt Teletext page table allocated with vbi_page_table_new().
+ * @param other Another Teletext page table.
+ *
+ * This function adds all pages and subpages in the @a other page
+ * table to @a pt.
+ *
+ * @a returns
+ * @c FALSE on failure (out of memory). @a pt may be partially
+ * updated in this case.
+ */
+vbi_bool
+_vbi_page_table_union		(vbi_page_table *	pt,
+				 const vbi_page_table *other)
+{
+	unsigned int i;
+	unsigned int j;
+
+	assert (NULL != pt);
+	assert (NULL != other);
+
+	for (i = 0; i < N_ELEMENTS (pt->pages); ++i)
+		pt->pages[i] |= other->pages[i];
+
+	pt->pages_popcnt = pages_popcnt (pt);
+
+	/* Remove duplicates of pages[] in subpages. */
+	for (i = 0, j = 0; i < pt->subpages_size; ++i) {
+		if (!contains_all_subpages (pt, pt->subpages[i].pgno))
+			pt->subpages[j++] = pt->subpages[i];
+	}
+
+	pt->subpages_size = j;
+
+	update_subpage_pages (pt);
+
+	for (i = 0; i < other->subpages_size; ++i) {
+		const struct subpage_range *sr = &other->subpages[i];
+
+		if (!vbi_page_table_add_subpages (pt, sr->pgno,
+						  sr->first, sr->last))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static vbi_bool
+append_subpage_range		(struct subpage_range **vector,
+				 unsigned int *		size,
+				 unsigned int *		capacity,
+				 vbi_pgno		pgno,
+				 vbi_subno		first_subno,
+				 vbi_subno		last_subno)
+{
+	if (*size >= *capacity) {
+		if (!extend_vector ((void **) vector, capacity,
+				    *size + 1, sizeof (**vector)))
+			return FALSE;
+	}
+
+	(*vector)[*size].pgno = pgno;
+	(*vector)[*size].first = first_subno;
+	(*vector)[*size].last = last_subno;
+
+	++*size;
+
+	return TRUE;
+}
+
+/**
+ * @internal
+ * @param pt Teletext page table allocated with vbi_page_table_new().
+ * @param other Another Teletext page table.
+ *
+ * This function removes all pages and subpages from @a pt which are
+ * not in the @a other page table.
+ *
+ * @a returns
+ * @c FALSE on failure (out of memory). @a pt remains unmodified in
+ * this case.
+ */
+vbi_bool
+_vbi_page_table_intersection	(vbi_page_table *	pt,
+				 const vbi_page_table *other)
+{
+	struct subpage_range *subpages;
+	unsigned int size;
+	unsigned int capacity;
+	unsigned int i;
+
+	assert (NULL != pt);
+	assert (NULL != other);
+
+	subpages = NULL;
+	size = 0;
+	capacity = 0;
+
+	for (i = 0; i < pt->subpages_size; ++i) {
+		const struct subpage_range *sr = &pt->subpages[i];
+		unsigned int j;
+
+		if (!has_subpages (other, sr->pgno)) {
+			if (contains_all_subpages (other, sr->pgno)
+			    && !append_subpage_range (&subpages, &size,
+						      &capacity, sr->pgno,
+						      sr->first, sr->last))
+				goto failed;
+
+			continue;
+		}
+
+		for (j = 0; j < other->subpages_size; ++j) {
+			const struct subpage_range *osr = &other->subpages[j];
+			vbi_subno first;
+			vbi_subno last;
+
+			if (sr->pgno != osr->pgno)
+				continue;
+
+			first = MAX (sr->first, osr->first);
+			last = MIN (sr->last, osr->last);
+
+			if (first <= last
+			    && !append_subpage_range (&subpages, &size,
+						      &capacity, sr->pgno,
+						      first, last))
+				goto failed;
+		}
+	}
+
+	for (i = 0; i < other->subpages_size; ++i) {
+		const struct subpage_range *osr = &other->subpages[i];
+
+		if (contains_all_subpages (pt, osr->pgno)
+		    && !append_subpage_range (&subpages, &size,
+					      &capacity, osr->pgno,
+					      osr->first, osr->last))
+			goto failed;
+	}
+
+	for (i = 0; i < N_ELEMENTS (pt->pages); ++i)
+		pt->pages[i] &= other->pages[i];
+
+	pt->pages_popcnt = pages_popcnt (pt);
+
+	vbi_free (pt->subpages);
+
+	pt->subpages = subpages;
+	pt->subpages_size = size;
+	pt->subpages_capacity = capacity;
+
+	update_subpage_pages (pt);
+
+	return TRUE;
+
+ failed:
+	vbi_free (subpages);
+
+	return FALSE;
+}
+
 /**
  * @param pt Teletext page table allocated with vbi_page_table_new(),
  *   can be @c NULL.
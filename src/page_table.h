@@ -204,6 +204,18 @@ vbi_page_table_delete		(vbi_page_table *	pt);
 extern vbi_page_table *
 vbi_page_table_new		(void);
 
+/* Private */
+
+/* Experimental. */
+extern vbi_bool
+_vbi_page_table_union		(vbi_page_table *	pt,
+				 const vbi_page_table *other)
+  _vbi_nonnull ((1, 2));
+extern vbi_bool
+_vbi_page_table_intersection	(vbi_page_table *	pt,
+				 const vbi_page_table *other)
+  _vbi_nonnull ((1, 2));
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_PAGE_TABLE_H__ */
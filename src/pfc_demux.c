@@ -144,6 +144,11 @@ _vbi_pfc_demux_decode		(vbi_pfc_demux *	dx,
 						   &dx->block)) {
 					goto desynced;
 				}
+
+				if (col >= 42) {
+					/* Block ends with the packet. */
+					return TRUE;
+				}
 			}
 		}
 
@@ -189,6 +194,57 @@ _vbi_pfc_demux_decode		(vbi_pfc_demux *	dx,
 	return FALSE;
 }
 
+/* Packet 0 of page dx->block.pgno, stream dx->block.stream
+   received. */
+static void
+page_header			(vbi_pfc_demux *	dx,
+				 vbi_subno		subno)
+{
+	unsigned int ci;
+
+	ci = subno & 15;
+	if (ci != dx->ci) {
+		/* Page continuity lost, wait for new block. */
+		vbi_pfc_demux_reset (dx);
+	}
+
+	dx->ci = (ci + 1) & 15; /* next ci expected */
+
+	dx->packet = 1;
+	dx->n_packets = ((subno >> 4) & 7) + ((subno >> 9) & 0x18);
+}
+
+/* Packet 1 ... 31 of the magazine of dx->block.pgno received. */
+static vbi_bool
+page_packet			(vbi_pfc_demux *	dx,
+				 unsigned int		packet,
+				 const uint8_t		buffer[42])
+{
+	if (0 == dx->n_packets) {
+		/* Not dx->block.pgno. */
+		return TRUE;
+	}
+
+	if (packet > 25) {
+		/* Stuffing packets, whatever. */
+		return TRUE;
+	}
+
+	if (packet != dx->packet
+	    || packet > dx->n_packets) {
+		/* Packet continuity lost, wait for new
+		   block and page header. */
+		vbi_pfc_demux_reset (dx);
+		return TRUE;
+	}
+
+	dx->packet = packet + 1; /* next packet expected */
+
+	/* Now the actual decoding. */	
+
+	return _vbi_pfc_demux_decode (dx, buffer);
+}
+
 /**
  * @param dx PFC demultiplexer context allocated with vbi_pfc_demux_new().
  * @param buffer Teletext packet (last 42 bytes, i. e. without clock
@@ -229,7 +285,6 @@ vbi_pfc_demux_feed		(vbi_pfc_demux *	dx,
 
 	if (0 == packet) {
 		unsigned int stream;
-		unsigned int ci;
 
 		pgno |= vbi_unham16p (buffer + 2);
 		if (pgno < 0)
@@ -251,16 +306,7 @@ vbi_pfc_demux_feed		(vbi_pfc_demux *	dx,
 			return TRUE;
 		}
 
-		ci = subno & 15;
-		if (ci != dx->ci) {
-			/* Page continuity lost, wait for new block. */
-			vbi_pfc_demux_reset (dx);
-		}
-
-		dx->ci = (ci + 1) & 15; /* next ci expected */
-
-		dx->packet = 1;
-		dx->n_packets = ((subno >> 4) & 7) + ((subno >> 9) & 0x18);
+		page_header (dx, subno);
 
 		return TRUE;
 	} else {
@@ -271,29 +317,7 @@ vbi_pfc_demux_feed		(vbi_pfc_demux *	dx,
 		}
 	}
 
-	if (0 == dx->n_packets) {
-		/* Not dx->block.pgno. */
-		return TRUE;
-	}
-
-	if (packet > 25) {
-		/* Stuffing packets, whatever. */
-		return TRUE;
-	}
-
-	if (packet != dx->packet
-	    || packet > dx->n_packets) {
-		/* Packet continuity lost, wait for new
-		   block and page header. */
-		vbi_pfc_demux_reset (dx);
-		return TRUE;
-	}
-
-	dx->packet = packet + 1; /* next packet expected */
-
-	/* Now the actual decoding. */	
-
-	return _vbi_pfc_demux_decode (dx, buffer);
+	return page_packet (dx, packet, buffer);
 
  desynced:
 	/* Incorrectable error, discard current block. */
@@ -335,6 +359,320 @@ vbi_pfc_demux_feed_frame	(vbi_pfc_demux *	dx,
 	return TRUE;
 }
 
+/* Multiple PFC streams */
+
+#define MAX_PFC_DEMUXES 255
+
+/**
+ * @internal
+ * A set of PFC demultiplexers fed from one Teletext stream.
+ */
+struct _vbi_pfc_multi_demux {
+	/* Index + 1 in demuxes[] of the first demux of each page
+	   0x100 ... 0x8FF, 0 if none. */
+	uint8_t			first[0x800];
+
+	/* Index + 1 of the next demux of the same page, 0 if none. */
+	uint8_t			next[MAX_PFC_DEMUXES];
+
+	vbi_pfc_demux *		demuxes[MAX_PFC_DEMUXES];
+	unsigned int		n_demuxes;
+
+	/* The demux which received the last page header. Any page
+	   header ends the reception of the previous page. */
+	vbi_pfc_demux *		curr;
+};
+
+static void
+rebuild_page_table		(_vbi_pfc_multi_demux *	md)
+{
+	unsigned int i;
+
+	CLEAR (md->first);
+
+	for (i = md->n_demuxes; i-- > 0;) {
+		unsigned int pgno = md->demuxes[i]->block.pgno;
+
+		md->next[i] = md->first[pgno - 0x100];
+		md->first[pgno - 0x100] = i + 1;
+	}
+}
+
+/* All demuxes would discard the current block after this error. */
+static void
+reset_all			(_vbi_pfc_multi_demux *	md)
+{
+	unsigned int i;
+
+	for (i = 0; i < md->n_demuxes; ++i)
+		vbi_pfc_demux_reset (md->demuxes[i]);
+
+	md->curr = NULL;
+}
+
+static vbi_bool
+multi_demux_feed		(_vbi_pfc_multi_demux *	md,
+				 const uint8_t		buffer[42])
+{
+	vbi_pfc_demux *dx;
+	int pmag;
+	vbi_pgno pgno;
+	vbi_subno subno;
+	unsigned int stream;
+	unsigned int i;
+
+	if ((pmag = vbi_unham16p (buffer)) < 0)
+		goto desynced;
+
+	pgno = pmag & 7;
+	if (0 == pgno)
+		pgno = 0x800;
+	else
+		pgno <<= 8;
+
+	if (0 != (pmag >> 3)) {
+		dx = md->curr;
+		if (NULL == dx || ((pgno ^ dx->block.pgno) & 0xF00)) {
+			/* Not a requested page. */
+			return TRUE;
+		}
+
+		return page_packet (dx, pmag >> 3, buffer);
+	}
+
+	pgno |= vbi_unham16p (buffer + 2);
+	if (pgno < 0)
+		goto desynced;
+
+	if (NULL != md->curr) {
+		md->curr->n_packets = 0;
+		md->curr = NULL;
+	}
+
+	i = md->first[pgno - 0x100];
+	if (0 == i)
+		return TRUE;
+
+	subno = vbi_unham16p (buffer + 4)
+		+ vbi_unham16p (buffer + 6) * 256;
+	if (subno < 0) {
+		for (; i > 0; i = md->next[i - 1])
+			vbi_pfc_demux_reset (md->demuxes[i - 1]);
+		return FALSE;
+	}
+
+	stream = (subno >> 8) & 15;
+
+	for (; i > 0; i = md->next[i - 1]) {
+		dx = md->demuxes[i - 1];
+		if (stream == dx->block.stream) {
+			page_header (dx, subno);
+			md->curr = dx;
+			break;
+		}
+	}
+
+	return TRUE;
+
+ desynced:
+	reset_all (md);
+
+	return FALSE;
+}
+
+/**
+ * @internal
+ * @param md PFC multi demultiplexer allocated with
+ *   _vbi_pfc_multi_demux_new().
+ * @param sliced Sliced VBI data.
+ * @param n_lines Number of lines in the @a sliced array.
+ *
+ * This function works like calling vbi_pfc_demux_feed_frame() for
+ * each demultiplexer added with _vbi_pfc_multi_demux_add(), but it
+ * decodes each packet header only once and passes the packet only
+ * to the demultiplexer of the transmitted page and stream, found
+ * through a page table. Unlike vbi_pfc_demux_feed_frame() it
+ * continues after errors.
+ *
+ * @returns
+ * @c FALSE if any Teletext lines contained incorrectable errors or
+ * a callback function returned @c FALSE.
+ */
+vbi_bool
+_vbi_pfc_multi_demux_feed_frame	(_vbi_pfc_multi_demux *	md,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines)
+{
+	const vbi_sliced *end;
+	vbi_bool success;
+
+	assert (NULL != md);
+	assert (NULL != sliced);
+
+	success = TRUE;
+
+	for (end = sliced + n_lines; sliced < end; ++sliced) {
+		if (sliced->id & VBI_SLICED_TELETEXT_B_625)
+			success &= multi_demux_feed (md, sliced->data);
+	}
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param md PFC multi demultiplexer allocated with
+ *   _vbi_pfc_multi_demux_new().
+ * @param dx Demultiplexer returned by _vbi_pfc_multi_demux_add().
+ *
+ * Removes and deletes the demultiplexer @a dx.
+ */
+void
+_vbi_pfc_multi_demux_remove	(_vbi_pfc_multi_demux *	md,
+				 vbi_pfc_demux *	dx)
+{
+	unsigned int i;
+
+	assert (NULL != md);
+
+	if (NULL == dx)
+		return;
+
+	for (i = 0; i < md->n_demuxes; ++i) {
+		if (dx == md->demuxes[i])
+			break;
+	}
+
+	assert (i < md->n_demuxes);
+
+	if (md->curr == dx)
+		md->curr = NULL;
+
+	md->demuxes[i] = md->demuxes[--md->n_demuxes];
+
+	rebuild_page_table (md);
+
+	vbi_pfc_demux_delete (dx);
+}
+
+/**
+ * @internal
+ * @param md PFC multi demultiplexer allocated with
+ *   _vbi_pfc_multi_demux_new().
+ * @param pgno Page to take PFC data from, 0x100 ... 0x8FF.
+ * @param stream PFC stream to be demultiplexed, 0 ... 15.
+ * @param callback Function to be called by
+ *   _vbi_pfc_multi_demux_feed_frame() when a new data block of this
+ *   page and stream is available.
+ * @param user_data User pointer passed through to @a callback.
+ *
+ * Adds a demultiplexer for another page and stream to @a md.
+ *
+ * @returns
+ * The new demultiplexer, which is passed to @a callback and belongs
+ * to @a md. @c NULL if the parameters are invalid, the page and
+ * stream has already been added, or on failure (out of memory).
+ */
+vbi_pfc_demux *
+_vbi_pfc_multi_demux_add	(_vbi_pfc_multi_demux *	md,
+				 vbi_pgno		pgno,
+				 unsigned int		stream,
+				 vbi_pfc_demux_cb *	callback,
+				 void *			user_data)
+{
+	vbi_pfc_demux *dx;
+	unsigned int i;
+
+	assert (NULL != md);
+	assert (NULL != callback);
+
+	if (pgno < 0x100 || pgno > 0x8FF || stream > 15)
+		return NULL;
+
+	if (md->n_demuxes >= MAX_PFC_DEMUXES)
+		return NULL;
+
+	for (i = md->first[pgno - 0x100]; i > 0; i = md->next[i - 1]) {
+		if (stream == md->demuxes[i - 1]->block.stream)
+			return NULL;
+	}
+
+	dx = vbi_pfc_demux_new (pgno, stream, callback, user_data);
+	if (NULL == dx)
+		return NULL;
+
+	md->demuxes[md->n_demuxes++] = dx;
+
+	rebuild_page_table (md);
+
+	return dx;
+}
+
+/**
+ * @internal
+ * @param md PFC multi demultiplexer allocated with
+ *   _vbi_pfc_multi_demux_new().
+ *
+ * Resets all demultiplexers of @a md, useful for example after a
+ * channel change.
+ */
+void
+_vbi_pfc_multi_demux_reset	(_vbi_pfc_multi_demux *	md)
+{
+	assert (NULL != md);
+
+	reset_all (md);
+}
+
+/**
+ * @internal
+ * @param md PFC multi demultiplexer allocated with
+ *   _vbi_pfc_multi_demux_new(), can be @c NULL.
+ *
+ * Frees all resources associated with @a md, including the
+ * demultiplexers added with _vbi_pfc_multi_demux_add().
+ */
+void
+_vbi_pfc_multi_demux_delete	(_vbi_pfc_multi_demux *	md)
+{
+	unsigned int i;
+
+	if (NULL == md)
+		return;
+
+	for (i = 0; i < md->n_demuxes; ++i)
+		vbi_pfc_demux_delete (md->demuxes[i]);
+
+	CLEAR (*md);
+
+	vbi_free (md);
+}
+
+/**
+ * @internal
+ *
+ * Allocates a set of Page Function Clear demultiplexers, initially
+ * empty. Add demultiplexers with _vbi_pfc_multi_demux_add().
+ *
+ * @returns
+ * Pointer to a newly allocated PFC multi demultiplexer which must be
+ * freed with _vbi_pfc_multi_demux_delete() when done. @c NULL on
+ * failure (out of memory).
+ */
+_vbi_pfc_multi_demux *
+_vbi_pfc_multi_demux_new	(void)
+{
+	_vbi_pfc_multi_demux *md;
+
+	md = vbi_malloc (sizeof (*md));
+	if (NULL == md)
+		return NULL;
+
+	CLEAR (*md);
+
+	return md;
+}
+
 /**
  * @internal
  */
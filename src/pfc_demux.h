@@ -153,6 +153,33 @@ struct _vbi_pfc_demux {
 	vbi_pfc_block		block;
 };
 
+typedef struct _vbi_pfc_multi_demux _vbi_pfc_multi_demux;
+
+extern vbi_bool
+_vbi_pfc_multi_demux_feed_frame	(_vbi_pfc_multi_demux *	md,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines)
+  _vbi_nonnull ((1, 2));
+extern void
+_vbi_pfc_multi_demux_remove	(_vbi_pfc_multi_demux *	md,
+				 vbi_pfc_demux *	dx)
+  _vbi_nonnull ((1));
+extern vbi_pfc_demux *
+_vbi_pfc_multi_demux_add	(_vbi_pfc_multi_demux *	md,
+				 vbi_pgno		pgno,
+				 unsigned int		stream,
+				 vbi_pfc_demux_cb *	callback,
+				 void *			user_data)
+  _vbi_nonnull ((1, 4));
+extern void
+_vbi_pfc_multi_demux_reset	(_vbi_pfc_multi_demux *	md)
+  _vbi_nonnull ((1));
+extern void
+_vbi_pfc_multi_demux_delete	(_vbi_pfc_multi_demux *	md);
+extern _vbi_pfc_multi_demux *
+_vbi_pfc_multi_demux_new	(void)
+  _vbi_alloc;
+
 extern void
 _vbi_pfc_block_dump		(const vbi_pfc_block *	pb,
 				 FILE *			fp,
@@ -36,6 +36,7 @@
 #include "event.h"		/* VBI_SERIAL */
 #include "sliced_filter.h"
 #include "page_table.h"
+#include "cc608_decoder.h"	/* VBI_CAPTION_CC1 */
 
 #ifndef VBI_SERIAL
 #  define VBI_SERIAL 0x100000
@@ -45,6 +46,7 @@
 enum {
 	VBI_ERR_INVALID_PGNO = 0,
 	VBI_ERR_INVALID_SUBNO = 0,
+	VBI_ERR_INVALID_CHANNEL = 0,
 	VBI_ERR_BUFFER_OVERFLOW = 0,
 	VBI_ERR_PARITY = 0,
 };
@@ -56,11 +58,33 @@ enum {
 /* 0 ... (VBI_ANY_SUBNO = 0x3F7F) - 1. */
 #define MAX_SUBNO 0x3F7E
 
+#define CC_SERVICES (VBI_SLICED_CAPTION_525 | VBI_SLICED_CAPTION_625)
+#define CC_F1_SERVICES (VBI_SLICED_CAPTION_525_F1 | VBI_SLICED_CAPTION_625_F1)
+#define CC_F2_SERVICES (VBI_SLICED_CAPTION_525_F2 | VBI_SLICED_CAPTION_625_F2)
+
+/* CC1, CC2, T1, T2 and CC3, CC4, T3, T4. */
+#define CC_F1_CHANNELS 0x066
+#define CC_F2_CHANNELS 0x198
+
+#define ALL_XDS_CLASSES ((1 << VBI_XDS_MAX_CLASSES) - 1)
+
 struct _vbi_sliced_filter {
 	vbi_page_table *	keep_ttx_pages;
 
 	vbi_bool		keep_ttx_system_pages;
 
+	/* Caption channels (1 << VBI_CAPTION_CC1 ... 1 << VBI_CAPTION_T4)
+	   and XDS classes (1 << VBI_XDS_CLASS_CURRENT ...) to keep
+	   in addition to keep_services. */
+	unsigned int		keep_cc_channels;
+	unsigned int		keep_xds_classes;
+
+	/* Current caption channel of each field, 0 if unknown. */
+	vbi_pgno		cc_ch_num[2];
+
+	/* Class of the current XDS packet on field 2, -1 if none. */
+	int			xds_class;
+
 	vbi_sliced *		output_buffer;
 	unsigned int		output_max_lines;
 
@@ -106,23 +130,154 @@ no_mem_error			(vbi_sliced_filter *	sf)
 	errno = ENOMEM;
 }
 
-#if 0 /* to do */
+/* Converts the caption services in sf->keep_services to
+   channels and classes, before some of them are dropped. */
+static void
+cc_services_to_channels		(vbi_sliced_filter *	sf)
+{
+	if (sf->keep_services & CC_F1_SERVICES)
+		sf->keep_cc_channels |= CC_F1_CHANNELS;
+
+	if (sf->keep_services & CC_F2_SERVICES) {
+		sf->keep_cc_channels |= CC_F2_CHANNELS;
+		sf->keep_xds_classes = ALL_XDS_CLASSES;
+	}
 
+	sf->keep_services &= ~CC_SERVICES;
+}
+
+static vbi_bool
+valid_cc_channel		(vbi_sliced_filter *	sf,
+				 vbi_pgno		channel)
+{
+	if (likely ((unsigned int) channel - VBI_CAPTION_CC1
+		    <= VBI_CAPTION_T4 - VBI_CAPTION_CC1))
+		return TRUE;
+
+	set_errstr (sf, _("Invalid caption channel %d."), channel);
+	errno = VBI_ERR_INVALID_CHANNEL;
+
+	return FALSE;
+}
+
+/**
+ * @param sf Sliced VBI filter context allocated with
+ *   vbi_sliced_filter_new().
+ * @param channel Caption channel, @c VBI_CAPTION_CC1 ...
+ *   @c VBI_CAPTION_T4.
+ *
+ * Drops the Closed Caption data of @a channel, or of all caption
+ * channels if none were added with vbi_sliced_filter_keep_cc_channel()
+ * or vbi_sliced_filter_keep_services() before.
+ *
+ * @returns
+ * @c FALSE if @a channel is invalid.
+ *
+ * @since 99.99.99
+ */
 vbi_bool
 vbi_sliced_filter_drop_cc_channel
 				(vbi_sliced_filter *	sf,
 				 vbi_pgno		channel)
 {
+	assert (NULL != sf);
+
+	if (unlikely (!valid_cc_channel (sf, channel)))
+		return FALSE;
+
+	cc_services_to_channels (sf);
+
+	sf->keep_cc_channels &= ~(1 << channel);
+
+	return TRUE;
 }
 
+/**
+ * @param sf Sliced VBI filter context allocated with
+ *   vbi_sliced_filter_new().
+ * @param channel Caption channel, @c VBI_CAPTION_CC1 ...
+ *   @c VBI_CAPTION_T4.
+ *
+ * Keeps the Closed Caption data of @a channel. Data of the other
+ * channels and XDS data on the same field is dropped unless also
+ * selected.
+ *
+ * @returns
+ * @c FALSE if @a channel is invalid.
+ *
+ * @since 99.99.99
+ */
 vbi_bool
 vbi_sliced_filter_keep_cc_channel
 				(vbi_sliced_filter *	sf,
 				 vbi_pgno		channel)
 {
+	assert (NULL != sf);
+
+	if (unlikely (!valid_cc_channel (sf, channel)))
+		return FALSE;
+
+	sf->keep_cc_channels |= 1 << channel;
+
+	return TRUE;
 }
 
-#endif
+/**
+ * @param sf Sliced VBI filter context allocated with
+ *   vbi_sliced_filter_new().
+ * @param xds_class XDS packet class.
+ *
+ * Drops XDS packets of class @a xds_class.
+ *
+ * @returns
+ * @c FALSE if @a xds_class is invalid.
+ *
+ * @since 99.99.99
+ */
+vbi_bool
+vbi_sliced_filter_drop_xds_class
+				(vbi_sliced_filter *	sf,
+				 vbi_xds_class		xds_class)
+{
+	assert (NULL != sf);
+
+	if (unlikely ((unsigned int) xds_class >= VBI_XDS_MAX_CLASSES))
+		return FALSE;
+
+	cc_services_to_channels (sf);
+
+	sf->keep_xds_classes &= ~(1 << xds_class);
+
+	return TRUE;
+}
+
+/**
+ * @param sf Sliced VBI filter context allocated with
+ *   vbi_sliced_filter_new().
+ * @param xds_class XDS packet class.
+ *
+ * Keeps XDS packets of class @a xds_class, which are transmitted
+ * on the second field.
+ *
+ * @returns
+ * @c FALSE if @a xds_class is invalid.
+ *
+ * @since 99.99.99
+ */
+vbi_bool
+vbi_sliced_filter_keep_xds_class
+				(vbi_sliced_filter *	sf,
+				 vbi_xds_class		xds_class)
+{
+	assert (NULL != sf);
+
+	if (unlikely ((unsigned int) xds_class >= VBI_XDS_MAX_CLASSES))
+		return FALSE;
+
+	sf->keep_xds_classes |= 1 << xds_class;
+
+	return TRUE;
+}
 
 void
 vbi_sliced_filter_keep_ttx_system_pages
@@ -294,6 +449,14 @@ vbi_sliced_filter_drop_services
 	if (services & VBI_SLICED_TELETEXT_B_625)
 		vbi_page_table_remove_all_pages (sf->keep_ttx_pages);
 
+	if (services & CC_F1_SERVICES)
+		sf->keep_cc_channels &= ~CC_F1_CHANNELS;
+
+	if (services & CC_F2_SERVICES) {
+		sf->keep_cc_channels &= ~CC_F2_CHANNELS;
+		sf->keep_xds_classes = 0;
+	}
+
 	return sf->keep_services &= ~services;
 }
 
@@ -307,6 +470,15 @@ vbi_sliced_filter_keep_services
 	if (services & VBI_SLICED_TELETEXT_B_625)
 		vbi_page_table_remove_all_pages (sf->keep_ttx_pages);
 
+	/* As above, the service covers these. */
+	if (services & CC_F1_SERVICES)
+		sf->keep_cc_channels &= ~CC_F1_CHANNELS;
+
+	if (services & CC_F2_SERVICES) {
+		sf->keep_cc_channels &= ~CC_F2_CHANNELS;
+		sf->keep_xds_classes = 0;
+	}
+
 	return sf->keep_services |= services;
 }
 
@@ -317,56 +489,102 @@ vbi_sliced_filter_reset	(vbi_sliced_filter *	sf)
 
 	sf->keep_mag_set_next = 0;
 	sf->start = TRUE;
+
+	sf->cc_ch_num[0] = 0;
+	sf->cc_ch_num[1] = 0;
+	sf->xds_class = -1;
 }
 
+/**
+ * @internal
+ * Teletext packet address and page header fields, decoded once per
+ * sliced line and shared by all filters of a multi filter.
+ */
+struct ttx_packet {
+	/** Error message if the packet could not be decoded. */
+	const char *		error;
+
+	unsigned int		magazine;
+	unsigned int		packet;
+
+	/** Packet 0 only. Page number 0xXFF is a filler. */
+	vbi_pgno		pgno;
+	int			flags;
+};
+
 static vbi_bool
-decode_teletext_packet_0	(vbi_sliced_filter *	sf,
-				 unsigned int *		keep_mag_set,
-				 const uint8_t		buffer[42],
-				 unsigned int		magazine)
+decode_ttx_packet		(struct ttx_packet *	tp,
+				 const uint8_t		buffer[42])
 {
+	int pmag;
 	int page;
-	int flags;
-	vbi_pgno pgno;
-	unsigned int mag_set;
 
-	page = vbi_unham16p (buffer + 2);
-	if (unlikely (page < 0)) {
-		set_errstr (sf, _("Hamming error in Teletext "
-				  "page number."));
-		errno = VBI_ERR_PARITY;
+	tp->error = NULL;
+
+	pmag = vbi_unham16p (buffer);
+	if (unlikely (pmag < 0)) {
+		tp->error = _("Hamming error in Teletext "
+			      "packet/magazine number.");
 		return FALSE;
 	}
 
-	if (0xFF == page) {
-		/* Filler, discard. */
-		*keep_mag_set = 0;
+	tp->magazine = pmag & 7;
+	if (0 == tp->magazine)
+		tp->magazine = 8;
+
+	tp->packet = pmag >> 3;
+
+	if (0 != tp->packet)
 		return TRUE;
+
+	page = vbi_unham16p (buffer + 2);
+	if (unlikely (page < 0)) {
+		tp->error = _("Hamming error in Teletext "
+			      "page number.");
+		return FALSE;
 	}
 
-	pgno = magazine * 0x100 + page;
+	tp->pgno = tp->magazine * 0x100 + page;
 
-	flags = vbi_unham16p (buffer + 4)
+	if (0xFF == page)
+		return TRUE;
+
+	tp->flags = vbi_unham16p (buffer + 4)
 		| (vbi_unham16p (buffer + 6) << 8)
 		| (vbi_unham16p (buffer + 8) << 16);
-	if (unlikely (flags < 0)) {
-		set_errstr (sf, _("Hamming error in Teletext "
-				  "packet flags."));
-		errno = VBI_ERR_PARITY;
+	if (unlikely (tp->flags < 0)) {
+		tp->error = _("Hamming error in Teletext "
+			      "packet flags.");
 		return FALSE;
 	}
 
+	return TRUE;
+}
+
+static void
+filter_teletext_packet_0	(vbi_sliced_filter *	sf,
+				 unsigned int *		keep_mag_set,
+				 const struct ttx_packet *tp)
+{
+	unsigned int mag_set;
+
+	if (0xFF == (tp->pgno & 0xFF)) {
+		/* Filler, discard. */
+		*keep_mag_set = 0;
+		return;
+	}
+
 	/* Blank lines are not transmitted and there's no page end mark,
 	   so Teletext decoders wait for another page before displaying
 	   the previous one. In serial transmission mode that is any
 	   page, in parallel mode a page of the same magazine. */
-	if (flags & VBI_SERIAL) {
+	if (tp->flags & VBI_SERIAL) {
 		mag_set = -1;
 	} else {
-		mag_set = 1 << magazine;
+		mag_set = 1 << tp->magazine;
 	}
 
-	if (!vbi_is_bcd (pgno)) {
+	if (!vbi_is_bcd (tp->pgno)) {
 		/* Page inventories and TOP pages (e.g. to
 		   find subtitles), DRCS and object pages, etc. */
 		if (sf->keep_ttx_system_pages)
@@ -374,10 +592,10 @@ decode_teletext_packet_0	(vbi_sliced_filter *	sf,
 	} else {
 		vbi_subno subno;
 
-		subno = flags & 0x3F7F;
+		subno = tp->flags & 0x3F7F;
 
 		if (vbi_page_table_contains_subpage (sf->keep_ttx_pages,
-						      pgno, subno))
+						      tp->pgno, subno))
 			goto match;
 	}
 
@@ -400,7 +618,7 @@ decode_teletext_packet_0	(vbi_sliced_filter *	sf,
 
 	sf->start = FALSE;
 
-	return TRUE;
+	return;
 
  match:
 	/* Keep this and following packets. */
@@ -408,44 +626,19 @@ decode_teletext_packet_0	(vbi_sliced_filter *	sf,
 	sf->keep_mag_set_next = *keep_mag_set;
 
 	sf->start = FALSE;
-
-	return TRUE;
 }
 
 static vbi_bool
-decode_teletext			(vbi_sliced_filter *	sf,
-				 vbi_bool *		keep,
-				 const uint8_t		buffer[42],
-				 unsigned int		line)
+filter_teletext			(vbi_sliced_filter *	sf,
+				 const struct ttx_packet *tp)
 {
-	int pmag;
-	unsigned int magazine;
-	unsigned int packet;
 	unsigned int keep_mag_set;
 
-	line = line;
-
 	keep_mag_set = sf->keep_mag_set_next;
 
-	pmag = vbi_unham16p (buffer);
-	if (unlikely (pmag < 0)) {
-		set_errstr (sf, _("Hamming error in Teletext "
-				  "packet/magazine number."));
-		errno = VBI_ERR_PARITY;
-		return FALSE;
-	}
-
-	magazine = pmag & 7;
-	if (0 == magazine)
-		magazine = 8;
-
-	packet = pmag >> 3;
-
-	switch (packet) {
+	switch (tp->packet) {
 	case 0: /* page header */
-		if (!decode_teletext_packet_0 (sf, &keep_mag_set,
-					       buffer, magazine))
-			return FALSE;
+		filter_teletext_packet_0 (sf, &keep_mag_set, tp);
 		break;
 
 	case 1 ... 25: /* page body */
@@ -459,16 +652,208 @@ decode_teletext			(vbi_sliced_filter *	sf,
 
 	case 30:
 	case 31: /* IDL packet (ETS 300 708). */
-		*keep = FALSE;
-		return TRUE;
+		return FALSE;
 
 	default:
 		assert (0);
 	}
 
-	*keep = !!(keep_mag_set & (1 << magazine));
+	return !!(keep_mag_set & (1 << tp->magazine));
+}
+
+static vbi_bool
+filter_caption			(vbi_sliced_filter *	sf,
+				 const vbi_sliced *	s)
+{
+	unsigned int f;
+	vbi_pgno ch_num;
+	int c1;
+	int c2;
+
+	if (0 == s->line) {
+		f = !(s->id & CC_F1_SERVICES);
+	} else if (s->id & VBI_SLICED_CAPTION_525) {
+		f = (s->line >= 263);
+	} else {
+		f = (s->line >= 313);
+	}
+
+	c1 = vbi_unpar8 (s->data[0]);
+	c2 = vbi_unpar8 (s->data[1]);
+
+	/* This follows the channel switching logic of the
+	   caption decoder, see cc608_decoder.c. */
+
+	if (c1 >= 0x10 && c1 < 0x20) {
+		/* Caption control code. Also terminates
+		   an XDS packet. */
+		if (1 == f)
+			sf->xds_class = -1;
+
+		/* b2: Caption / text,
+		   b1: field 1 / 2,
+		   b0 (lsb): primary / secondary channel. */
+		ch_num = VBI_CAPTION_CC1 + f * 2 + ((c1 >> 3) & 1);
+		if (sf->cc_ch_num[f] >= VBI_CAPTION_T1)
+			ch_num += 4;
+
+		if (0x14 == (c1 & 0x16) && 0x20 == (c2 & 0x70)) {
+			/* Misc Control Codes -- 001 c10f  010 xxxx */
+			switch (c2 & 15) {
+			case 0: /* RCL */
+			case 5: /* RU2 */
+			case 6: /* RU3 */
+			case 7: /* RU4 */
+			case 9: /* RDC */
+			case 15: /* EOC */
+				ch_num = VBI_CAPTION_CC1 + f * 2
+					+ ((c1 >> 3) & 1);
+				sf->cc_ch_num[f] = ch_num;
+				break;
+
+			case 10: /* TR */
+			case 11: /* RTD */
+				ch_num = VBI_CAPTION_T1 + f * 2
+					+ ((c1 >> 3) & 1);
+				sf->cc_ch_num[f] = ch_num;
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		return !!(sf->keep_cc_channels & (1 << ch_num));
+	}
+
+	if (1 == f && c1 >= 0x01 && c1 < 0x10) {
+		/* XDS packet start, continuation or terminator.
+		   Start and continuation also interrupt a Text
+		   mode transmission. */
+		if (0x0F == c1) {
+			int xds_class = sf->xds_class;
+
+			sf->xds_class = -1;
+
+			return (xds_class >= 0
+				&& (sf->keep_xds_classes
+				    & (1 << xds_class)));
+		}
+
+		sf->xds_class = (c1 - 1) >> 1;
+	}
+
+	if (1 == f && sf->xds_class >= 0) {
+		/* XDS packet data. */
+		return !!(sf->keep_xds_classes & (1 << sf->xds_class));
+	}
+
+	if (0 == c1 && 0 == c2) {
+		/* Filler, discard. */
+		return FALSE;
+	}
+
+	/* Characters, or parity error. */
+	return !!(sf->keep_cc_channels & (1 << sf->cc_ch_num[f]));
+}
+
+/**
+ * @internal
+ * @param packets If not @c NULL, Teletext lines in @a sliced_in
+ *   have already been decoded into this array, one element for
+ *   each line. Decoding errors are reported when the filter
+ *   needs the packet.
+ *
+ * Implementation of vbi_sliced_filter_cor() and
+ * _vbi_sliced_multi_filter_feed().
+ */
+static vbi_bool
+filter_lines			(vbi_sliced_filter *	sf,
+				 vbi_sliced *		sliced_out,
+				 unsigned int *		n_lines_out,
+				 unsigned int		max_lines_out,
+				 const vbi_sliced *	sliced_in,
+				 unsigned int *		n_lines_in,
+				 const struct ttx_packet *packets)
+{
+	unsigned int in;
+	unsigned int out;
+
+	errno = 0;
+
+	out = 0;
+
+	for (in = 0; in < *n_lines_in; ++in) {
+		const struct ttx_packet *tp;
+		struct ttx_packet tp_buf;
+		vbi_bool pass_through;
+
+		pass_through = !!(sliced_in[in].id & sf->keep_services);
+
+		switch (sliced_in[in].id) {
+		case VBI_SLICED_TELETEXT_B_L10_625:
+		case VBI_SLICED_TELETEXT_B_L25_625:
+		case VBI_SLICED_TELETEXT_B_625:
+			if (pass_through)
+				break;
+
+			if (NULL != packets) {
+				tp = &packets[in];
+			} else {
+				decode_ttx_packet (&tp_buf,
+						   sliced_in[in].data);
+				tp = &tp_buf;
+			}
+
+			if (unlikely (NULL != tp->error)) {
+				set_errstr (sf, "%s", tp->error);
+				errno = VBI_ERR_PARITY;
+				goto failed;
+			}
+
+			pass_through = filter_teletext (sf, tp);
+			break;
+
+		case VBI_SLICED_CAPTION_525_F1:
+		case VBI_SLICED_CAPTION_525_F2:
+		case VBI_SLICED_CAPTION_525:
+		case VBI_SLICED_CAPTION_625_F1:
+		case VBI_SLICED_CAPTION_625_F2:
+		case VBI_SLICED_CAPTION_625:
+			/* Track the current caption channel and XDS
+			   class even when we keep all caption data,
+			   the application may drop some of it later. */
+			if (filter_caption (sf, &sliced_in[in]))
+				pass_through = TRUE;
+			break;
+
+		default:
+			break;
+		}
+
+		if (pass_through) {
+			if (out >= max_lines_out) {
+				set_errstr (sf, _("Output buffer overflow."));
+				errno = VBI_ERR_BUFFER_OVERFLOW;
+				goto failed;
+			}
+
+			memcpy (&sliced_out[out],
+				&sliced_in[in],
+				sizeof (*sliced_out));
+			++out;
+		}
+	}
+
+	*n_lines_out = out;
 
 	return TRUE;
+
+ failed:
+	*n_lines_in = in;
+	*n_lines_out = out;
+
+	return FALSE;
 }
 
 /**
@@ -508,65 +893,38 @@ vbi_sliced_filter_cor		(vbi_sliced_filter *	sf,
 				 const vbi_sliced *	sliced_in,
 				 unsigned int *		n_lines_in)
 {
-	unsigned int in;
-	unsigned int out;
-
 	assert (NULL != sf);
 	assert (NULL != sliced_out);
 	assert (NULL != n_lines_out);
 	assert (NULL != sliced_in);
+	assert (NULL != n_lines_in);
 
-	errno = 0;
-
-	out = 0;
-
-	for (in = 0; in < *n_lines_in; ++in) {
-		vbi_bool pass_through;
-
-		pass_through = FALSE;
-
-		if (sliced_in[in].id & sf->keep_services) {
-			pass_through = TRUE;
-		} else {
-			switch (sliced_in[in].id) {
-			case VBI_SLICED_TELETEXT_B_L10_625:
-			case VBI_SLICED_TELETEXT_B_L25_625:
-			case VBI_SLICED_TELETEXT_B_625:
-				if (!decode_teletext (sf,
-						      &pass_through,
-						      sliced_in[in].data,
-						      sliced_in[in].line))
-					goto failed;
-				break;
+	return filter_lines (sf, sliced_out, n_lines_out, max_lines_out,
+			     sliced_in, n_lines_in, /* packets */ NULL);
+}
 
-			default:
-				break;
-			}
-		}
+static vbi_bool
+reserve_output_buffer		(vbi_sliced_filter *	sf,
+				 unsigned int		n_lines)
+{
+	vbi_sliced *s;
+	unsigned int n;
 
-		if (pass_through) {
-			if (out >= max_lines_out) {
-				set_errstr (sf, _("Output buffer overflow."));
-				errno = VBI_ERR_BUFFER_OVERFLOW;
-				goto failed;
-			}
+	if (likely (sf->output_max_lines >= n_lines))
+		return TRUE;
 
-			memcpy (&sliced_out[out],
-				&sliced_in[in],
-				sizeof (*sliced_out));
-			++out;
-		}
+	n = MAX (n_lines, 50U);
+	s = vbi_realloc (sf->output_buffer,
+			  n * sizeof (*sf->output_buffer));
+	if (unlikely (NULL == s)) {
+		no_mem_error (sf);
+		return FALSE;
 	}
 
-	*n_lines_out = out;
+	sf->output_buffer = s;
+	sf->output_max_lines = n;
 
 	return TRUE;
-
- failed:
-	*n_lines_in = in;
-	*n_lines_out = out;
-
-	return FALSE;
 }
 
 /**
@@ -603,21 +961,8 @@ vbi_sliced_filter_feed		(vbi_sliced_filter *	sf,
 	assert (NULL != n_lines);
 	assert (*n_lines <= UINT_MAX / sizeof (*sf->output_buffer));
 
-	if (unlikely (sf->output_max_lines < *n_lines)) {
-		vbi_sliced *s;
-		unsigned int n;
-
-		n = MIN (*n_lines, 50U);
-		s = vbi_realloc (sf->output_buffer,
-				  n * sizeof (*sf->output_buffer));
-		if (unlikely (NULL == s)) {
-			no_mem_error (sf);
-			return FALSE;
-		}
-
-		sf->output_buffer = s;
-		sf->output_max_lines = n;
-	}
+	if (unlikely (!reserve_output_buffer (sf, *n_lines)))
+		return FALSE;
 
 	if (!vbi_sliced_filter_cor (sf,
 				     sf->output_buffer,
@@ -705,6 +1050,336 @@ vbi_sliced_filter_new		(vbi_sliced_filter_cb *callback,
 	return sf;
 }
 
+/**
+ * @internal
+ * Sliced VBI filter routing each frame to several filters, decoding
+ * Teletext packets only once.
+ */
+struct _vbi_sliced_multi_filter {
+	/** Filters added with _vbi_sliced_multi_filter_add_sink(). */
+	vbi_sliced_filter **	sinks;
+	unsigned int		n_sinks;
+	unsigned int		max_sinks;
+
+	/** Teletext packets of the current frame. */
+	struct ttx_packet *	packets;
+	unsigned int		max_packets;
+
+	char *			errstr;
+};
+
+static void
+multi_filter_error		(_vbi_sliced_multi_filter *mf,
+				 const char *		msg)
+{
+	vbi_free (mf->errstr);
+	mf->errstr = NULL;
+
+	/* Error ignored. */
+	if (NULL != msg)
+		mf->errstr = strdup (msg);
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new().
+ * @param sliced The sliced data to be filtered.
+ * @param n_lines Pointer to a variable which contains the
+ *   number of sliced lines to be read from the @a sliced buffer.
+ *   When the function fails, it stores here the number of sliced
+ *   lines successfully read so far.
+ *
+ * This function takes one video frame worth of sliced VBI data
+ * and passes it to vbi_sliced_filter_feed() of each filter added
+ * with _vbi_sliced_multi_filter_add_sink(), except Teletext packet
+ * headers are decoded only once regardless of the number of
+ * filters.
+ *
+ * @returns
+ * @c FALSE if any filter detected an error in the sliced input data,
+ * in which case that filter does not call its callback function and
+ * @a *n_lines will contain the lines successfully read by the filter
+ * which failed first, or if any callback function returned @c FALSE.
+ * Otherwise @c TRUE.
+ */
+vbi_bool
+_vbi_sliced_multi_filter_feed	(_vbi_sliced_multi_filter *mf,
+				 const vbi_sliced *	sliced,
+				 unsigned int *		n_lines)
+{
+	vbi_service_set keep_services;
+	unsigned int n_lines_in;
+	unsigned int i;
+	vbi_bool success;
+
+	assert (NULL != mf);
+	assert (NULL != sliced);
+	assert (NULL != n_lines);
+	assert (*n_lines <= UINT_MAX / sizeof (*mf->packets));
+
+	if (unlikely (mf->max_packets < *n_lines)) {
+		struct ttx_packet *tp;
+		unsigned int n;
+
+		n = MAX (*n_lines, 50U);
+		tp = vbi_realloc (mf->packets, n * sizeof (*mf->packets));
+		if (unlikely (NULL == tp))
+			goto no_mem;
+
+		mf->packets = tp;
+		mf->max_packets = n;
+	}
+
+	/* Services passed through by all filters. */
+	keep_services = -1;
+
+	for (i = 0; i < mf->n_sinks; ++i) {
+		vbi_sliced_filter *sf = mf->sinks[i];
+
+		if (unlikely (!reserve_output_buffer (sf, *n_lines)))
+			goto no_mem;
+
+		keep_services &= sf->keep_services;
+	}
+
+	for (i = 0; i < *n_lines; ++i) {
+		const vbi_sliced *s = &sliced[i];
+
+		if (s->id & keep_services)
+			continue;
+
+		switch (s->id) {
+		case VBI_SLICED_TELETEXT_B_L10_625:
+		case VBI_SLICED_TELETEXT_B_L25_625:
+		case VBI_SLICED_TELETEXT_B_625:
+			decode_ttx_packet (&mf->packets[i], s->data);
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	success = TRUE;
+	n_lines_in = *n_lines;
+
+	for (i = 0; i < mf->n_sinks; ++i) {
+		vbi_sliced_filter *sf = mf->sinks[i];
+		unsigned int n_lines_out;
+		unsigned int n;
+
+		n = *n_lines;
+
+		/* The output buffer is large enough, this can only
+		   fail on a decoding error. */
+		if (unlikely (!filter_lines (sf, sf->output_buffer,
+					     &n_lines_out,
+					     sf->output_max_lines,
+					     sliced, &n, mf->packets))) {
+			if (success || n < n_lines_in) {
+				multi_filter_error (mf, sf->errstr);
+				n_lines_in = n;
+			}
+
+			success = FALSE;
+			continue;
+		}
+
+		/* We call all filters to keep them in sync. */
+		if (NULL != sf->callback) {
+			if (!sf->callback (sf, sf->output_buffer,
+					   n_lines_out, sf->user_data))
+				success = FALSE;
+		}
+	}
+
+	if (n_lines_in < *n_lines) {
+		*n_lines = n_lines_in;
+		errno = VBI_ERR_PARITY;
+	}
+
+	return success;
+
+ no_mem:
+	multi_filter_error (mf, _("Out of memory."));
+	errno = ENOMEM;
+	*n_lines = 0;
+
+	return FALSE;
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new().
+ * @param callback Function to be called with the filtered data
+ *   of each frame. Can be @c NULL.
+ * @param user_data User pointer passed through to the @a callback
+ *   function.
+ *
+ * Adds a filter to @a mf. Which lines the filter passes through can
+ * be configured with the vbi_sliced_filter_keep_services(),
+ * vbi_sliced_filter_keep_ttx_pages() etc functions. The filter
+ * belongs to @a mf and must be freed with
+ * _vbi_sliced_multi_filter_remove_sink(), not
+ * vbi_sliced_filter_delete().
+ *
+ * @returns
+ * Pointer to the new filter, @c NULL if out of memory.
+ */
+vbi_sliced_filter *
+_vbi_sliced_multi_filter_add_sink
+				(_vbi_sliced_multi_filter *mf,
+				 vbi_sliced_filter_cb *	callback,
+				 void *			user_data)
+{
+	vbi_sliced_filter *sf;
+
+	assert (NULL != mf);
+
+	if (mf->n_sinks >= mf->max_sinks) {
+		vbi_sliced_filter **sinks;
+		unsigned int n;
+
+		n = MAX (mf->max_sinks * 2, 8U);
+		sinks = vbi_realloc (mf->sinks, n * sizeof (*mf->sinks));
+		if (unlikely (NULL == sinks))
+			return NULL;
+
+		mf->sinks = sinks;
+		mf->max_sinks = n;
+	}
+
+	sf = vbi_sliced_filter_new (callback, user_data);
+	if (unlikely (NULL == sf))
+		return NULL;
+
+	mf->sinks[mf->n_sinks++] = sf;
+
+	return sf;
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new().
+ * @param sf Filter returned by _vbi_sliced_multi_filter_add_sink().
+ *
+ * Removes @a sf from @a mf and frees it.
+ */
+void
+_vbi_sliced_multi_filter_remove_sink
+				(_vbi_sliced_multi_filter *mf,
+				 vbi_sliced_filter *	sf)
+{
+	unsigned int i;
+
+	assert (NULL != mf);
+
+	for (i = 0; i < mf->n_sinks; ++i) {
+		if (sf == mf->sinks[i]) {
+			memmove (&mf->sinks[i], &mf->sinks[i + 1],
+				 (mf->n_sinks - i - 1) * sizeof (*mf->sinks));
+			--mf->n_sinks;
+
+			vbi_sliced_filter_delete (sf);
+
+			return;
+		}
+	}
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new().
+ *
+ * Resets all filters of @a mf, see vbi_sliced_filter_reset().
+ */
+void
+_vbi_sliced_multi_filter_reset	(_vbi_sliced_multi_filter *mf)
+{
+	unsigned int i;
+
+	assert (NULL != mf);
+
+	for (i = 0; i < mf->n_sinks; ++i)
+		vbi_sliced_filter_reset (mf->sinks[i]);
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new().
+ *
+ * @returns
+ * A description of the last error which occurred in
+ * _vbi_sliced_multi_filter_feed(), or @c NULL.
+ */
+const char *
+_vbi_sliced_multi_filter_errstr	(_vbi_sliced_multi_filter *mf)
+{
+	assert (NULL != mf);
+
+	return mf->errstr;
+}
+
+/**
+ * @internal
+ * @param mf Sliced VBI multi filter allocated with
+ *   _vbi_sliced_multi_filter_new(), can be @c NULL.
+ *
+ * Frees @a mf and all its filters.
+ */
+void
+_vbi_sliced_multi_filter_delete	(_vbi_sliced_multi_filter *mf)
+{
+	unsigned int i;
+
+	if (NULL == mf)
+		return;
+
+	for (i = 0; i < mf->n_sinks; ++i)
+		vbi_sliced_filter_delete (mf->sinks[i]);
+
+	vbi_free (mf->sinks);
+	vbi_free (mf->packets);
+	vbi_free (mf->errstr);
+
+	CLEAR (*mf);
+
+	vbi_free (mf);
+}
+
+/**
+ * @internal
+ *
+ * Allocates a sliced VBI filter which routes each frame to several
+ * filters added with _vbi_sliced_multi_filter_add_sink(), for
+ * example one for each subtitle language of a Teletext service.
+ * This is faster than running independent filters because Teletext
+ * packets are decoded only once.
+ *
+ * @returns
+ * Pointer to a newly allocated multi filter which must be freed
+ * with _vbi_sliced_multi_filter_delete() when done. @c NULL if out
+ * of memory.
+ */
+_vbi_sliced_multi_filter *
+_vbi_sliced_multi_filter_new	(void)
+{
+	_vbi_sliced_multi_filter *mf;
+
+	mf = vbi_malloc (sizeof (*mf));
+	if (NULL == mf)
+		return NULL;
+
+	CLEAR (*mf);
+
+	return mf;
+}
+
 /*
 Local variables:
 c-set-style: K&R
@@ -27,6 +27,7 @@
 #include "macros.h"
 #include "bcd.h"
 #include "sliced.h"		/* vbi_sliced, vbi_service_set */
+#include "xds_demux.h"		/* vbi_xds_class */
 
 VBI_BEGIN_DECLS
 
@@ -103,6 +104,26 @@ vbi_sliced_filter_drop_ttx_subpage
 {
 	return vbi_sliced_filter_drop_ttx_subpages (sf, pgno, subno, subno);
 }
+extern vbi_bool
+vbi_sliced_filter_keep_cc_channel
+				(vbi_sliced_filter *	sf,
+				 vbi_pgno		channel)
+  _vbi_nonnull ((1));
+extern vbi_bool
+vbi_sliced_filter_drop_cc_channel
+				(vbi_sliced_filter *	sf,
+				 vbi_pgno		channel)
+  _vbi_nonnull ((1));
+extern vbi_bool
+vbi_sliced_filter_keep_xds_class
+				(vbi_sliced_filter *	sf,
+				 vbi_xds_class		xds_class)
+  _vbi_nonnull ((1));
+extern vbi_bool
+vbi_sliced_filter_drop_xds_class
+				(vbi_sliced_filter *	sf,
+				 vbi_xds_class		xds_class)
+  _vbi_nonnull ((1));
 extern void
 vbi_sliced_filter_keep_ttx_system_pages
 				(vbi_sliced_filter *	sf,
@@ -141,6 +162,38 @@ vbi_sliced_filter_new		(vbi_sliced_filter_cb *callback,
 				 void *			user_data)
   _vbi_alloc;
 
+/* Private */
+
+/* Experimental. */
+typedef struct _vbi_sliced_multi_filter _vbi_sliced_multi_filter;
+extern vbi_bool
+_vbi_sliced_multi_filter_feed	(_vbi_sliced_multi_filter *mf,
+				 const vbi_sliced *	sliced,
+				 unsigned int *		n_lines)
+  _vbi_nonnull ((1, 2, 3));
+extern vbi_sliced_filter *
+_vbi_sliced_multi_filter_add_sink
+				(_vbi_sliced_multi_filter *mf,
+				 vbi_sliced_filter_cb *	callback,
+				 void *			user_data)
+  _vbi_nonnull ((1));
+extern void
+_vbi_sliced_multi_filter_remove_sink
+				(_vbi_sliced_multi_filter *mf,
+				 vbi_sliced_filter *	sf)
+  _vbi_nonnull ((1));
+extern void
+_vbi_sliced_multi_filter_reset	(_vbi_sliced_multi_filter *mf)
+  _vbi_nonnull ((1));
+extern const char *
+_vbi_sliced_multi_filter_errstr	(_vbi_sliced_multi_filter *mf)
+  _vbi_nonnull ((1));
+extern void
+_vbi_sliced_multi_filter_delete	(_vbi_sliced_multi_filter *mf);
+extern _vbi_sliced_multi_filter *
+_vbi_sliced_multi_filter_new	(void)
+  _vbi_alloc;
+
 VBI_END_DECLS
 
 #endif /* __ZVBI_SLICED_FILTER_H__ */
@@ -149,6 +149,9 @@ flof_links(vbi_page *pg, cache_page *vtp)
  *  TOP navigation
  */
 
+static void national_character_set(struct vbi_font_descr **font,
+				   struct ttx_extension *ext,
+				   int national);
 static void character_set_designation(struct vbi_font_descr **font,
 				      struct ttx_extension *ext,
 				      cache_page *vtp);
@@ -160,84 +163,54 @@ top_label(vbi_decoder *vbi, vbi_page *pg, struct vbi_font_descr *font,
 {
 	int column = index * 13 + 1;
 	vbi_char *acp;
-	struct ttx_ait_title *ait;
-	int i, j;
+	const struct ttx_ait_title *ait;
+	int i;
 
 	acp = &pg->text[LAST_ROW + column];
 
-	for (i = 0; i < 8; i++)
-		if (PAGE_FUNCTION_AIT == vbi->cn->btt_link[i].function) {
-			cache_page *vtp;
-
-			vtp = _vbi_cache_get_page
-				(vbi->ca, vbi->cn,
-				 vbi->cn->btt_link[i].pgno,
-				 vbi->cn->btt_link[i].subno,
-				 /* subno_mask */ 0x3f7f);
-			if (!vtp) {
-				printv ("top ait page %x not cached\n",
-					vbi->cn->btt_link[i].pgno);
-				continue;
-			} else if (vtp->function != PAGE_FUNCTION_AIT) {
-				printv("no ait page %x\n", vtp->pgno);
-				cache_page_unref (vtp);
-				vtp = NULL;
-				continue;
-			}
+	ait = &cache_network_ait_index (vbi->cn, pgno)->title;
+	if (ait->link.pgno != pgno)
+		return FALSE;
 
-			for (ait = vtp->data.ait.title, j = 0;
-			     j < 46; ait++, j++) {
-				if (ait->link.pgno == pgno) {
-					pg->nav_link[index].pgno = pgno;
-					pg->nav_link[index].subno = VBI_ANY_SUBNO;
-
-					for (i = 11; i >= 0; i--)
-						if (ait->text[i] > 0x20)
-							break;
-
-					if (ff && (i <= (11 - ff))) {
-						acp += (11 - ff - i) >> 1;
-						column += (11 - ff - i) >> 1;
-
-						acp[i + 1].link = TRUE;
-						pg->nav_index[column + i + 1] = index;
-
-						acp[i + 2].unicode = 0x003E;
-						acp[i + 2].foreground = foreground;
-						acp[i + 2].link = TRUE;
-						pg->nav_index[column + i + 2] = index;
-
-						if (ff > 1) {
-							acp[i + 3].unicode = 0x003E;
-							acp[i + 3].foreground = foreground;
-							acp[i + 3].link = TRUE;
-							pg->nav_index[column + i + 3] = index;
-						}
-					} else {
-						acp += (11 - i) >> 1;
-						column += (11 - i) >> 1;
-					}
+	pg->nav_link[index].pgno = pgno;
+	pg->nav_link[index].subno = VBI_ANY_SUBNO;
 
-					for (; i >= 0; i--) {
-						acp[i].unicode = vbi_teletext_unicode(font->G0, font->subset,
-							(ait->text[i] < 0x20) ? 0x20 : ait->text[i]);
-						acp[i].foreground = foreground;
-						acp[i].link = TRUE;
-						pg->nav_index[column + i] = index;
-					}
+	for (i = 11; i >= 0; i--)
+		if (ait->text[i] > 0x20)
+			break;
 
-					cache_page_unref (vtp);
-					vtp = NULL;
+	if (ff && (i <= (11 - ff))) {
+		acp += (11 - ff - i) >> 1;
+		column += (11 - ff - i) >> 1;
 
-					return TRUE;
-				}
-			}
+		acp[i + 1].link = TRUE;
+		pg->nav_index[column + i + 1] = index;
 
-			cache_page_unref (vtp);
-			vtp = NULL;
+		acp[i + 2].unicode = 0x003E;
+		acp[i + 2].foreground = foreground;
+		acp[i + 2].link = TRUE;
+		pg->nav_index[column + i + 2] = index;
+
+		if (ff > 1) {
+			acp[i + 3].unicode = 0x003E;
+			acp[i + 3].foreground = foreground;
+			acp[i + 3].link = TRUE;
+			pg->nav_index[column + i + 3] = index;
 		}
+	} else {
+		acp += (11 - i) >> 1;
+		column += (11 - i) >> 1;
+	}
 
-	return FALSE;
+	for (; i >= 0; i--) {
+		acp[i].unicode = vbi_teletext_unicode(font->G0, font->subset,
+			(ait->text[i] < 0x20) ? 0x20 : ait->text[i]);
+		acp[i].foreground = foreground;
+		acp[i].link = TRUE;
+		pg->nav_index[column + i] = index;
+	}
+
+	return TRUE;
 }
 
 static __inline__ vbi_pgno
@@ -305,68 +278,38 @@ top_navigation_bar(vbi_decoder *vbi, vbi_page *pg,
 	}
 }
 
-static struct ttx_ait_title *
-next_ait(vbi_decoder *vbi, int pgno, int subno, cache_page **mvtp)
+static const struct ttx_ait_index *
+next_ait(vbi_decoder *vbi, int pgno, int subno)
 {
-	struct ttx_ait_title *ait, *mait = NULL;
-	int mpgno = 0xFFF, msubno = 0xFFFF;
-	int i, j;
-
-	*mvtp = NULL;
-
-	for (i = 0; i < 8; i++) {
-		if (PAGE_FUNCTION_AIT == vbi->cn->btt_link[i].function) {
-			cache_page *vtp;
-
-			vtp = _vbi_cache_get_page
-				(vbi->ca, vbi->cn,
-				 vbi->cn->btt_link[i].pgno, 
-				 vbi->cn->btt_link[i].subno,
-				 /* subno_mask */ 0x3f7f);
-			if (!vtp) {
-				printv("top ait page %x not cached\n",
-				       vbi->cn->btt_link[i].pgno);
-				continue;
-			} else if (vtp->function != PAGE_FUNCTION_AIT) {
-				printv("no ait page %x\n", vtp->pgno);
-				cache_page_unref (vtp);
-				vtp = NULL;
-				continue;
-			}
+	const struct ttx_ait_index *ai;
 
-			for (ait = vtp->data.ait.title, j = 0; j < 46; ait++, j++) {
-				if (!ait->link.pgno)
-					break;
-
-				if (ait->link.pgno < pgno
-				    || (ait->link.pgno == pgno && ait->link.subno <= subno))
-					continue;
-
-				if (ait->link.pgno > mpgno
-				    || (ait->link.pgno == mpgno && ait->link.subno > msubno))
-					continue;
+	if (0 == vbi->cn->n_ait_titles)
+		return NULL;
 
-				mait = ait;
-				mpgno = ait->link.pgno;
-				msubno = ait->link.subno;
-
-				if (NULL != *mvtp)
-					cache_page_unref (*mvtp);
+	if (pgno < 0x100) {
+		pgno = 0x100;
+	} else {
+		ai = cache_network_ait_index (vbi->cn, pgno);
+		if (ai->title.link.pgno && ai->title.link.subno > subno)
+			return ai;
+		++pgno;
+	}
 
-				*mvtp = vtp;
-			}
-		}
+	for (; pgno <= 0x8FF; pgno++) {
+		ai = cache_network_ait_index (vbi->cn, pgno);
+		if (ai->title.link.pgno)
+			return ai;
 	}
 
-	return mait;
+	return NULL;
 }
 
 static int
 top_index(vbi_decoder *vbi, vbi_page *pg, int subno)
 {
-	cache_page *vtp = NULL;
+	const struct ttx_ait_index *ai;
 	vbi_char ac, *acp;
-	struct ttx_ait_title *ait;
+	const struct ttx_ait_title *ait;
 	int i, j, k, n, lines;
 	int xpgno, xsubno;
 	struct ttx_extension *ext;
@@ -428,14 +371,15 @@ top_index(vbi_decoder *vbi, vbi_page *pg, int subno)
 	xpgno = 0;
 	xsubno = 0;
 
-	while ((ait = next_ait(vbi, xpgno, xsubno, &vtp))) {
+	while ((ai = next_ait(vbi, xpgno, xsubno))) {
 		struct ttx_page_stat *ps;
 
+		ait = &ai->title;
 		xpgno = ait->link.pgno;
 		xsubno = ait->link.subno;
 
 		/* No docs, correct? */
-		character_set_designation(pg->font, ext, vtp);
+		national_character_set(pg->font, ext, ai->national);
 
 		if (subno > 0) {
 			if (lines-- == 0) {
@@ -443,12 +387,8 @@ top_index(vbi_decoder *vbi, vbi_page *pg, int subno)
 				lines = 17;
 			}
 
-			cache_page_unref (vtp);
-			vtp = NULL;
 			continue;
 		} else if (lines-- <= 0) {
-			cache_page_unref (vtp);
-			vtp = NULL;
 			continue;
 		}
 
@@ -484,13 +424,8 @@ top_index(vbi_decoder *vbi, vbi_page *pg, int subno)
  		}
 
 		acp += EXT_COLUMNS;
-
-		cache_page_unref (vtp);
 	}
 
-	cache_page_unref (vtp);
-	vtp = NULL;
-
 	return 1;
 }
 
@@ -1004,14 +939,15 @@ vbi_resolve_home(vbi_page *pg, vbi_link *ld)
 }
 
 static inline void
-ait_title(vbi_decoder *vbi, cache_page *vtp, struct ttx_ait_title *ait, char *buf)
+ait_title(vbi_decoder *vbi, const struct ttx_ait_index *ai, char *buf)
 {
+	const struct ttx_ait_title *ait = &ai->title;
 	struct ttx_magazine *mag;
 	struct vbi_font_descr *font[2];
 	int i;
 
 	mag = cache_network_magazine (vbi->cn, 0x100);
-	character_set_designation (font, &mag->extension, vtp);
+	national_character_set (font, &mag->extension, ai->national);
 
 	for (i = 11; i >= 0; i--)
 		if (ait->text[i] > 0x20)
@@ -1044,44 +980,19 @@ ait_title(vbi_decoder *vbi, cache_page *vtp, struct ttx_ait_title *ait, char *bu
 vbi_bool
 vbi_page_title(vbi_decoder *vbi, int pgno, int subno, char *buf)
 {
-	struct ttx_ait_title *ait;
-	int i, j;
+	const struct ttx_ait_index *ai;
 
 	subno = subno;
 
 	if (vbi->cn->have_top) {
-		for (i = 0; i < 8; i++)
-			if (PAGE_FUNCTION_AIT == vbi->cn->btt_link[i].function) {
-				cache_page *vtp;
-
-				vtp = _vbi_cache_get_page
-					(vbi->ca, vbi->cn,
-					 vbi->cn->btt_link[i].pgno, 
-					 vbi->cn->btt_link[i].subno,
-					 /* subno_mask */ 0x3f7f);
-				if (!vtp) {
-					printv("p/t top ait page %x not cached\n", vbi->cn->btt_link[i].pgno);
-					continue;
-				} else if (vtp->function != PAGE_FUNCTION_AIT) {
-					printv("p/t no ait page %x\n", vtp->pgno);
-					cache_page_unref (vtp);
-					vtp = NULL;
-					continue;
-				}
-
-				for (ait = vtp->data.ait.title, j = 0;
-				     j < 46; ait++, j++) {
-					if (ait->link.pgno == pgno) {
-						ait_title(vbi, vtp, ait, buf);
-						cache_page_unref (vtp);
-						vtp = NULL;
-						return TRUE;
-					}
-				}
+		if (pgno < 0x100 || pgno > 0x8FF)
+			return FALSE;
 
-				cache_page_unref (vtp);
-				vtp = NULL;
-			}
+		ai = cache_network_ait_index (vbi->cn, pgno);
+		if (ai->title.link.pgno == pgno) {
+			ait_title(vbi, ai, buf);
+			return TRUE;
+		}
 	} else {
 		/* find a FLOF link and the corresponding label */
 	}
@@ -1094,8 +1005,8 @@ vbi_page_title(vbi_decoder *vbi, int pgno, int subno, char *buf)
  */
 
 static void
-character_set_designation(struct vbi_font_descr **font,
-			  struct ttx_extension *ext, cache_page *vtp)
+national_character_set(struct vbi_font_descr **font,
+		       struct ttx_extension *ext, int national)
 {
 	int i;
 
@@ -1117,7 +1028,7 @@ character_set_designation(struct vbi_font_descr **font,
 		if (VALID_CHARACTER_SET(charset_code))
 			font[i] = vbi_font_descriptors + charset_code;
 
-		charset_code = (charset_code & ~7) + vtp->national;
+		charset_code = (charset_code & ~7) + national;
 
 		if (VALID_CHARACTER_SET(charset_code))
 			font[i] = vbi_font_descriptors + charset_code;
@@ -1125,6 +1036,13 @@ character_set_designation(struct vbi_font_descr **font,
 #endif
 }
 
+static void
+character_set_designation(struct vbi_font_descr **font,
+			  struct ttx_extension *ext, cache_page *vtp)
+{
+	national_character_set(font, ext, vtp->national);
+}
+
 static void
 screen_color(vbi_page *pg, int flags, int color)
 { 
@@ -2401,127 +2319,56 @@ column_41			(vbi_page *		pg,
 	acp[40].unicode = 0x0020;
 }
 
-/**
- * @internal
- * @param vbi Initialized vbi_decoder context.
- * @param pg Place to store the formatted page.
- * @param vtp Raw Teletext page. 
- * @param max_level Format the page at this Teletext implementation level.
- * @param display_rows Number of rows to format, between 1 ... 25.
- * @param navigation Analyse the page and add navigation links,
- *   including TOP and FLOF.
- * 
- * Format a page @a pg from a raw Teletext page @a vtp. This function is
- * used internally by libzvbi only.
- * 
- * @return
- * @c TRUE if the page could be formatted.
+/* Receives the cells of one formatted row, columns 0 ... 40. */
+typedef void
+level_1_row_fn(void *user_data, int row, const vbi_char *acp);
+
+/*
+ * Level 1 formatting of rows 0 ... display_rows - 1 of vtp, shared by
+ * vbi_format_vt_page() and vbi_format_vt_text_page(). The cells of each
+ * row and of the lower half of double height rows are passed to row_fn.
+ * Colors are the Level 1 color plus foreground_clut or background_clut.
+ * Returns the double_height_lower bits of the lower half rows.
  */
-int
-vbi_format_vt_page(vbi_decoder *vbi,
-		   vbi_page *pg, cache_page *vtp,
-		   vbi_wst_level max_level,
-		   int display_rows, vbi_bool navigation)
+static unsigned int
+format_level_1(cache_page *vtp, struct vbi_font_descr **font,
+	       int foreground_clut, int background_clut,
+	       const vbi_opacity *page_opacity,
+	       const vbi_opacity *boxed_opacity,
+	       int display_rows,
+	       level_1_row_fn *row_fn, void *user_data)
 {
 	char buf[16];
-	struct ttx_magazine *mag;
-	struct ttx_extension *ext;
+	unsigned int double_height_lower;
 	int column, row, i;
 
-	if (vtp->function != PAGE_FUNCTION_LOP &&
-	    vtp->function != PAGE_FUNCTION_EACEM_TRIGGER)
-		return FALSE;
-
-	printv("\nFormatting page %03x/%04x pg=%p lev=%d rows=%d nav=%d\n",
-	       vtp->pgno, vtp->subno, pg, max_level, display_rows, navigation);
-
-	display_rows = SATURATE(display_rows, 1, ROWS);
-
-	pg->vbi = vbi;
-
-	pg->nuid = vbi->network.ev.network.nuid;
-
-	pg->pgno = vtp->pgno;
-	pg->subno = vtp->subno;
-
-	pg->rows = display_rows;
-	pg->columns = EXT_COLUMNS;
-
-	pg->dirty.y0 = 0;
-	pg->dirty.y1 = ROWS - 1;
-	pg->dirty.roll = 0;
-
-	mag = (max_level <= VBI_WST_LEVEL_1p5) ?
-		&vbi->vt.default_magazine
-		: cache_network_magazine (vbi->cn, vtp->pgno);
-
-	if (vtp->x28_designations & 0x11)
-		ext = &vtp->data.ext_lop.ext;
-	else
-		ext = &mag->extension;
-
-	/* Character set designation */
-
-	character_set_designation(pg->font, ext, vtp);
-
-	/* Colors */
-
-	screen_color(pg, vtp->flags, ext->def_screen_color);
-
-	vbi_transp_colormap(vbi, pg->color_map, ext->color_map, 40);
-
-	pg->drcs_clut = ext->drcs_clut;
-
-	/* Opacity */
-
-	pg->page_opacity[1] =
-		(vtp->flags & (C5_NEWSFLASH | C6_SUBTITLE | C10_INHIBIT_DISPLAY)) ?
-			VBI_TRANSPARENT_SPACE : VBI_OPAQUE;
-	pg->boxed_opacity[1] =
-		(vtp->flags & C10_INHIBIT_DISPLAY) ?
-			VBI_TRANSPARENT_SPACE : VBI_SEMI_TRANSPARENT;
-
-	if (vtp->flags & C7_SUPPRESS_HEADER) {
-		pg->page_opacity[0] = VBI_TRANSPARENT_SPACE;
-		pg->boxed_opacity[0] = VBI_TRANSPARENT_SPACE;
-	} else {
-		pg->page_opacity[0] = pg->page_opacity[1];
-		pg->boxed_opacity[0] = pg->boxed_opacity[1];
-	}
-
-	/* DRCS */
-
-	memset(pg->drcs, 0, sizeof(pg->drcs));
-
 	/* Current page number in header */
 
 	snprintf (buf, sizeof (buf),
 		  "\2%x.%02x\7", vtp->pgno, vtp->subno & 0xff);
 
-	/* Level 1 formatting */
-
 	i = 0;
-	pg->double_height_lower = 0;
+	double_height_lower = 0;
 
 	for (row = 0; row < display_rows; row++) {
-		struct vbi_font_descr *font;
+		struct vbi_font_descr *f;
 		int mosaic_unicodes; /* 0xEE00 separate, 0xEE20 contiguous */
 		int held_mosaic_unicode;
 		int esc;
 		vbi_bool hold, mosaic;
 		vbi_bool double_height, wide_char;
-		vbi_char ac, *acp = &pg->text[row * EXT_COLUMNS];
+		vbi_char ac, acp[2 * EXT_COLUMNS];
 
 		held_mosaic_unicode = 0xEE20; /* G1 block mosaic, blank, contiguous */
 
 		memset(&ac, 0, sizeof(ac));
 
 		ac.unicode      = 0x0020;
-		ac.foreground	= ext->foreground_clut + VBI_WHITE;
-		ac.background	= ext->background_clut + VBI_BLACK;
+		ac.foreground	= foreground_clut + VBI_WHITE;
+		ac.background	= background_clut + VBI_BLACK;
 		mosaic_unicodes	= 0xEE20; /* contiguous */
-		ac.opacity	= pg->page_opacity[row > 0];
-		font		= pg->font[0];
+		ac.opacity	= page_opacity[row > 0];
+		f		= font[0];
 		esc		= 0;
 		hold		= FALSE;
 		mosaic		= FALSE;
@@ -2564,11 +2411,11 @@ vbi_format_vt_page(vbi_decoder *vbi,
 				break;
 
 			case 0x1C:		/* black background */
-				ac.background = ext->background_clut + VBI_BLACK;
+				ac.background = background_clut + VBI_BLACK;
 				break;
 
 			case 0x1D:		/* new background */
-				ac.background = ext->background_clut + (ac.foreground & 7);
+				ac.background = background_clut + (ac.foreground & 7);
 				break;
 
 			case 0x1E:		/* hold mosaic */
@@ -2583,8 +2430,8 @@ vbi_format_vt_page(vbi_decoder *vbi,
 					held_mosaic_unicode = mosaic_unicodes + raw - 0x20;
 					ac.unicode = held_mosaic_unicode;
 				} else
-					ac.unicode = vbi_teletext_unicode(font->G0,
-									  font->subset, raw);
+					ac.unicode = vbi_teletext_unicode(f->G0,
+									  f->subset, raw);
 			}
 
 			if (wide_char) {
@@ -2608,7 +2455,7 @@ vbi_format_vt_page(vbi_decoder *vbi,
 
 			switch (raw) {
 			case 0x00 ... 0x07:	/* alpha + foreground color */
-				ac.foreground = ext->foreground_clut + (raw & 7);
+				ac.foreground = foreground_clut + (raw & 7);
 				ac.conceal = FALSE;
 				mosaic = FALSE;
 				break;
@@ -2620,13 +2467,13 @@ vbi_format_vt_page(vbi_decoder *vbi,
 			case 0x0A:		/* end box */
 				if (column < (COLUMNS - 1)
 				    && vbi_unpar8 (vtp->data.lop.raw[0][i]) == 0x0a)
-					ac.opacity = pg->page_opacity[row > 0];
+					ac.opacity = page_opacity[row > 0];
 				break;
 
 			case 0x0B:		/* start box */
 				if (column < (COLUMNS - 1)
 				    && vbi_unpar8 (vtp->data.lop.raw[0][i]) == 0x0b)
-					ac.opacity = pg->boxed_opacity[row > 0];
+					ac.opacity = boxed_opacity[row > 0];
 				break;
 
 			case 0x0D:		/* double height */
@@ -2652,7 +2499,7 @@ vbi_format_vt_page(vbi_decoder *vbi,
 				break;
 
 			case 0x10 ... 0x17:	/* mosaic + foreground color */
-				ac.foreground = ext->foreground_clut + (raw & 7);
+				ac.foreground = foreground_clut + (raw & 7);
 				ac.conceal = FALSE;
 				mosaic = TRUE;
 				break;
@@ -2662,7 +2509,7 @@ vbi_format_vt_page(vbi_decoder *vbi,
 				break;
 
 			case 0x1B:		/* ESC */
-				font = pg->font[esc ^= 1];
+				f = font[esc ^= 1];
 				break;
 			}
 		}
@@ -2692,13 +2539,131 @@ vbi_format_vt_page(vbi_decoder *vbi,
 				}
 			}
 
+			row_fn (user_data, row, acp);
+
 			i += COLUMNS;
 			row++;
 
-			pg->double_height_lower |= 1 << row;
+			double_height_lower |= 1 << row;
+
+			row_fn (user_data, row, acp + EXT_COLUMNS);
+		} else {
+			row_fn (user_data, row, acp);
 		}
 	}
 
+	return double_height_lower;
+}
+
+
+static void
+store_vbi_page_row(void *user_data, int row, const vbi_char *acp)
+{
+	vbi_page *pg = user_data;
+
+	memcpy(&pg->text[row * EXT_COLUMNS], acp,
+	       EXT_COLUMNS * sizeof(*acp));
+}
+
+/**
+ * @internal
+ * @param vbi Initialized vbi_decoder context.
+ * @param pg Place to store the formatted page.
+ * @param vtp Raw Teletext page. 
+ * @param max_level Format the page at this Teletext implementation level.
+ * @param display_rows Number of rows to format, between 1 ... 25.
+ * @param navigation Analyse the page and add navigation links,
+ *   including TOP and FLOF.
+ * 
+ * Format a page @a pg from a raw Teletext page @a vtp. This function is
+ * used internally by libzvbi only.
+ * 
+ * @return
+ * @c TRUE if the page could be formatted.
+ */
+int
+vbi_format_vt_page(vbi_decoder *vbi,
+		   vbi_page *pg, cache_page *vtp,
+		   vbi_wst_level max_level,
+		   int display_rows, vbi_bool navigation)
+{
+	struct ttx_magazine *mag;
+	struct ttx_extension *ext;
+	int column, row, i;
+
+	if (vtp->function != PAGE_FUNCTION_LOP &&
+	    vtp->function != PAGE_FUNCTION_EACEM_TRIGGER)
+		return FALSE;
+
+	printv("\nFormatting page %03x/%04x pg=%p lev=%d rows=%d nav=%d\n",
+	       vtp->pgno, vtp->subno, pg, max_level, display_rows, navigation);
+
+	display_rows = SATURATE(display_rows, 1, ROWS);
+
+	pg->vbi = vbi;
+
+	pg->nuid = vbi->network.ev.network.nuid;
+
+	pg->pgno = vtp->pgno;
+	pg->subno = vtp->subno;
+
+	pg->rows = display_rows;
+	pg->columns = EXT_COLUMNS;
+
+	pg->dirty.y0 = 0;
+	pg->dirty.y1 = ROWS - 1;
+	pg->dirty.roll = 0;
+
+	mag = (max_level <= VBI_WST_LEVEL_1p5) ?
+		&vbi->vt.default_magazine
+		: cache_network_magazine (vbi->cn, vtp->pgno);
+
+	if (vtp->x28_designations & 0x11)
+		ext = &vtp->data.ext_lop.ext;
+	else
+		ext = &mag->extension;
+
+	/* Character set designation */
+
+	character_set_designation(pg->font, ext, vtp);
+
+	/* Colors */
+
+	screen_color(pg, vtp->flags, ext->def_screen_color);
+
+	vbi_transp_colormap(vbi, pg->color_map, ext->color_map, 40);
+
+	pg->drcs_clut = ext->drcs_clut;
+
+	/* Opacity */
+
+	pg->page_opacity[1] =
+		(vtp->flags & (C5_NEWSFLASH | C6_SUBTITLE | C10_INHIBIT_DISPLAY)) ?
+			VBI_TRANSPARENT_SPACE : VBI_OPAQUE;
+	pg->boxed_opacity[1] =
+		(vtp->flags & C10_INHIBIT_DISPLAY) ?
+			VBI_TRANSPARENT_SPACE : VBI_SEMI_TRANSPARENT;
+
+	if (vtp->flags & C7_SUPPRESS_HEADER) {
+		pg->page_opacity[0] = VBI_TRANSPARENT_SPACE;
+		pg->boxed_opacity[0] = VBI_TRANSPARENT_SPACE;
+	} else {
+		pg->page_opacity[0] = pg->page_opacity[1];
+		pg->boxed_opacity[0] = pg->boxed_opacity[1];
+	}
+
+	/* DRCS */
+
+	memset(pg->drcs, 0, sizeof(pg->drcs));
+
+	/* Level 1 formatting */
+
+	pg->double_height_lower =
+		format_level_1(vtp, pg->font,
+			       ext->foreground_clut, ext->background_clut,
+			       pg->page_opacity, pg->boxed_opacity,
+			       display_rows, store_vbi_page_row, pg);
+
 	if (0) {
 		if (row < ROWS) {
 			vbi_char ac;
@@ -2804,6 +2769,137 @@ vbi_format_vt_page(vbi_decoder *vbi,
 	return TRUE;
 }
 
+#define TEXT_BG(color)		((color) << 3)
+#define TEXT_SIZE(size)		((size) << 6)
+#define TEXT_OPACITY(opacity)	((opacity) << 9)
+
+static void
+store_text_page_row(void *user_data, int row, const vbi_char *acp)
+{
+	vbi_text_page *tp = user_data;
+	uint16_t *up = &tp->unicode[row * COLUMNS];
+	uint16_t *ap = &tp->attr[row * COLUMNS];
+	int column;
+
+	for (column = 0; column < COLUMNS; ++column) {
+		up[column] = acp[column].unicode;
+		ap[column] = acp[column].foreground
+			| TEXT_BG (acp[column].background)
+			| TEXT_SIZE (acp[column].size)
+			| TEXT_OPACITY (acp[column].opacity)
+			| (acp[column].flash ? VBI_TEXT_FLASH : 0)
+			| (acp[column].conceal ? VBI_TEXT_CONCEAL : 0);
+	}
+}
+
+/**
+ * @internal
+ * @param vbi Initialized vbi_decoder context.
+ * @param tp Place to store the formatted page.
+ * @param vtp Raw Teletext page.
+ * @param display_rows Number of rows to format, between 1 ... 25.
+ *
+ * Level 1 only version of vbi_format_vt_page(). Enhancements,
+ * navigation and link analysis are skipped and the result is stored
+ * in the compact vbi_text_page format.
+ *
+ * @return
+ * @c TRUE if the page could be formatted.
+ */
+vbi_bool
+vbi_format_vt_text_page(vbi_decoder *vbi,
+			vbi_text_page *tp, cache_page *vtp,
+			int display_rows)
+{
+	struct ttx_extension *ext;
+	struct vbi_font_descr *font[2];
+	vbi_opacity page_opacity[2];
+	vbi_opacity boxed_opacity[2];
+
+	if (vtp->function != PAGE_FUNCTION_LOP &&
+	    vtp->function != PAGE_FUNCTION_EACEM_TRIGGER)
+		return FALSE;
+
+	display_rows = SATURATE(display_rows, 1, ROWS);
+
+	tp->pgno = vtp->pgno;
+	tp->subno = vtp->subno;
+	tp->rows = display_rows;
+
+	if (vtp->x28_designations & 0x11)
+		ext = &vtp->data.ext_lop.ext;
+	else
+		ext = &vbi->vt.default_magazine.extension;
+
+	character_set_designation(font, ext, vtp);
+
+	tp->screen_opacity =
+		(vtp->flags & (C5_NEWSFLASH | C6_SUBTITLE)) ?
+			VBI_TRANSPARENT_SPACE : VBI_OPAQUE;
+
+	page_opacity[1] =
+		(vtp->flags & (C5_NEWSFLASH | C6_SUBTITLE | C10_INHIBIT_DISPLAY)) ?
+			VBI_TRANSPARENT_SPACE : VBI_OPAQUE;
+	boxed_opacity[1] =
+		(vtp->flags & C10_INHIBIT_DISPLAY) ?
+			VBI_TRANSPARENT_SPACE : VBI_SEMI_TRANSPARENT;
+
+	if (vtp->flags & C7_SUPPRESS_HEADER) {
+		page_opacity[0] = VBI_TRANSPARENT_SPACE;
+		boxed_opacity[0] = VBI_TRANSPARENT_SPACE;
+	} else {
+		page_opacity[0] = page_opacity[1];
+		boxed_opacity[0] = boxed_opacity[1];
+	}
+
+	format_level_1(vtp, font, 0, 0, page_opacity, boxed_opacity,
+		       display_rows, store_text_page_row, tp);
+
+	return TRUE;
+}
+
+/**
+ * @param vbi Initialized vbi_decoder context.
+ * @param tp Place to store the formatted page.
+ * @param pgno Page number of the page to fetch, see vbi_pgno.
+ * @param subno Subpage number to fetch (optional @c VBI_ANY_SUBNO).
+ * @param display_rows Number of rows to format, between 1 ... 25.
+ *
+ * Fetches a Teletext page designated by @a pgno and @a subno from the
+ * cache and formats it at Level 1, storing only the text and basic
+ * attributes in @a tp. This is considerably faster than
+ * vbi_fetch_vt_page() because no navigation, link or enhancement
+ * analysis takes place, and the compact vbi_text_page is less than
+ * half the size of a vbi_page. Intended for clients like subtitle
+ * extractors which process many pages. The TOP index page 0x900
+ * cannot be fetched with this function.
+ *
+ * @return
+ * @c FALSE if the page is not cached or could not be formatted
+ * for other reasons, for instance is a data page not intended for
+ * display.
+ *
+ * @since 0.2.34
+ */
+vbi_bool
+vbi_fetch_vt_text_page(vbi_decoder *vbi, vbi_text_page *tp,
+		       vbi_pgno pgno, vbi_subno subno,
+		       int display_rows)
+{
+	cache_page *vtp;
+	vbi_bool success;
+
+	vtp = _vbi_cache_get_page (vbi->ca, vbi->cn, pgno, subno, -1);
+	if (!vtp)
+		return FALSE;
+
+	success = vbi_format_vt_text_page (vbi, tp, vtp, display_rows);
+
+	cache_page_unref (vtp);
+
+	return success;
+}
+
 /**
  * @param vbi Initialized vbi_decoder context.
  * @param pg Place to store the formatted page.
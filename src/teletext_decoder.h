@@ -27,6 +27,7 @@
 #define TELETEXT_H
 
 #include "cache-priv.h"
+#include "page_table.h"
 
 struct raw_page {
 	cache_page		page[1];
@@ -66,6 +67,10 @@ struct teletext {
 
 	struct raw_page			raw_page[8];
 	struct raw_page			*current;
+
+	/* Pages to decode, NULL for all, see
+	   _vbi_teletext_set_page_filter(). */
+	const vbi_page_table *		page_filter;
 };
 
 /* Public */
@@ -85,6 +90,10 @@ extern vbi_bool		vbi_fetch_vt_page(vbi_decoder *vbi, vbi_page *pg,
 					  vbi_pgno pgno, vbi_subno subno,
 					  vbi_wst_level max_level, int display_rows,
 					  vbi_bool navigation);
+extern vbi_bool		vbi_fetch_vt_text_page(vbi_decoder *vbi,
+					       vbi_text_page *tp,
+					       vbi_pgno pgno, vbi_subno subno,
+					       int display_rows);
 extern int		vbi_page_title(vbi_decoder *vbi, int pgno, int subno, char *buf);
 /** @} */
 /**
@@ -105,6 +114,8 @@ extern void		vbi_teletext_destroy(vbi_decoder *vbi);
 extern vbi_bool		vbi_decode_teletext(vbi_decoder *vbi, uint8_t *p);
 extern void		vbi_teletext_desync(vbi_decoder *vbi);
 extern void             vbi_teletext_channel_switched(vbi_decoder *vbi);
+extern void		_vbi_teletext_set_page_filter(vbi_decoder *vbi,
+						      const vbi_page_table *pt);
 extern cache_page *	vbi_convert_page(vbi_decoder *vbi, cache_page *vtp,
 					 vbi_bool cached,
 					 enum ttx_page_function new_function);
@@ -118,6 +129,10 @@ extern vbi_bool		vbi_format_vt_page(vbi_decoder *, vbi_page *,
 					   vbi_wst_level max_level,
 					   int display_rows,
 					   vbi_bool navigation);
+extern vbi_bool		vbi_format_vt_text_page(vbi_decoder *,
+						vbi_text_page *,
+						cache_page *,
+						int display_rows);
 
 #endif
 
@@ -470,6 +470,22 @@ struct ttx_ait_title {
 	uint8_t				text[12];
 };
 
+/**
+ * @internal
+ * TOP title index entry, one per page number. Maintained by the
+ * Teletext decoder as AIT packets arrive, see cache_network_ait_index().
+ */
+struct ttx_ait_index {
+	/** Last received AIT entry for this page, link.pgno 0 if none. */
+	struct ttx_ait_title		title;
+
+	/** AIT page which transmitted the entry. */
+	vbi_pgno			ait_pgno;
+
+	/** National character set option bits of the AIT page. */
+	uint8_t				national;
+};
+
 /* Basic level one page. */
 
 /**
@@ -818,193 +818,281 @@ _vbi_xds_packet_dump		(const vbi_xds_packet *	xp,
 void
 vbi_xds_demux_reset		(vbi_xds_demux *	xd)
 {
-	unsigned int n;
-	unsigned int i;
-
 	assert (NULL != xd);
 
-	n = N_ELEMENTS (xd->subpacket) * N_ELEMENTS (xd->subpacket[0]);
-
-	for (i = 0; i < n; ++i)
-		xd->subpacket[0][i].count = 0;
+	CLEAR (xd->subpacket);
+	CLEAR (xd->last);
 
 	xd->curr_sp = NULL;
 }
 
-/**
- * @param xd XDS demultiplexer context allocated with vbi_xds_demux_new().
- * @param buffer Closed Caption character pair, as in struct vbi_sliced.
- *
- * This function takes two successive bytes of a raw Closed Caption
- * stream, filters out XDS data and calls the output function given to
- * vbi_xds_demux_new() when a new packet is complete.
- *
- * You should feed only data from NTSC line 284.
- *
- * @returns
- * @c FALSE if the buffer contained parity errors.
- *
- * @since 0.2.16
- */
-vbi_bool
-vbi_xds_demux_feed		(vbi_xds_demux *	xd,
-				 const uint8_t		buffer[2])
+/* What to do with the first byte of a Closed Caption character pair
+   on line 284. */
+enum xds_code {
+	XDS_STUFFING,
+	XDS_START,
+	XDS_CONTINUE,
+	XDS_BAD_CLASS,
+	XDS_END,
+	XDS_CAPTION,
+	XDS_DATA
+};
+
+static const uint8_t
+xds_codes[0x80] = {
+	[0x00] = XDS_STUFFING,
+	/* Class current, future, channel, misc. */
+	[0x01] = XDS_START,	[0x02] = XDS_CONTINUE,
+	[0x03] = XDS_START,	[0x04] = XDS_CONTINUE,
+	[0x05] = XDS_START,	[0x06] = XDS_CONTINUE,
+	[0x07] = XDS_START,	[0x08] = XDS_CONTINUE,
+	/* Class public service, reserved, undefined. */
+	[0x09 ... 0x0E] = XDS_BAD_CLASS,
+	[0x0F] = XDS_END,
+	[0x10 ... 0x1F] = XDS_CAPTION,
+	[0x20 ... 0x7F] = XDS_DATA
+};
+
+#define NO_SUBPACKET 0xFF
+
+/* Maps the second byte of a packet header, the subclass, to a
+   subpacket index. MISC subclasses 0x4n are stored at 0x10 + n. */
+static const uint8_t
+subpacket_index[0x80] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	[0x18 ... 0x3F] = NO_SUBPACKET,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	[0x48 ... 0x7F] = NO_SUBPACKET
+};
+
+static unsigned int
+subclass_to_index		(vbi_xds_subclass	xds_subclass)
 {
-	_vbi_xds_subpacket *sp;
-	vbi_bool r;
-	int c1, c2;
+	if (xds_subclass >= N_ELEMENTS (subpacket_index))
+		return NO_SUBPACKET;
 
-	assert (NULL != xd);
-	assert (NULL != buffer);
+	return subpacket_index[xds_subclass];
+}
 
-	r = TRUE;
+static void
+discard_subpacket		(vbi_xds_demux *	xd)
+{
+	_vbi_xds_subpacket *sp;
 
 	sp = xd->curr_sp;
+	if (NULL != sp) {
+		sp->count = 0;
+		sp->checksum = 0;
+	}
+
+	xd->curr_sp = NULL;
+}
+
+/* Decodes one character pair. Returns 1 and stores the packet in
+   *xp if a packet is complete, 0 if not, -1 on parity error. */
+static int
+decode_pair			(vbi_xds_demux *	xd,
+				 vbi_xds_packet *	xp,
+				 const uint8_t		buffer[2])
+{
+	_vbi_xds_subpacket *sp;
+	int c1, c2;
 
 	log ("XDS demux %02x %02x\n", buffer[0], buffer[1]);
 
 	c1 = vbi_unpar8 (buffer[0]);
 	c2 = vbi_unpar8 (buffer[1]);
 
-	if ((c1 | c2) < 0) {
+	if (unlikely ((c1 | c2) < 0)) {
 		log ("XDS tx error, discard current packet\n");
- 
-		if (sp) {
-			sp->count = 0;
-			sp->checksum = 0;
+		discard_subpacket (xd);
+		return -1;
+	}
+
+	sp = xd->curr_sp;
+
+	switch (xds_codes[c1]) {
+	case XDS_DATA:
+		/* Packet contents. */
+
+		if (unlikely (NULL == sp)) {
+			log ("XDS can't store packet, missed start\n");
+			break;
 		}
 
-		xd->curr_sp = NULL;
+		if (unlikely (sp->count > sizeof (sp->buffer))) {
+			log ("XDS discard packet 0x%x/0x%02x, "
+			     "buffer overflow\n",
+			     xd->curr.xds_class, xd->curr.xds_subclass);
+			discard_subpacket (xd);
+			break;
+		}
 
-		return FALSE;
-	}
+		sp->buffer[sp->count - 2] = c1;
+		sp->buffer[sp->count - 1] = c2;
 
-	switch (c1) {
-	case 0x00:
-		/* Stuffing. */
+		sp->checksum += c1 + c2;
+		sp->count += 1 + (0 != c2);
 
 		break;
 
-	case 0x01 ... 0x0E:
+	case XDS_STUFFING:
+		break;
+
+	case XDS_START:
+	case XDS_CONTINUE:
 	{
 		vbi_xds_class xds_class;
-		vbi_xds_subclass xds_subclass;
 		unsigned int i;
 
 		/* Packet header. */
 
 		xds_class = (c1 - 1) >> 1;
-		xds_subclass = c2;
-
-		i = xds_subclass;
-
-		/* MISC subclass 0x4n */
-		if (i >= 0x40)
-			i += 0x10 - 0x40;
 
-		if (xds_class > VBI_XDS_CLASS_MISC
-		    || i > N_ELEMENTS (xd->subpacket[0])) {
+		i = subpacket_index[c2];
+		if (unlikely (NO_SUBPACKET == i)) {
 			log ("XDS ignore packet 0x%x/0x%02x, "
-			     "unknown class or subclass\n",
-			     xds_class, xds_subclass);
-			goto discard;
+			     "unknown subclass\n",
+			     xds_class, c2);
+			discard_subpacket (xd);
+			break;
 		}
 
 		sp = &xd->subpacket[xds_class][i];
 
 		xd->curr_sp = sp;
 		xd->curr.xds_class = xds_class;
-		xd->curr.xds_subclass = xds_subclass;
+		xd->curr.xds_subclass = c2;
 
-		if (c1 & 1) {
-			/* Start packet. */
+		if (XDS_START == xds_codes[c1]) {
 			sp->checksum = c1 + c2;
 			sp->count = 2;
-		} else {
-			/* Continue packet. */
-			if (0 == sp->count) {
-				log ("XDS can't continue packet "
-				     "0x%x/0x%02x, missed start\n",
-				     xd->curr.xds_class,
-				     xd->curr.xds_subclass);
-				goto discard;
-			}
+		} else if (unlikely (0 == sp->count)) {
+			log ("XDS can't continue packet "
+			     "0x%x/0x%02x, missed start\n",
+			     xd->curr.xds_class,
+			     xd->curr.xds_subclass);
+			discard_subpacket (xd);
 		}
 
 		break;
 	}
 
-	case 0x0F:
+	case XDS_BAD_CLASS:
+		log ("XDS ignore packet 0x%x/0x%02x, unknown class\n",
+		     (c1 - 1) >> 1, c2);
+		discard_subpacket (xd);
+		break;
+
+	case XDS_END:
 		/* Packet terminator. */
 
-		if (!sp) {
+		if (unlikely (NULL == sp)) {
 			log ("XDS can't finish packet, missed start\n");
 			break;
 		}
 
 		sp->checksum += c1 + c2;
 
-		if (0 != (sp->checksum & 0x7F)) {
+		if (unlikely (0 != (sp->checksum & 0x7F))) {
 			log ("XDS ignore packet 0x%x/0x%02x, "
 			     "checksum error\n",
 			     xd->curr.xds_class, xd->curr.xds_subclass);
-		} else if (sp->count <= 2) {
+		} else if (unlikely (sp->count <= 2)) {
 			log ("XDS ignore empty packet 0x%x/0x%02x\n",
 			     xd->curr.xds_class, xd->curr.xds_subclass);
 		} else {
-			memcpy (xd->curr.buffer, sp->buffer, 32);
+			vbi_xds_packet *last;
+			unsigned int size;
+
+			size = sp->count - 2;
+
+			/* Subpackets and last packets are stored in
+			   arrays of the same shape. */
+			last = &xd->last[0][0]
+				+ (sp - &xd->subpacket[0][0]);
+
+			if (size == last->buffer_size
+			    && xd->curr.xds_subclass == last->xds_subclass
+			    && 0 == memcmp (last->buffer, sp->buffer, size)) {
+				if (xd->filter_duplicates) {
+					log ("XDS ignore repeated packet "
+					     "0x%x/0x%02x\n",
+					     xd->curr.xds_class,
+					     xd->curr.xds_subclass);
+					discard_subpacket (xd);
+					break;
+				}
+			} else {
+				last->xds_class = xd->curr.xds_class;
+				last->xds_subclass = xd->curr.xds_subclass;
+				last->buffer_size = size;
+				memcpy (last->buffer, sp->buffer, size);
+				last->buffer[size] = 0;
+			}
 
-			xd->curr.buffer_size = sp->count - 2;
-			xd->curr.buffer[sp->count - 2] = 0;
+			xp->xds_class = xd->curr.xds_class;
+			xp->xds_subclass = xd->curr.xds_subclass;
 
-			if (XDS_DEMUX_LOG)
-				_vbi_xds_packet_dump (&xd->curr, stderr);
+			memcpy (xp->buffer, sp->buffer, 32);
 
-			r = xd->callback (xd, &xd->curr, xd->user_data);
-		}
+			xp->buffer_size = size;
+			xp->buffer[size] = 0;
 
-		/* fall through */
+			if (XDS_DEMUX_LOG)
+				_vbi_xds_packet_dump (xp, stderr);
+
+			discard_subpacket (xd);
 
-	discard:
-		if (sp) {
-			sp->count = 0;
-			sp->checksum = 0;
+			return 1;
 		}
 
-		/* fall through */
+		discard_subpacket (xd);
 
-	case 0x10 ... 0x1F:
+		break;
+
+	case XDS_CAPTION:
 		/* Closed Caption. */
 
 		xd->curr_sp = NULL;
 
 		break;
+	}
 
-	case 0x20 ... 0x7F:
-		/* Packet contents. */
-
-		if (!sp) {
-			log ("XDS can't store packet, missed start\n");
-			break;
-		}
-
-		if (sp->count >= sizeof (sp->buffer) + 2) {
-			log ("XDS discard packet 0x%x/0x%02x, "
-			     "buffer overflow\n",
-			     xd->curr.xds_class, xd->curr.xds_subclass);
-			goto discard;
-		}
+	return 0;
+}
 
-		sp->buffer[sp->count - 2] = c1;
-		sp->buffer[sp->count - 1] = c2;
+/**
+ * @param xd XDS demultiplexer context allocated with vbi_xds_demux_new().
+ * @param buffer Closed Caption character pair, as in struct vbi_sliced.
+ *
+ * This function takes two successive bytes of a raw Closed Caption
+ * stream, filters out XDS data and calls the output function given to
+ * vbi_xds_demux_new() when a new packet is complete.
+ *
+ * You should feed only data from NTSC line 284.
+ *
+ * @returns
+ * @c FALSE if the buffer contained parity errors.
+ *
+ * @since 0.2.16
+ */
+vbi_bool
+vbi_xds_demux_feed		(vbi_xds_demux *	xd,
+				 const uint8_t		buffer[2])
+{
+	int r;
 
-		sp->checksum += c1 + c2;
-		sp->count += 1 + (0 != c2);
+	assert (NULL != xd);
+	assert (NULL != buffer);
 
-		break;
-	}
+	r = decode_pair (xd, &xd->curr, buffer);
+	if (r > 0)
+		return xd->callback (xd, &xd->curr, xd->user_data);
 
-	return r;
+	return (0 == r);
 }
 
 /**
@@ -1051,15 +1139,153 @@ vbi_xds_demux_feed_frame	(vbi_xds_demux *	xd,
 	return TRUE;
 }
 
-#if 0 /* ideas */
+/**
+ * @internal
+ * @param xd XDS demultiplexer context allocated with vbi_xds_demux_new().
+ * @param packets Completed XDS packets will be stored here.
+ * @param n_packets The number of packets in the @a packets array
+ *   will be stored here.
+ * @param max_packets Size of the @a packets array.
+ * @param sliced Input sliced data.
+ * @param n_lines On entry the number of lines in the @a sliced array,
+ *   on return the number of lines consumed.
+ *
+ * This function works like vbi_xds_demux_feed_frame(), but instead
+ * of calling the callback function for each packet it stores all
+ * packets completed in the @a sliced array in the @a packets array.
+ * A Closed Caption line completes at most one packet, so @a n_lines
+ * packets always suffice. The function stops early if the
+ * @a packets array is full, and continues after a parity error.
+ *
+ * @returns
+ * @c FALSE if the @a sliced data contained parity errors.
+ */
+vbi_bool
+_vbi_xds_demux_cor		(vbi_xds_demux *	xd,
+				 vbi_xds_packet *	packets,
+				 unsigned int *		n_packets,
+				 unsigned int		max_packets,
+				 const vbi_sliced *	sliced,
+				 unsigned int *		n_lines)
+{
+	const vbi_sliced *start;
+	const vbi_sliced *end;
+	unsigned int n_out;
+	vbi_bool success;
+
+	assert (NULL != xd);
+	assert (NULL != packets);
+	assert (NULL != n_packets);
+	assert (NULL != sliced);
+	assert (NULL != n_lines);
+
+	success = TRUE;
+	n_out = 0;
+
+	start = sliced;
+
+	for (end = sliced + *n_lines; sliced < end; ++sliced) {
+		int r;
+
+		switch (sliced->id) {
+		case VBI_SLICED_CAPTION_525:
+		case VBI_SLICED_CAPTION_525_F2:
+			if (284 != sliced->line
+			    && 0 != sliced->line)
+				continue;
+
+			if (n_out >= max_packets)
+				goto full;
+
+			r = decode_pair (xd, &packets[n_out],
+					 sliced->data);
+			if (r > 0)
+				++n_out;
+			else if (r < 0)
+				success = FALSE;
+
+			break;
+
+		default:
+			break;
+		}
+	}
+
+ full:
+	*n_packets = n_out;
+	*n_lines = sliced - start;
+
+	return success;
+}
+
+/**
+ * @internal
+ * @param xd XDS demultiplexer context allocated with vbi_xds_demux_new().
+ * @param xds_class XDS class.
+ * @param xds_subclass XDS subclass.
+ *
+ * Returns the most recently received packet of the given class and
+ * subclass. Unlike the callback this function also reports packets
+ * suppressed by _vbi_xds_demux_filter_duplicates(), which are
+ * identical to the last packet.
+ *
+ * @returns
+ * Pointer to the packet, valid until the next call of a demux
+ * function. @c NULL if no packet of this class and subclass has
+ * been received since the last reset.
+ */
 const vbi_xds_packet *
-vbi_xds_demux_get_packet	(vbi_xds_demux *	xd,
+_vbi_xds_demux_get_packet	(vbi_xds_demux *	xd,
 				 vbi_xds_class		xds_class,
 				 vbi_xds_subclass	xds_subclass)
 {
-	/* most recently received packet of this class. */
+	const vbi_xds_packet *xp;
+	unsigned int i;
+
+	assert (NULL != xd);
+
+	if ((unsigned int) xds_class > VBI_XDS_CLASS_MISC)
+		return NULL;
+
+	i = subclass_to_index (xds_subclass);
+	if (NO_SUBPACKET == i)
+		return NULL;
+
+	xp = &xd->last[xds_class][i];
+
+	/* Different subclasses may share a subpacket. */
+	if (0 == xp->buffer_size
+	    || xp->xds_subclass != xds_subclass)
+		return NULL;
+
+	return xp;
+}
+
+/**
+ * @internal
+ * @param xd XDS demultiplexer context allocated with vbi_xds_demux_new().
+ * @param enable @c TRUE to filter duplicates.
+ *
+ * XDS transmitters repeat packets like the program name, rating and
+ * time of day constantly. When this filter is enabled the XDS demux
+ * passes a packet to the callback or _vbi_xds_demux_cor() only if
+ * its contents differ from the last packet of the same class and
+ * subclass. Calling vbi_xds_demux_reset() forgets the last packets,
+ * so afterwards all packets will be passed once again.
+ *
+ * By default the filter is disabled.
+ */
+void
+_vbi_xds_demux_filter_duplicates
+				(vbi_xds_demux *	xd,
+				 vbi_bool		enable)
+{
+	assert (NULL != xd);
+
+	xd->filter_duplicates = !!enable;
 }
 
+#if 0 /* ideas */
 const vbi_xds_packet *
 vbi_xds_demux_cor		(vbi_xds_demux *	xd,
 				 const uint8_t		buffer[2])
@@ -1099,6 +1325,8 @@ _vbi_xds_demux_init		(vbi_xds_demux *	xd,
 	xd->callback = callback;
 	xd->user_data = user_data;
 
+	xd->filter_duplicates = FALSE;
+
 	return TRUE;
 }
 
@@ -227,8 +227,34 @@ struct _vbi_xds_demux {
 
 	vbi_xds_demux_cb *	callback;
 	void *			user_data;
+
+	/* Most recently received packet of each subpacket,
+	   0 == buffer_size if none. */
+	vbi_xds_packet		last[VBI_XDS_MAX_CLASSES]
+				    [VBI_XDS_MAX_SUBCLASSES];
+
+	/* Drop packets repeating the last packet. */
+	vbi_bool		filter_duplicates;
 };
 
+extern const vbi_xds_packet *
+_vbi_xds_demux_get_packet	(vbi_xds_demux *	xd,
+				 vbi_xds_class		xds_class,
+				 vbi_xds_subclass	xds_subclass)
+  _vbi_nonnull ((1));
+extern void
+_vbi_xds_demux_filter_duplicates
+				(vbi_xds_demux *	xd,
+				 vbi_bool		enable)
+  _vbi_nonnull ((1));
+extern vbi_bool
+_vbi_xds_demux_cor		(vbi_xds_demux *	xd,
+				 vbi_xds_packet *	packets,
+				 unsigned int *		n_packets,
+				 unsigned int		max_packets,
+				 const vbi_sliced *	sliced,
+				 unsigned int *		n_lines)
+  _vbi_nonnull ((1, 2, 3, 5, 6));
 extern void
 _vbi_xds_demux_destroy		(vbi_xds_demux *	xd);
 extern vbi_bool
@@ -0,0 +1,452 @@
+/*
+ *  cc608bench -- Multi-stream Closed Caption decoder benchmark
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+/* For libzvbi version 0.2.x. */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>		/* optarg */
+#include <assert.h>
+#include <sys/time.h>		/* gettimeofday() */
+#ifdef HAVE_GETOPT_LONG
+#  include <getopt.h>
+#endif
+
+#include "src/cc608_decoder.h"
+#include "src/hamm.h"
+
+#include "sliced.h"
+
+#undef _
+#define _(x) x /* i18n TODO */
+
+#define PROGRAM_NAME "cc608bench"
+
+enum mode {
+	MODE_SEPARATE,
+	MODE_BATCH,
+	MODE_MULTI
+};
+
+static unsigned long		option_n_streams;
+static unsigned long		option_n_frames;
+static unsigned long		option_n_loops;
+static unsigned long		option_chunk_frames;
+static enum mode		option_mode;
+
+/* Caption data of all streams in transmission order, two pairs
+   (field 1 and 2) per stream and frame. */
+static _vbi_cc608_pair *	pairs;
+
+/* The same data ordered by stream for MODE_BATCH. */
+static _vbi_cc608_pair *	stream_pairs;
+
+static unsigned long		n_events;
+
+/* A roll-up caption with the control codes transmitted twice, as
+   required by 47 CFR 15.119. */
+static unsigned int
+caption_byte_pair		(unsigned int		stream,
+				 unsigned long		frame)
+{
+	static const char text[] =
+		"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. "
+		"PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS.";
+	unsigned long i;
+
+	/* Streams start at different points. */
+	i = (frame + stream * 7) % 40;
+
+	switch (i) {
+	case 0:
+	case 1:
+		return 0x1426;		/* RU3 */
+
+	case 2:
+	case 3:
+		return 0x1470;		/* PAC row 15, indent 0 */
+
+	case 38:
+	case 39:
+		return 0x142D;		/* CR */
+
+	default:
+	{
+		unsigned long j;
+
+		j = ((frame + stream * 7) / 40 * 34 + (i - 4) * 2)
+			% (sizeof (text) - 2);
+
+		return (text[j] << 8) | text[j + 1];
+	}
+	}
+}
+
+static void
+generate_streams		(void)
+{
+	unsigned long n_pairs;
+	unsigned long frame;
+
+	n_pairs = option_n_frames * option_n_streams * 2;
+
+	pairs = malloc (n_pairs * sizeof (*pairs));
+	stream_pairs = malloc (n_pairs * sizeof (*stream_pairs));
+	if (NULL == pairs || NULL == stream_pairs)
+		no_mem_exit ();
+
+	for (frame = 0; frame < option_n_frames; ++frame) {
+		unsigned int stream;
+
+		for (stream = 0; stream < option_n_streams; ++stream) {
+			_vbi_cc608_pair *p;
+			unsigned int c;
+
+			p = &pairs[(frame * option_n_streams + stream) * 2];
+
+			c = caption_byte_pair (stream, frame);
+
+			p[0].stream = stream;
+			p[0].line = 21;
+			p[0].buffer[0] = vbi_par8 (c >> 8);
+			p[0].buffer[1] = vbi_par8 (c & 0xFF);
+			p[0].capture_time = frame / 30.0;
+			p[0].pts = -1;
+
+			/* Nothing on field 2. */
+			p[1] = p[0];
+			p[1].line = 284;
+			p[1].buffer[0] = 0x80;
+			p[1].buffer[1] = 0x80;
+
+			memcpy (&stream_pairs[(stream * option_n_frames
+					       + frame) * 2],
+				p, 2 * sizeof (*p));
+		}
+	}
+}
+
+static void
+event_handler			(vbi_event *		ev,
+				 void *			user_data)
+{
+	ev = ev; /* unused */
+	user_data = user_data;
+
+	++n_events;
+}
+
+static double
+timestamp			(void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, /* tz */ NULL);
+
+	return tv.tv_sec + tv.tv_usec * (1 / 1e6);
+}
+
+static void
+decode_separate			(_vbi_cc608_decoder **	decoders)
+{
+	const _vbi_cc608_pair *p;
+	const _vbi_cc608_pair *end;
+
+	end = pairs + option_n_frames * option_n_streams * 2;
+
+	for (p = pairs; p < end; ++p) {
+		_vbi_cc608_decoder_feed (decoders[p->stream],
+					 p->buffer, p->line,
+					 p->capture_time, p->pts);
+	}
+}
+
+static void
+decode_batch			(_vbi_cc608_decoder **	decoders)
+{
+	unsigned long frame;
+
+	for (frame = 0; frame < option_n_frames;
+	     frame += option_chunk_frames) {
+		unsigned long n_frames;
+		unsigned int stream;
+
+		n_frames = option_chunk_frames;
+		if (n_frames > option_n_frames - frame)
+			n_frames = option_n_frames - frame;
+
+		for (stream = 0; stream < option_n_streams; ++stream) {
+			_vbi_cc608_decoder_feed_batch
+				(decoders[stream],
+				 &stream_pairs[(stream * option_n_frames
+						+ frame) * 2],
+				 n_frames * 2);
+		}
+	}
+}
+
+static void
+decode_multi			(_vbi_cc608_multi_decoder *md)
+{
+	unsigned long frame;
+
+	for (frame = 0; frame < option_n_frames;
+	     frame += option_chunk_frames) {
+		unsigned long n_frames;
+
+		n_frames = option_chunk_frames;
+		if (n_frames > option_n_frames - frame)
+			n_frames = option_n_frames - frame;
+
+		_vbi_cc608_multi_decoder_feed
+			(md, &pairs[frame * option_n_streams * 2],
+			 n_frames * option_n_streams * 2);
+	}
+}
+
+static void
+benchmark			(void)
+{
+	static const char *mode_names[] = {
+		"separate", "batch", "multi"
+	};
+	_vbi_cc608_decoder **decoders;
+	_vbi_cc608_multi_decoder *md;
+	unsigned long loop;
+	unsigned int i;
+	double start_time;
+	double elapsed;
+
+	decoders = calloc (option_n_streams, sizeof (*decoders));
+	if (NULL == decoders)
+		no_mem_exit ();
+
+	md = NULL;
+
+	if (MODE_MULTI == option_mode) {
+		md = _vbi_cc608_multi_decoder_new (option_n_streams);
+		if (NULL == md)
+			no_mem_exit ();
+	}
+
+	for (i = 0; i < option_n_streams; ++i) {
+		if (NULL != md) {
+			decoders[i] = _vbi_cc608_multi_decoder_get (md, i);
+		} else {
+			decoders[i] = _vbi_cc608_decoder_new ();
+			if (NULL == decoders[i])
+				no_mem_exit ();
+		}
+
+		if (!_vbi_cc608_decoder_add_event_handler
+		    (decoders[i], _VBI_EVENT_CC608 | _VBI_EVENT_CC608_STREAM,
+		     event_handler, /* user_data */ NULL))
+			no_mem_exit ();
+	}
+
+	start_time = timestamp ();
+
+	for (loop = 0; loop < option_n_loops; ++loop) {
+		switch (option_mode) {
+		case MODE_SEPARATE:
+			decode_separate (decoders);
+			break;
+
+		case MODE_BATCH:
+			decode_batch (decoders);
+			break;
+
+		case MODE_MULTI:
+			decode_multi (md);
+			break;
+		}
+	}
+
+	elapsed = timestamp () - start_time;
+
+	printf ("%s: %lu streams x %lu frames x %lu, %lu events, "
+		"%.3f s, %.1f M pairs/s\n",
+		mode_names[option_mode], option_n_streams,
+		option_n_frames, option_n_loops, n_events, elapsed,
+		option_n_streams * option_n_frames * 2.0
+		* option_n_loops / (elapsed * 1e6));
+
+	if (NULL != md) {
+		_vbi_cc608_multi_decoder_delete (md);
+	} else {
+		for (i = 0; i < option_n_streams; ++i)
+			_vbi_cc608_decoder_delete (decoders[i]);
+	}
+
+	free (decoders);
+}
+
+static void
+usage				(FILE *			fp)
+{
+	fprintf (fp, _("\
+%s %s -- Multi-stream Closed Caption decoder benchmark\n\n\
+Copyright (C) 2026 the libzvbi contributors\n\
+This program is licensed under GPLv2 or later. NO WARRANTIES.\n\n\
+Usage: %s [options]\n\
+-h | --help | --usage             Print this message and exit\n\
+-V | --version                    Print the program version and exit\n\
+-B | --batch                      Feed each decoder the pairs of\n\
+                                  several frames at once\n\
+-c | --chunk-frames n             Number of frames fed at once\n\
+                                  with --batch or --multi (%lu)\n\
+-f | --frames n                   Length of the streams in frames (%lu)\n\
+-l | --loops n                    Decode the streams n times (%lu)\n\
+-M | --multi                      Use the multi-stream decoder\n\
+-s | --streams n                  Number of streams (%lu)\n\
+"),
+		 PROGRAM_NAME, VERSION, program_invocation_name,
+		 option_chunk_frames, option_n_frames, option_n_loops,
+		 option_n_streams);
+}
+
+static const char
+short_options [] = "Bc:f:hl:Ms:V";
+
+#ifdef HAVE_GETOPT_LONG
+static const struct option
+long_options [] = {
+	{ "batch",		no_argument,		NULL,	'B' },
+	{ "chunk-frames",	required_argument,	NULL,	'c' },
+	{ "frames",		required_argument,	NULL,	'f' },
+	{ "help",		no_argument,		NULL,	'h' },
+	{ "usage",		no_argument,		NULL,	'h' },
+	{ "loops",		required_argument,	NULL,	'l' },
+	{ "multi",		no_argument,		NULL,	'M' },
+	{ "streams",		required_argument,	NULL,	's' },
+	{ "version",		no_argument,		NULL,	'V' },
+	{ NULL, 0, 0, 0 }
+};
+#else
+#  define getopt_long(ac, av, s, l, i) getopt(ac, av, s)
+#endif
+
+static int			option_index;
+
+static unsigned long
+parse_option_count		(void)
+{
+	unsigned long value;
+
+	assert (NULL != optarg);
+
+	value = strtoul (optarg, NULL, 0);
+	if (0 == value || value > UINT_MAX)
+		error_exit (_("Invalid number %s."), optarg);
+
+	return value;
+}
+
+int
+main				(int			argc,
+				 char **		argv)
+{
+	init_helpers (argc, argv);
+
+	option_n_streams = 200;
+	option_n_frames = 30 * 60;
+	option_n_loops = 5;
+	option_chunk_frames = 30;
+	option_mode = MODE_SEPARATE;
+
+	for (;;) {
+		int c;
+
+		c = getopt_long (argc, argv, short_options,
+				 long_options, &option_index);
+		if (-1 == c)
+			break;
+
+		switch (c) {
+		case 0: /* getopt_long() flag */
+			break;
+
+		case 'B':
+			option_mode = MODE_BATCH;
+			break;
+
+		case 'c':
+			option_chunk_frames = parse_option_count ();
+			break;
+
+		case 'f':
+			option_n_frames = parse_option_count ();
+			break;
+
+		case 'h':
+			usage (stdout);
+			exit (EXIT_SUCCESS);
+
+		case 'l':
+			option_n_loops = parse_option_count ();
+			break;
+
+		case 'M':
+			option_mode = MODE_MULTI;
+			break;
+
+		case 's':
+			option_n_streams = parse_option_count ();
+			break;
+
+		case 'V':
+			printf (PROGRAM_NAME " " VERSION "\n");
+			exit (EXIT_SUCCESS);
+
+		default:
+			usage (stderr);
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	if (option_n_frames > UINT_MAX / 2 / option_n_streams
+	    || option_chunk_frames > UINT_MAX / 2 / option_n_streams)
+		error_exit (_("Too many streams or frames."));
+
+	generate_streams ();
+
+	benchmark ();
+
+	free (stream_pairs);
+	free (pairs);
+
+	exit (EXIT_SUCCESS);
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -0,0 +1,438 @@
+/*
+ *  dvbbench -- DVB VBI demultiplexer benchmark
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+/* For libzvbi version 0.2.x. */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>		/* optarg */
+#include <assert.h>
+#include <sys/time.h>		/* gettimeofday() */
+#ifdef HAVE_GETOPT_LONG
+#  include <getopt.h>
+#endif
+
+#include "src/dvb_demux.h"
+#include "src/dvb_mux.h"
+
+#include "sliced.h"
+
+#undef _
+#define _(x) x /* i18n TODO */
+
+#define PROGRAM_NAME "dvbbench"
+
+static const char *		option_in_file_name;
+static unsigned int		option_ts_pid;
+static unsigned long		option_n_frames;
+static unsigned long		option_n_loops;
+static unsigned long		option_chunk_size;
+static vbi_bool			option_multi_demux;
+
+/* The transport stream. */
+static uint8_t *		ts_buffer;
+static size_t			ts_size;
+static size_t			ts_capacity;
+
+static unsigned long		n_frames_out;
+
+static void
+ts_append			(const uint8_t *	data,
+				 size_t			size)
+{
+	if (ts_size + size > ts_capacity) {
+		size_t new_capacity;
+		uint8_t *new_buffer;
+
+		new_capacity = ts_capacity * 2;
+		if (new_capacity < ts_size + size)
+			new_capacity = ts_size + size;
+		new_buffer = realloc (ts_buffer, new_capacity);
+		if (NULL == new_buffer)
+			no_mem_exit ();
+
+		ts_buffer = new_buffer;
+		ts_capacity = new_capacity;
+	}
+
+	memcpy (ts_buffer + ts_size, data, size);
+	ts_size += size;
+}
+
+static vbi_bool
+mux_cb				(vbi_dvb_mux *		mx,
+				 void *			user_data,
+				 const uint8_t *	packet,
+				 unsigned int		packet_size)
+{
+	mx = mx; /* unused */
+	user_data = user_data;
+
+	ts_append (packet, packet_size);
+
+	return TRUE;
+}
+
+/* Simulates a 40 Mbit/s multiplex with one Teletext service. */
+static void
+generate_multiplex		(void)
+{
+	static const unsigned int mux_bytes_per_frame =
+		40000000 / 8 / 25 / 188 * 188;
+	vbi_dvb_mux *mx;
+	uint8_t filler[188];
+	unsigned int continuity[16];
+	unsigned long frame;
+
+	mx = vbi_dvb_ts_mux_new (option_ts_pid, mux_cb, /* user_data */ NULL);
+	if (NULL == mx)
+		no_mem_exit ();
+
+	memset (filler, 0xFF, sizeof (filler));
+	memset (continuity, 0, sizeof (continuity));
+
+	for (frame = 0; frame < option_n_frames; ++frame) {
+		vbi_sliced sliced[32];
+		size_t frame_start;
+		unsigned int i;
+
+		frame_start = ts_size;
+
+		for (i = 0; i < 32; ++i) {
+			unsigned int j;
+
+			sliced[i].id = VBI_SLICED_TELETEXT_B;
+			sliced[i].line = (i < 16) ? 7 + i : 313 + 7 + i - 16;
+			for (j = 0; j < 42; ++j)
+				sliced[i].data[j] = rand ();
+		}
+
+		if (!vbi_dvb_mux_feed (mx, sliced, 32,
+				       VBI_SLICED_TELETEXT_B,
+				       /* raw */ NULL, /* sp */ NULL,
+				       /* pts */ frame * 3600))
+			error_exit (_("Multiplexer failed."));
+
+		/* Packets of other services. */
+		while (ts_size - frame_start < mux_bytes_per_frame) {
+			unsigned int pid;
+
+			pid = (option_ts_pid + 1 + (ts_size / 188) % 16)
+				& 0x1FFF;
+
+			filler[0] = 0x47;
+			filler[1] = pid >> 8;
+			filler[2] = pid;
+			filler[3] = 0x10 | (continuity[pid & 15]++ & 15);
+
+			ts_append (filler, sizeof (filler));
+		}
+	}
+
+	vbi_dvb_mux_delete (mx);
+}
+
+static void
+read_file			(void)
+{
+	FILE *fp;
+
+	fp = fopen (option_in_file_name, "rb");
+	if (NULL == fp) {
+		error_exit (_("Cannot open '%s': %s."),
+			    option_in_file_name, strerror (errno));
+	}
+
+	for (;;) {
+		uint8_t buffer[65536];
+		size_t actual;
+
+		actual = fread (buffer, 1, sizeof (buffer), fp);
+		if (0 == actual)
+			break;
+
+		ts_append (buffer, actual);
+	}
+
+	if (ferror (fp))
+		read_error_exit (/* msg: errno */ NULL);
+
+	fclose (fp);
+}
+
+static vbi_bool
+demux_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	dx = dx; /* unused */
+	user_data = user_data;
+	sliced = sliced;
+	sliced_lines = sliced_lines;
+	pts = pts;
+
+	++n_frames_out;
+
+	return TRUE;
+}
+
+static vbi_bool
+multi_demux_cb			(_vbi_dvb_multi_demux *	mx,
+				 void *			user_data,
+				 unsigned int		pid,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	mx = mx; /* unused */
+	user_data = user_data;
+	pid = pid;
+	sliced = sliced;
+	sliced_lines = sliced_lines;
+	pts = pts;
+
+	++n_frames_out;
+
+	return TRUE;
+}
+
+static double
+timestamp			(void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, /* tz */ NULL);
+
+	return tv.tv_sec + tv.tv_usec * (1 / 1e6);
+}
+
+static void
+benchmark			(void)
+{
+	vbi_dvb_demux *dx;
+	_vbi_dvb_multi_demux *mdx;
+	unsigned long loop;
+	double start_time;
+	double elapsed;
+
+	dx = NULL;
+	mdx = NULL;
+
+	if (option_multi_demux) {
+		mdx = _vbi_dvb_multi_demux_new (multi_demux_cb,
+						/* user_data */ NULL);
+		if (NULL == mdx
+		    || !_vbi_dvb_multi_demux_add_pid (mdx, option_ts_pid))
+			no_mem_exit ();
+	} else {
+		dx = _vbi_dvb_ts_demux_new (demux_cb, /* user_data */ NULL,
+					    option_ts_pid);
+		if (NULL == dx)
+			no_mem_exit ();
+	}
+
+	start_time = timestamp ();
+
+	for (loop = 0; loop < option_n_loops; ++loop) {
+		size_t offset;
+
+		for (offset = 0; offset < ts_size;
+		     offset += option_chunk_size) {
+			unsigned int size;
+
+			size = option_chunk_size;
+			if (size > ts_size - offset)
+				size = ts_size - offset;
+
+			if (NULL != mdx) {
+				_vbi_dvb_multi_demux_feed
+					(mdx, ts_buffer + offset, size);
+			} else {
+				vbi_dvb_demux_feed
+					(dx, ts_buffer + offset, size);
+			}
+		}
+	}
+
+	elapsed = timestamp () - start_time;
+
+	printf ("%lu bytes x %lu, %lu frames, %.3f s, %.1f MB/s\n",
+		(unsigned long) ts_size, option_n_loops, n_frames_out,
+		elapsed, ts_size * (double) option_n_loops
+		/ (elapsed * 1e6));
+
+	_vbi_dvb_multi_demux_delete (mdx);
+	vbi_dvb_demux_delete (dx);
+}
+
+static void
+usage				(FILE *			fp)
+{
+	fprintf (fp, _("\
+%s %s -- DVB VBI demultiplexer benchmark\n\n\
+Copyright (C) 2026 the libzvbi contributors\n\
+This program is licensed under GPLv2 or later. NO WARRANTIES.\n\n\
+Usage: %s [options]\n\
+-h | --help | --usage             Print this message and exit\n\
+-V | --version                    Print the program version and exit\n\
+-c | --chunk-size n               Feed the demultiplexer n bytes\n\
+                                  at a time (%lu)\n\
+-f | --frames n                   Length of the simulated multiplex\n\
+                                  in frames (%lu)\n\
+-i | --input name                 Read a DVB TS recording from this\n\
+                                  file instead of simulating a\n\
+                                  40 Mbit/s multiplex\n\
+-l | --loops n                    Demultiplex the stream n times (%lu)\n\
+-M | --multi                      Use the multi-PID demultiplexer\n\
+-T | --ts pid                     PID of the VBI stream (0x%x)\n\
+"),
+		 PROGRAM_NAME, VERSION, program_invocation_name,
+		 option_chunk_size, option_n_frames, option_n_loops,
+		 option_ts_pid);
+}
+
+static const char
+short_options [] = "c:f:hi:l:MT:V";
+
+#ifdef HAVE_GETOPT_LONG
+static const struct option
+long_options [] = {
+	{ "chunk-size",		required_argument,	NULL,	'c' },
+	{ "frames",		required_argument,	NULL,	'f' },
+	{ "help",		no_argument,		NULL,	'h' },
+	{ "usage",		no_argument,		NULL,	'h' },
+	{ "input",		required_argument,	NULL,	'i' },
+	{ "loops",		required_argument,	NULL,	'l' },
+	{ "multi",		no_argument,		NULL,	'M' },
+	{ "ts",			required_argument,	NULL,	'T' },
+	{ "version",		no_argument,		NULL,	'V' },
+	{ NULL, 0, 0, 0 }
+};
+#else
+#  define getopt_long(ac, av, s, l, i) getopt(ac, av, s)
+#endif
+
+static int			option_index;
+
+static unsigned long
+parse_option_count		(void)
+{
+	unsigned long value;
+
+	assert (NULL != optarg);
+
+	value = strtoul (optarg, NULL, 0);
+	if (0 == value || value > UINT_MAX)
+		error_exit (_("Invalid number %s."), optarg);
+
+	return value;
+}
+
+int
+main				(int			argc,
+				 char **		argv)
+{
+	init_helpers (argc, argv);
+
+	option_ts_pid = 0x100;
+	option_n_frames = 250;
+	option_n_loops = 10;
+	option_chunk_size = 65536;
+
+	for (;;) {
+		int c;
+
+		c = getopt_long (argc, argv, short_options,
+				 long_options, &option_index);
+		if (-1 == c)
+			break;
+
+		switch (c) {
+		case 0: /* getopt_long() flag */
+			break;
+
+		case 'c':
+			option_chunk_size = parse_option_count ();
+			break;
+
+		case 'f':
+			option_n_frames = parse_option_count ();
+			break;
+
+		case 'h':
+			usage (stdout);
+			exit (EXIT_SUCCESS);
+
+		case 'i':
+			assert (NULL != optarg);
+			option_in_file_name = optarg;
+			break;
+
+		case 'l':
+			option_n_loops = parse_option_count ();
+			break;
+
+		case 'M':
+			option_multi_demux = TRUE;
+			break;
+
+		case 'T':
+			option_ts_pid = parse_option_ts ();
+			break;
+
+		case 'V':
+			printf (PROGRAM_NAME " " VERSION "\n");
+			exit (EXIT_SUCCESS);
+
+		default:
+			usage (stderr);
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	if (NULL != option_in_file_name)
+		read_file ();
+	else
+		generate_multiplex ();
+
+	benchmark ();
+
+	free (ts_buffer);
+
+	exit (EXIT_SUCCESS);
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
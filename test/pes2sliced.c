@@ -0,0 +1,223 @@
+/*
+ *  pes2sliced -- Parallel DVB PES/TS to sliced VBI converter
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+/* For libzvbi version 0.2.x. */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>		/* optarg */
+#include <assert.h>
+#ifdef HAVE_GETOPT_LONG
+#  include <getopt.h>
+#endif
+
+#include "src/dvb_demux.h"
+
+#include "sliced.h"
+
+#undef _
+#define _(x) x /* i18n TODO */
+
+#define PROGRAM_NAME "pes2sliced"
+
+static const char *		option_in_file_name;
+static unsigned int		option_in_ts_pid;
+static const char *		option_out_file_name;
+static unsigned long		option_n_threads;
+
+static struct stream *		wst;
+
+static vbi_bool
+demux_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	dx = dx; /* unused */
+	user_data = user_data;
+
+	if (pts < 0)
+		return TRUE;
+
+	write_stream_sliced (wst, sliced, sliced_lines,
+			     /* raw */ NULL,
+			     /* sp */ NULL,
+			     /* sample_time */ pts * (1 / 90000.0),
+			     /* stream_time */ pts);
+	return TRUE;
+}
+
+static void
+usage				(FILE *			fp)
+{
+	fprintf (fp, _("\
+%s %s -- Parallel DVB VBI stream converter\n\n\
+Copyright (C) 2026 the libzvbi contributors\n\
+This program is licensed under GPLv2 or later. NO WARRANTIES.\n\n\
+Usage: %s [options] -i PES or TS file > sliced VBI data\n\
+-h | --help | --usage             Print this message and exit\n\
+-q | --quiet                      Suppress progress and error messages\n\
+-v | --verbose                    Increase verbosity\n\
+-V | --version                    Print the program version and exit\n\
+Input options:\n\
+-i | --input name                 Read the VBI data from this file\n\
+-j | --threads n                  Demultiplex n parts of the file in\n\
+                                  parallel (number of CPUs)\n\
+-P | --pes                        Source is a DVB PES stream (default)\n\
+-T | --ts pid                     Source is a DVB TS stream\n\
+Output options:\n\
+-o | --output name                Write the VBI data to this file instead\n\
+                                  of standard output\n\
+"),
+		 PROGRAM_NAME, VERSION, program_invocation_name);
+}
+
+static const char
+short_options [] = "hi:j:o:qvPT:V";
+
+#ifdef HAVE_GETOPT_LONG
+static const struct option
+long_options [] = {
+	{ "help",		no_argument,		NULL,	'h' },
+	{ "usage",		no_argument,		NULL,	'h' },
+	{ "input",		required_argument,	NULL,	'i' },
+	{ "threads",		required_argument,	NULL,	'j' },
+	{ "output",		required_argument,	NULL,	'o' },
+	{ "quiet",		no_argument,		NULL,	'q' },
+	{ "verbose",		no_argument,		NULL,	'v' },
+	{ "pes",		no_argument,		NULL,	'P' },
+	{ "ts",			required_argument,	NULL,	'T' },
+	{ "version",		no_argument,		NULL,	'V' },
+	{ NULL, 0, 0, 0 }
+};
+#else
+#  define getopt_long(ac, av, s, l, i) getopt(ac, av, s)
+#endif
+
+static int			option_index;
+
+int
+main				(int			argc,
+				 char **		argv)
+{
+	init_helpers (argc, argv);
+
+	for (;;) {
+		int c;
+
+		c = getopt_long (argc, argv, short_options,
+				 long_options, &option_index);
+		if (-1 == c)
+			break;
+
+		switch (c) {
+		case 0: /* getopt_long() flag */
+			break;
+
+		case 'h':
+			usage (stdout);
+			exit (EXIT_SUCCESS);
+
+		case 'i':
+			assert (NULL != optarg);
+			option_in_file_name = optarg;
+			break;
+
+		case 'j':
+			assert (NULL != optarg);
+			option_n_threads = strtoul (optarg, NULL, 0);
+			if (option_n_threads > 256)
+				error_exit (_("Invalid number of threads."));
+			break;
+
+		case 'o':
+			assert (NULL != optarg);
+			option_out_file_name = optarg;
+			break;
+
+		case 'q':
+			parse_option_quiet ();
+			break;
+
+		case 'v':
+			parse_option_verbose ();
+			break;
+
+		case 'P':
+			option_in_ts_pid = 0;
+			break;
+
+		case 'T':
+			option_in_ts_pid = parse_option_ts ();
+			break;
+
+		case 'V':
+			printf (PROGRAM_NAME " " VERSION "\n");
+			exit (EXIT_SUCCESS);
+
+		default:
+			usage (stderr);
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	/* We need a file to map it into memory. */
+	if (NULL == option_in_file_name) {
+		usage (stderr);
+		exit (EXIT_FAILURE);
+	}
+
+	wst = write_stream_new (option_out_file_name,
+				FILE_FORMAT_SLICED,
+				/* ts_pid */ 0,
+				/* system */ 625);
+
+	if (!_vbi_dvb_demux_file (option_in_file_name,
+				  option_in_ts_pid,
+				  option_n_threads,
+				  demux_cb, /* user_data */ NULL)) {
+		error_exit (_("Cannot demultiplex '%s': %s."),
+			    option_in_file_name, strerror (errno));
+	}
+
+	stream_delete (wst);
+	wst = NULL;
+
+	error_msg (_("End of stream."));
+
+	exit (EXIT_SUCCESS);
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
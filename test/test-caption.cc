@@ -0,0 +1,212 @@
+/*
+ *  libzvbi -- Closed Caption decoder unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdio.h>		/* snprintf() */
+#include <string.h>
+#include <pthread.h>
+
+#include "src/libzvbi.h"
+
+#define N_ELEMENTS(array) (sizeof (array) / sizeof (*(array)))
+
+struct decoder {
+	vbi_decoder *		vbi;
+	double			time;
+
+	char			names[4][8];
+	unsigned int		n_network_events;
+	unsigned int		n_caption_events;
+
+	volatile int		stop;
+};
+
+static void
+decode_pair			(struct decoder *	d,
+				 unsigned int		line,
+				 unsigned int		c1,
+				 unsigned int		c2)
+{
+	vbi_sliced s;
+
+	memset (&s, 0, sizeof (s));
+
+	s.id = VBI_SLICED_CAPTION_525;
+	s.line = line;
+	s.data[0] = vbi_par8 (c1);
+	s.data[1] = vbi_par8 (c2);
+
+	vbi_decode (d->vbi, &s, 1, d->time);
+
+	d->time += 1 / 30.0;
+}
+
+/* Sends an XDS channel class network name packet on line 284. */
+static void
+decode_network_name		(struct decoder *	d,
+				 const char *		name)
+{
+	unsigned int sum;
+	unsigned int i;
+
+	decode_pair (d, 284, 0x05, 0x01);
+	sum = 0x05 + 0x01;
+
+	for (i = 0; name[i]; i += 2) {
+		decode_pair (d, 284, name[i], name[i + 1]);
+		sum += name[i] + name[i + 1];
+	}
+
+	sum += 0x0F;
+	decode_pair (d, 284, 0x0F, -sum & 0x7F);
+}
+
+static void
+event_handler			(vbi_event *		ev,
+				 void *			user_data)
+{
+	struct decoder *d = (struct decoder *) user_data;
+	vbi_page pg;
+
+	switch (ev->type) {
+	case VBI_EVENT_NETWORK:
+		assert (d->n_network_events < N_ELEMENTS (d->names));
+		snprintf (d->names[d->n_network_events++],
+			  sizeof (d->names[0]), "%s",
+			  (const char *) ev->ev.network.name);
+		break;
+
+	case VBI_EVENT_CAPTION:
+		++d->n_caption_events;
+		break;
+
+	default:
+		assert (0);
+	}
+
+	/* Handlers may fetch pages. */
+	assert (vbi_fetch_cc_page (d->vbi, &pg, 1, TRUE));
+	assert (1 == pg.pgno);
+}
+
+static void
+test_network_change		(void)
+{
+	struct decoder d;
+
+	memset (&d, 0, sizeof (d));
+
+	d.vbi = vbi_decoder_new ();
+	assert (NULL != d.vbi);
+
+	assert (vbi_event_handler_register (d.vbi, VBI_EVENT_NETWORK,
+					    event_handler, &d));
+
+	d.time = 1.0;
+
+	/* A name counts when repeated. The change from ABCD
+	   to WXYZ resets the caption decoder. */
+	decode_network_name (&d, "ABCD");
+	decode_network_name (&d, "ABCD");
+	decode_network_name (&d, "WXYZ");
+	decode_network_name (&d, "WXYZ");
+
+	assert (2 == d.n_network_events);
+	assert (0 == strcmp ("ABCD", d.names[0]));
+	assert (0 == strcmp ("WXYZ", d.names[1]));
+
+	vbi_decoder_delete (d.vbi);
+}
+
+static void *
+fetch_thread			(void *			user_data)
+{
+	struct decoder *d = (struct decoder *) user_data;
+
+	while (!d->stop) {
+		vbi_page pg;
+
+		assert (vbi_fetch_cc_page (d->vbi, &pg, 1, TRUE));
+		assert (1 == pg.pgno);
+		assert (15 == pg.rows);
+		assert (34 == pg.columns);
+	}
+
+	return NULL;
+}
+
+static void
+test_concurrent_fetch		(void)
+{
+	struct decoder d;
+	pthread_t thread;
+	unsigned int i;
+
+	memset (&d, 0, sizeof (d));
+
+	d.vbi = vbi_decoder_new ();
+	assert (NULL != d.vbi);
+
+	assert (vbi_event_handler_register (d.vbi, VBI_EVENT_CAPTION,
+					    event_handler, &d));
+
+	assert (0 == pthread_create (&thread, NULL, fetch_thread, &d));
+
+	d.time = 1.0;
+
+	for (i = 0; i < 2000; ++i) {
+		/* Roll-up caption CC1, a CR every few words. */
+		decode_pair (&d, 21, 0x14, 0x25);	/* RU2 */
+		decode_pair (&d, 21, 'A' + i % 26, 'b');
+		decode_pair (&d, 21, 'c', ' ');
+		if (0 == i % 4)
+			decode_pair (&d, 21, 0x14, 0x2D);	/* CR */
+	}
+
+	d.stop = 1;
+	assert (0 == pthread_join (thread, NULL));
+
+	assert (d.n_caption_events > 0);
+
+	vbi_decoder_delete (d.vbi);
+}
+
+int
+main				(void)
+{
+	test_network_change ();
+	test_concurrent_fetch ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
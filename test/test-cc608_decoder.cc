@@ -0,0 +1,557 @@
+/*
+ *  libzvbi -- Closed Caption decoder unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+#include "src/cc608_decoder.h"
+#include "src/hamm.h"		/* vbi_par8() */
+
+#define N_STREAMS 8
+#define N_PAIRS 3000
+
+/* A digest of the events a caption decoder sent. */
+struct event_log {
+	unsigned int		n_page_events;
+	unsigned int		n_stream_events;
+	uint32_t		hash;
+};
+
+struct stream {
+	_vbi_cc608_pair		pairs[N_PAIRS];
+
+	/* Results of _vbi_cc608_decoder_feed() for each pair. */
+	vbi_bool		success[N_PAIRS];
+
+	struct event_log	log;
+};
+
+static struct stream		streams[N_STREAMS];
+
+static void
+hash_add			(struct event_log *	log,
+				 int64_t		value)
+{
+	/* FNV-1a. */
+	log->hash = (log->hash ^ (uint32_t) value) * 16777619;
+	log->hash = (log->hash ^ (uint32_t)(value >> 32)) * 16777619;
+}
+
+static void
+event_handler			(vbi_event *		ev,
+				 void *			user_data)
+{
+	struct event_log *log = (struct event_log *) user_data;
+
+	hash_add (log, ev->type);
+
+	switch (ev->type) {
+	case _VBI_EVENT_CC608:
+	{
+		const struct _vbi_event_cc608_page *cp = ev->ev._cc608;
+
+		++log->n_page_events;
+
+		hash_add (log, (int64_t)(cp->capture_time * 1000));
+		hash_add (log, cp->pts);
+		hash_add (log, cp->channel);
+		hash_add (log, cp->mode);
+		hash_add (log, cp->flags);
+		break;
+	}
+
+	case _VBI_EVENT_CC608_STREAM:
+	{
+		const struct _vbi_event_cc608_stream *cs =
+			ev->ev._cc608_stream;
+		unsigned int i;
+
+		++log->n_stream_events;
+
+		hash_add (log, (int64_t)(cs->capture_time * 1000));
+		hash_add (log, cs->pts);
+		hash_add (log, cs->channel);
+		hash_add (log, cs->mode);
+
+		for (i = 0; i < N_ELEMENTS (cs->text); ++i) {
+			hash_add (log, cs->text[i].unicode);
+			hash_add (log, cs->text[i].foreground);
+			hash_add (log, cs->text[i].background);
+			hash_add (log, (cs->text[i].italic << 2)
+				  | (cs->text[i].underline << 1)
+				  | cs->text[i].flash);
+		}
+		break;
+	}
+
+	default:
+		assert (0);
+	}
+}
+
+static void
+add_event_handler		(_vbi_cc608_decoder *	cd,
+				 struct event_log *	log)
+{
+	memset (log, 0, sizeof (*log));
+	log->hash = 2166136261u;
+
+	assert (_vbi_cc608_decoder_add_event_handler
+		(cd, _VBI_EVENT_CC608 | _VBI_EVENT_CC608_STREAM,
+		 event_handler, log));
+}
+
+/* Random caption data on both fields with all kinds of control codes
+   on channel 1 and 2, XDS on field 2 and a few parity errors. */
+static void
+make_stream			(struct stream *	s,
+				 unsigned int		stream)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_PAIRS; ++i) {
+		_vbi_cc608_pair *p = &s->pairs[i];
+		unsigned int c1, c2;
+
+		p->stream = stream;
+		p->line = (i & 1) ? 284 : 21;
+		p->capture_time = (i / 2) / 30.0;
+		p->pts = -1;
+
+		switch (lrand48 () % 8) {
+		case 0:
+			/* Miscellaneous control codes,
+			   RCL ... EOC, TO1 ... TO3. */
+			c1 = 0x14 | (lrand48 () & 0x09);
+			c2 = 0x20 + lrand48 () % 0x10;
+			if (lrand48 () & 1)
+				c1 = 0x17 | (lrand48 () & 0x08);
+			break;
+
+		case 1:
+			/* Preamble address codes and mid-row codes. */
+			c1 = 0x10 + lrand48 () % 8 + (lrand48 () & 0x08);
+			c2 = 0x20 + lrand48 () % 0x60;
+			break;
+
+		case 2:
+			/* XDS or null. */
+			c1 = lrand48 () % 0x10;
+			c2 = 0x20 + lrand48 () % 0x60;
+			break;
+
+		default:
+			c1 = 0x20 + lrand48 () % 0x60;
+			c2 = 0x20 + lrand48 () % 0x60;
+			break;
+		}
+
+		p->buffer[0] = vbi_par8 (c1);
+		p->buffer[1] = vbi_par8 (c2);
+
+		/* Repeated control codes. */
+		if (i >= 2 && 0 == lrand48 () % 16)
+			memcpy (p->buffer, p[-2].buffer, 2);
+
+		if (0 == lrand48 () % 64)
+			p->buffer[lrand48 () & 1] ^= 1 << (lrand48 () % 8);
+	}
+}
+
+static void
+assert_same_pages		(_vbi_cc608_decoder *	cd1,
+				 _vbi_cc608_decoder *	cd2)
+{
+	vbi_pgno channel;
+
+	for (channel = VBI_CAPTION_CC1; channel <= VBI_CAPTION_T4;
+	     ++channel) {
+		vbi_page pg1, pg2;
+		unsigned int i;
+
+		assert (_vbi_cc608_decoder_get_page (cd1, &pg1, channel,
+						     /* padding */ FALSE));
+		assert (_vbi_cc608_decoder_get_page (cd2, &pg2, channel,
+						     /* padding */ FALSE));
+
+		assert (pg1.rows == pg2.rows);
+		assert (pg1.columns == pg2.columns);
+
+		for (i = 0; i < (unsigned int)(pg1.rows * pg1.columns); ++i) {
+			const vbi_char *ac1 = &pg1.text[i];
+			const vbi_char *ac2 = &pg2.text[i];
+
+			assert (ac1->unicode == ac2->unicode);
+			assert (ac1->foreground == ac2->foreground);
+			assert (ac1->background == ac2->background);
+			assert (ac1->opacity == ac2->opacity);
+			assert (ac1->italic == ac2->italic);
+			assert (ac1->underline == ac2->underline);
+			assert (ac1->flash == ac2->flash);
+		}
+	}
+}
+
+static void
+assert_same_log			(const struct event_log *log1,
+				 const struct event_log *log2)
+{
+	assert (log1->n_page_events == log2->n_page_events);
+	assert (log1->n_stream_events == log2->n_stream_events);
+	assert (log1->hash == log2->hash);
+}
+
+/* Decodes each stream with _vbi_cc608_decoder_feed(), the reference
+   for the other tests. */
+static _vbi_cc608_decoder *
+reference_decoders[N_STREAMS];
+
+static void
+make_reference			(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_STREAMS; ++i) {
+		struct stream *s = &streams[i];
+		_vbi_cc608_decoder *cd;
+		unsigned int j;
+
+		make_stream (s, i);
+
+		cd = _vbi_cc608_decoder_new ();
+		assert (NULL != cd);
+
+		add_event_handler (cd, &s->log);
+
+		for (j = 0; j < N_PAIRS; ++j) {
+			const _vbi_cc608_pair *p = &s->pairs[j];
+
+			s->success[j] = _vbi_cc608_decoder_feed
+				(cd, p->buffer, p->line,
+				 p->capture_time, p->pts);
+		}
+
+		/* The random data must exercise the decoder. */
+		assert (s->log.n_page_events > 0);
+		assert (s->log.n_stream_events > 0);
+
+		reference_decoders[i] = cd;
+	}
+}
+
+static vbi_bool
+all_successful			(const struct stream *	s,
+				 unsigned int		start,
+				 unsigned int		n_pairs)
+{
+	unsigned int i;
+
+	for (i = start; i < start + n_pairs; ++i) {
+		if (!s->success[i])
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void
+test_feed_batch			(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_STREAMS; ++i) {
+		const struct stream *s = &streams[i];
+		_vbi_cc608_decoder *cd;
+		struct event_log log;
+		unsigned int j;
+
+		cd = _vbi_cc608_decoder_new ();
+		assert (NULL != cd);
+
+		add_event_handler (cd, &log);
+
+		for (j = 0; j < N_PAIRS;) {
+			unsigned int n;
+
+			n = lrand48 () % 64;
+			if (n > N_PAIRS - j)
+				n = N_PAIRS - j;
+
+			assert (all_successful (s, j, n)
+				== _vbi_cc608_decoder_feed_batch
+				(cd, &s->pairs[j], n));
+
+			j += n;
+		}
+
+		assert_same_log (&s->log, &log);
+		assert_same_pages (reference_decoders[i], cd);
+
+		_vbi_cc608_decoder_delete (cd);
+	}
+}
+
+static void
+test_multi_decoder		(void)
+{
+	static _vbi_cc608_pair pairs[N_STREAMS * N_PAIRS];
+	static vbi_bool success[N_STREAMS * N_PAIRS];
+	struct event_log logs[N_STREAMS];
+	unsigned int next[N_STREAMS];
+	_vbi_cc608_multi_decoder *md;
+	_vbi_cc608_pair bad;
+	unsigned int n_pairs;
+	unsigned int i;
+
+	md = _vbi_cc608_multi_decoder_new (N_STREAMS);
+	assert (NULL != md);
+
+	assert (NULL == _vbi_cc608_multi_decoder_get (md, N_STREAMS));
+
+	for (i = 0; i < N_STREAMS; ++i) {
+		_vbi_cc608_decoder *cd;
+
+		cd = _vbi_cc608_multi_decoder_get (md, i);
+		assert (NULL != cd);
+
+		add_event_handler (cd, &logs[i]);
+	}
+
+	/* Interleave the streams in random order, keeping the order
+	   of the pairs of each stream. */
+	memset (next, 0, sizeof (next));
+
+	for (n_pairs = 0; n_pairs < N_ELEMENTS (pairs); ++n_pairs) {
+		unsigned int j;
+
+		do j = lrand48 () % N_STREAMS;
+		while (next[j] >= N_PAIRS);
+
+		pairs[n_pairs] = streams[j].pairs[next[j]];
+		success[n_pairs] = streams[j].success[next[j]];
+		++next[j];
+	}
+
+	for (i = 0; i < n_pairs;) {
+		vbi_bool expect;
+		unsigned int n;
+		unsigned int j;
+
+		n = lrand48 () % 256;
+		if (n > n_pairs - i)
+			n = n_pairs - i;
+
+		expect = TRUE;
+		for (j = i; j < i + n; ++j)
+			expect &= success[j];
+
+		assert (expect == _vbi_cc608_multi_decoder_feed
+			(md, &pairs[i], n));
+
+		i += n;
+	}
+
+	for (i = 0; i < N_STREAMS; ++i) {
+		assert_same_log (&streams[i].log, &logs[i]);
+		assert_same_pages (reference_decoders[i],
+				   _vbi_cc608_multi_decoder_get (md, i));
+	}
+
+	/* Invalid stream numbers fail but do not stop decoding. */
+	bad = streams[0].pairs[0];
+	bad.stream = N_STREAMS;
+
+	assert (!_vbi_cc608_multi_decoder_feed (md, &bad, 1));
+
+	for (i = 0; i < N_STREAMS; ++i)
+		assert_same_log (&streams[i].log, &logs[i]);
+
+	/* After a reset the decoders must be in the initial state. */
+	_vbi_cc608_multi_decoder_reset (md);
+
+	{
+		_vbi_cc608_decoder *cd;
+
+		cd = _vbi_cc608_decoder_new ();
+		assert (NULL != cd);
+
+		for (i = 0; i < N_STREAMS; ++i) {
+			assert_same_pages (cd, _vbi_cc608_multi_decoder_get
+					   (md, i));
+		}
+
+		_vbi_cc608_decoder_delete (cd);
+	}
+
+	_vbi_cc608_multi_decoder_delete (md);
+
+	/* Allowed. */
+	_vbi_cc608_multi_decoder_delete (NULL);
+
+	md = _vbi_cc608_multi_decoder_new (0);
+	assert (NULL != md);
+	assert (NULL == _vbi_cc608_multi_decoder_get (md, 0));
+	assert (!_vbi_cc608_multi_decoder_feed (md, &bad, 1));
+	_vbi_cc608_multi_decoder_delete (md);
+}
+
+struct window_test {
+	_vbi_cc608_decoder *	cd;
+	unsigned int		n_windows;
+};
+
+static vbi_bool
+same_text			(const vbi_char *	text1,
+				 const vbi_char *	text2)
+{
+	unsigned int i;
+
+	for (i = 0; i < 32; ++i) {
+		if (text1[i].unicode != text2[i].unicode
+		    || text1[i].opacity != text2[i].opacity
+		    || text1[i].italic != text2[i].italic)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* The roll-up window must consist of the rows of the page ending
+   with the row of the stream event. */
+static void
+window_event_handler		(vbi_event *		ev,
+				 void *			user_data)
+{
+	struct window_test *wt = (struct window_test *) user_data;
+	const struct _vbi_event_cc608_stream *cs;
+	vbi_char text[4][32];
+	vbi_page pg;
+	unsigned int n_rows;
+	unsigned int row;
+
+	assert (_VBI_EVENT_CC608_STREAM == ev->type);
+
+	cs = ev->ev._cc608_stream;
+
+	n_rows = _vbi_cc608_decoder_get_roll_up_window
+		(wt->cd, text, N_ELEMENTS (text), cs->channel);
+
+	if (_VBI_CC608_MODE_ROLL_UP != cs->mode) {
+		assert (0 == n_rows);
+		return;
+	}
+
+	assert (n_rows >= 1 && n_rows <= 4);
+	assert (same_text (text[n_rows - 1], cs->text));
+
+	assert (_vbi_cc608_decoder_get_page (wt->cd, &pg, cs->channel,
+					     /* padding */ FALSE));
+
+	for (row = n_rows - 1; row < (unsigned int) pg.rows; ++row) {
+		unsigned int i;
+
+		for (i = 0; i < n_rows; ++i) {
+			if (!same_text (text[i], pg.text + (row + 1
+							     - n_rows + i)
+					* pg.columns))
+				break;
+		}
+
+		if (i >= n_rows)
+			break;
+	}
+
+	assert (row < (unsigned int) pg.rows);
+
+	/* Only the bottom rows of a larger window. */
+	assert (1 == _vbi_cc608_decoder_get_roll_up_window
+		(wt->cd, text, 1, cs->channel));
+	assert (same_text (text[0], cs->text));
+
+	++wt->n_windows;
+}
+
+static void
+test_roll_up_window		(void)
+{
+	struct window_test wt;
+	vbi_char text[4][32];
+	unsigned int i;
+
+	memset (&wt, 0, sizeof (wt));
+
+	wt.cd = _vbi_cc608_decoder_new ();
+	assert (NULL != wt.cd);
+
+	assert (_vbi_cc608_decoder_add_event_handler
+		(wt.cd, _VBI_EVENT_CC608_STREAM,
+		 window_event_handler, &wt));
+
+	/* Not in roll-up mode yet. */
+	assert (0 == _vbi_cc608_decoder_get_roll_up_window
+		(wt.cd, text, N_ELEMENTS (text), VBI_CAPTION_CC1));
+
+	/* Invalid channel. */
+	assert (0 == _vbi_cc608_decoder_get_roll_up_window
+		(wt.cd, text, N_ELEMENTS (text), 0));
+
+	for (i = 0; i < N_STREAMS; ++i) {
+		_vbi_cc608_decoder_feed_batch (wt.cd, streams[i].pairs,
+					       N_PAIRS);
+	}
+
+	assert (wt.n_windows > 0);
+
+	_vbi_cc608_decoder_delete (wt.cd);
+}
+
+int
+main				(void)
+{
+	unsigned int i;
+
+	srand48 (0x608);
+
+	make_reference ();
+
+	test_feed_batch ();
+	test_multi_decoder ();
+	test_roll_up_window ();
+
+	for (i = 0; i < N_STREAMS; ++i)
+		_vbi_cc608_decoder_delete (reference_decoders[i]);
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
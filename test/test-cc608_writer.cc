@@ -0,0 +1,228 @@
+/*
+ *  libzvbi -- Closed Caption subtitle file writer unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>		/* memcpy() */
+
+#include "src/cc608_writer.h"
+#include "src/hamm.h"		/* vbi_par8() */
+
+struct out_buffer {
+	char			data[8192];
+	unsigned int		size;
+};
+
+static vbi_bool
+out_buffer_append		(_vbi_cc608_writer *	cw,
+				 void *			user_data,
+				 const char *		data,
+				 unsigned int		size)
+{
+	struct out_buffer *ob = (struct out_buffer *) user_data;
+
+	cw = cw; /* unused */
+
+	assert (ob->size + size < sizeof (ob->data));
+	memcpy (ob->data + ob->size, data, size);
+	ob->size += size;
+	ob->data[ob->size] = 0;
+
+	return TRUE;
+}
+
+/* Caption byte pairs on field 1, one every 100 ms. Control codes
+   have a high byte of 0x10 ... 0x17, 0x00 0x00 is a pause. */
+static const uint8_t
+stream[][2] = {
+	/* Pop-on caption of two rows, the second one in italics. */
+	{ 0x14, 0x20 },		/* RCL */
+	{ 0x14, 0x40 },		/* PAC row 14 */
+	{ 'H', 'e' }, { 'l', 'l' }, { 'o', 0x00 },
+	{ 0x14, 0x6E },		/* PAC row 15 italics */
+	{ 'A', '&' }, { 'B', ' ' }, { '<', 'x' }, { '>', 0x00 },
+	{ 0x14, 0x2F },		/* EOC, displays the caption */
+	{ 0x00, 0x00 }, { 0x00, 0x00 },
+	{ 0x14, 0x2C },		/* EDM, removes it */
+	{ 0x00, 0x00 },
+
+	/* Two row roll-up caption. */
+	{ 0x14, 0x25 },		/* RU2 */
+	{ 0x14, 0x60 },		/* PAC row 15 */
+	{ 'O', 'N' }, { 'E', 0x00 },
+	{ 0x14, 0x2D },		/* CR */
+	{ 'T', 'W' }, { 'O', 0x00 },
+	{ 0x14, 0x2D },		/* CR */
+	{ 'T', 'H' }, { 'R', 'E' }, { 'E', 0x00 },
+	{ 0x14, 0x2D },		/* CR */
+	{ 0x00, 0x00 },
+	{ 0x14, 0x2C },		/* EDM */
+	{ 0x00, 0x00 },
+};
+
+static void
+write_stream			(struct out_buffer *	ob,
+				 _vbi_cc608_writer_format format,
+				 const char *		lang)
+{
+	_vbi_cc608_decoder *cd;
+	_vbi_cc608_writer *cw;
+	unsigned int i;
+
+	cd = _vbi_cc608_decoder_new ();
+	assert (NULL != cd);
+
+	cw = _vbi_cc608_writer_new (cd, VBI_CAPTION_CC1, format,
+				    out_buffer_append, ob);
+	assert (NULL != cw);
+
+	assert (_vbi_cc608_writer_set_language (cw, lang));
+	assert (!_vbi_cc608_writer_set_language (cw, "en\" x=\""));
+
+	ob->size = 0;
+
+	for (i = 0; i < N_ELEMENTS (stream); ++i) {
+		uint8_t buffer[2];
+		int64_t pts;
+
+		buffer[0] = vbi_par8 (stream[i][0]);
+		buffer[1] = vbi_par8 (stream[i][1]);
+
+		pts = (i + 1) * 9000;
+
+		_vbi_cc608_decoder_feed (cd, buffer, /* line */ 21,
+					 /* capture_time */ 0, pts);
+
+		assert (_vbi_cc608_writer_sync (cw, 0, pts));
+	}
+
+	assert (_vbi_cc608_writer_finish (cw, 0, (i + 1) * 9000));
+
+	_vbi_cc608_writer_delete (cw);
+	_vbi_cc608_decoder_delete (cd);
+}
+
+static void
+test_srt			(void)
+{
+	static const char expect[] =
+		"1\n"
+		"00:00:01,100 --> 00:00:01,400\n"
+		"Hello\n"
+		"<i>A&B <x></i>\n"
+		"\n"
+		"2\n"
+		"00:00:01,800 --> 00:00:02,100\n"
+		"ONE\n"
+		"\n"
+		"3\n"
+		"00:00:02,100 --> 00:00:02,400\n"
+		"ONE\n"
+		"TWO\n"
+		"\n"
+		"4\n"
+		"00:00:02,400 --> 00:00:02,900\n"
+		"TWO\n"
+		"THREE\n"
+		"\n";
+	struct out_buffer ob;
+
+	write_stream (&ob, _VBI_CC608_WRITER_SRT, NULL);
+	assert (0 == strcmp (expect, ob.data));
+}
+
+static void
+test_webvtt			(void)
+{
+	static const char expect[] =
+		"WEBVTT\n"
+		"X-TIMESTAMP-MAP=MPEGTS:0,LOCAL:00:00:00.000\n"
+		"\n"
+		"00:00:01.100 --> 00:00:01.400\n"
+		"Hello\n"
+		"<i>A&amp;B &lt;x&gt;</i>\n"
+		"\n"
+		"00:00:01.800 --> 00:00:02.100\n"
+		"ONE\n"
+		"\n"
+		"00:00:02.100 --> 00:00:02.400\n"
+		"ONE\n"
+		"TWO\n"
+		"\n"
+		"00:00:02.400 --> 00:00:02.900\n"
+		"TWO\n"
+		"THREE\n"
+		"\n";
+	struct out_buffer ob;
+
+	write_stream (&ob, _VBI_CC608_WRITER_WEBVTT, NULL);
+	assert (0 == strcmp (expect, ob.data));
+}
+
+static void
+test_ttml			(void)
+{
+	static const char expect[] =
+		"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		"<tt xml:lang=\"en\" xmlns=\"http://www.w3.org/ns/ttml\" "
+		"xmlns:tts=\"http://www.w3.org/ns/ttml#styling\">\n"
+		"<body>\n"
+		"<div>\n"
+		"<p begin=\"00:00:01.100\" end=\"00:00:01.400\">"
+		"Hello<br/><span tts:fontStyle=\"italic\">"
+		"A&amp;B &lt;x&gt;</span></p>\n"
+		"<p begin=\"00:00:01.800\" end=\"00:00:02.100\">ONE</p>\n"
+		"<p begin=\"00:00:02.100\" end=\"00:00:02.400\">ONE<br/>TWO</p>\n"
+		"<p begin=\"00:00:02.400\" end=\"00:00:02.900\">TWO<br/>THREE</p>\n"
+		"</div>\n"
+		"</body>\n"
+		"</tt>\n";
+	struct out_buffer ob;
+
+	write_stream (&ob, _VBI_CC608_WRITER_TTML, "en");
+	assert (0 == strcmp (expect, ob.data));
+
+	/* The language is unknown by default. */
+	write_stream (&ob, _VBI_CC608_WRITER_TTML, NULL);
+	assert (NULL != strstr (ob.data, "<tt xml:lang=\"\" "));
+}
+
+int
+main				(void)
+{
+	test_srt ();
+	test_webvtt ();
+	test_ttml ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -28,8 +28,10 @@
 #endif
 
 #include <assert.h>
+#include <stdlib.h>		/* lrand48() */
 
 #include "src/dvb_demux.h"
+#include "src/dvb_mux.h"
 #include "test-common.h"
 
 /* TO DO */
@@ -85,12 +87,858 @@ test_silly_start_codes		(void)
 	vbi_dvb_demux_delete (dx);
 }
 
+struct ts_buffer {
+	uint8_t			data[188 * 200];
+	unsigned int		size;
+};
+
+static vbi_bool
+ts_buffer_append		(vbi_dvb_mux *		mx,
+				 void *			user_data,
+				 const uint8_t *	packet,
+				 unsigned int		packet_size)
+{
+	struct ts_buffer *tb = (struct ts_buffer *) user_data;
+
+	mx = mx; /* unused */
+
+	assert (tb->size + packet_size <= sizeof (tb->data));
+	memcpy (tb->data + tb->size, packet, packet_size);
+	tb->size += packet_size;
+
+	return TRUE;
+}
+
+struct multi_result {
+	unsigned int		n_frames[2];
+};
+
+static vbi_bool
+multi_demux_cb			(_vbi_dvb_multi_demux *	mx,
+				 void *			user_data,
+				 unsigned int		pid,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	struct multi_result *r = (struct multi_result *) user_data;
+	unsigned int n;
+
+	mx = mx; /* unused */
+
+	assert (0x100 == pid || 0x200 == pid);
+	n = (0x200 == pid);
+
+	assert (1 == sliced_lines);
+	assert (VBI_SLICED_TELETEXT_B == sliced[0].id);
+	assert (7 == sliced[0].line);
+	assert ((int64_t)(r->n_frames[n] * 3600) == pts);
+
+	/* PID, frame number. */
+	assert (pid >> 8 == sliced[0].data[0]);
+	assert (r->n_frames[n] == sliced[0].data[1]);
+
+	++r->n_frames[n];
+
+	return TRUE;
+}
+
+static void
+test_multi_demux		(unsigned int		chunk_size)
+{
+	static const unsigned int pids[3] = { 0x100, 0x200, 0x300 };
+	struct ts_buffer *tb;
+	struct multi_result r;
+	_vbi_dvb_multi_demux *mx;
+	vbi_dvb_mux *ts_mx[3];
+	unsigned int i, j;
+
+	tb = (struct ts_buffer *) xmalloc (sizeof (*tb));
+	tb->size = 0;
+
+	for (i = 0; i < 3; ++i) {
+		ts_mx[i] = vbi_dvb_ts_mux_new (pids[i],
+					       ts_buffer_append, tb);
+		assert (NULL != ts_mx[i]);
+	}
+
+	/* Interleave the PIDs frame by frame. */
+	for (j = 0; j < 10; ++j) {
+		for (i = 0; i < 3; ++i) {
+			vbi_sliced sliced;
+
+			memset (&sliced, 0, sizeof (sliced));
+			sliced.id = VBI_SLICED_TELETEXT_B;
+			sliced.line = 7;
+			sliced.data[0] = pids[i] >> 8;
+			sliced.data[1] = j;
+
+			assert (vbi_dvb_mux_feed (ts_mx[i], &sliced, 1,
+						  VBI_SLICED_TELETEXT_B,
+						  /* raw */ NULL,
+						  /* sp */ NULL,
+						  /* pts */ j * 3600));
+		}
+	}
+
+	/* Some junk to test resynchronization. */
+	memset (tb->data + tb->size, 0x55, 100);
+	tb->size += 100;
+
+	for (i = 0; i < 2; ++i) {
+		vbi_sliced sliced;
+
+		memset (&sliced, 0, sizeof (sliced));
+		sliced.id = VBI_SLICED_TELETEXT_B;
+		sliced.line = 7;
+
+		assert (vbi_dvb_mux_feed (ts_mx[i], &sliced, 1,
+					  VBI_SLICED_TELETEXT_B,
+					  NULL, NULL, 10 * 3600));
+	}
+
+	memset (&r, 0, sizeof (r));
+
+	mx = _vbi_dvb_multi_demux_new (multi_demux_cb, &r);
+	assert (NULL != mx);
+
+	assert (!_vbi_dvb_multi_demux_add_pid (mx, 0x0000));
+	assert (!_vbi_dvb_multi_demux_add_pid (mx, 0x1FFF));
+	assert (_vbi_dvb_multi_demux_add_pid (mx, 0x100));
+	assert (_vbi_dvb_multi_demux_add_pid (mx, 0x200));
+	assert (_vbi_dvb_multi_demux_add_pid (mx, 0x200));
+
+	for (i = 0; i < tb->size; i += chunk_size) {
+		unsigned int n = MIN (chunk_size, tb->size - i);
+
+		assert (_vbi_dvb_multi_demux_feed (mx, tb->data + i, n));
+	}
+
+	/* The last frame of each PID is lost in the junk. */
+	assert (9 == r.n_frames[0]);
+	assert (9 == r.n_frames[1]);
+
+	_vbi_dvb_multi_demux_delete (mx);
+
+	for (i = 0; i < 3; ++i)
+		vbi_dvb_mux_delete (ts_mx[i]);
+
+	free (tb);
+}
+
+static void
+test_cor_batch			(unsigned int		pid,
+				 unsigned int		max_frames,
+				 unsigned int		max_lines,
+				 unsigned int		chunk_size)
+{
+	_vbi_dvb_demux_frame frames[8];
+	vbi_sliced sliced[64 * 8];
+	struct ts_buffer *tb;
+	vbi_dvb_mux *mx;
+	vbi_dvb_demux *dx;
+	unsigned int n_frames;
+	unsigned int i;
+
+	assert (max_frames <= N_ELEMENTS (frames));
+	assert (max_lines <= N_ELEMENTS (sliced));
+
+	tb = (struct ts_buffer *) xmalloc (sizeof (*tb));
+	tb->size = 0;
+
+	if (0 == pid) {
+		mx = vbi_dvb_pes_mux_new (ts_buffer_append, tb);
+	} else {
+		/* XXX The TS demultiplexer discards a packet at the
+		   very start of the stream while acquiring sync, so
+		   we begin with a null packet. */
+		memset (tb->data, 0xFF, 188);
+		tb->data[0] = 0x47;
+		tb->data[1] = 0x1F;
+		tb->data[3] = 0x10;
+		tb->size = 188;
+
+		mx = vbi_dvb_ts_mux_new (pid, ts_buffer_append, tb);
+	}
+	assert (NULL != mx);
+
+	/* Frame j has j % 5 + 1 lines. */
+	for (i = 0; i < 30; ++i) {
+		vbi_sliced in[5];
+		unsigned int j;
+
+		memset (in, 0, sizeof (in));
+		for (j = 0; j <= i % 5; ++j) {
+			in[j].id = VBI_SLICED_TELETEXT_B;
+			in[j].line = 7 + j;
+			in[j].data[0] = i;
+			in[j].data[1] = j;
+		}
+
+		assert (vbi_dvb_mux_feed (mx, in, i % 5 + 1,
+					  VBI_SLICED_TELETEXT_B,
+					  /* raw */ NULL, /* sp */ NULL,
+					  /* pts */ i * 3600));
+	}
+
+	if (0 == pid)
+		dx = vbi_dvb_pes_demux_new (/* callback */ NULL,
+					    /* user_data */ NULL);
+	else
+		dx = _vbi_dvb_ts_demux_new (/* callback */ NULL,
+					    /* user_data */ NULL, pid);
+	assert (NULL != dx);
+
+	n_frames = 0;
+
+	for (i = 0; i < tb->size; i += chunk_size) {
+		const uint8_t *p = tb->data + i;
+		unsigned int p_left = MIN (chunk_size, tb->size - i);
+
+		while (p_left > 0) {
+			unsigned int n;
+			unsigned int j;
+
+			memset (frames, -1, sizeof (frames));
+
+			n = _vbi_dvb_demux_cor_batch (dx,
+						      frames, max_frames,
+						      sliced, max_lines,
+						      &p, &p_left);
+			assert (n <= max_frames);
+
+			for (j = 0; j < n; ++j) {
+				const vbi_sliced *s;
+				unsigned int k;
+
+				assert ((int64_t)(n_frames * 3600)
+					== frames[j].pts);
+				assert (n_frames % 5 + 1
+					== frames[j].n_lines);
+				assert (frames[j].first_line
+					+ frames[j].n_lines <= max_lines);
+
+				s = sliced + frames[j].first_line;
+				for (k = 0; k < frames[j].n_lines; ++k) {
+					assert (7 + k == s[k].line);
+					assert (n_frames == s[k].data[0]);
+					assert (k == s[k].data[1]);
+				}
+
+				++n_frames;
+			}
+		}
+	}
+
+	/* The last frame is still incomplete. */
+	assert (29 == n_frames);
+
+	vbi_dvb_demux_delete (dx);
+	vbi_dvb_mux_delete (mx);
+
+	free (tb);
+}
+
+struct raw_result {
+	vbi_dvb_demux *		dx;
+	vbi_sampling_par	sp;
+	unsigned int		n_frames;
+	const uint8_t *		prev_raw;
+	vbi_bool		double_buffer;
+};
+
+static void
+fill_raw_frame			(uint8_t *		raw,
+				 unsigned int		frame,
+				 const vbi_sampling_par *sp)
+{
+	unsigned int n_lines;
+	unsigned int i;
+
+	n_lines = sp->count[0] + sp->count[1];
+	memset (raw, 0, n_lines * 720);
+
+	/* Lines 10 and 330. */
+	for (i = 0; i < 720; ++i) {
+		raw[(10 - 7) * 720 + i] = frame + i;
+		raw[(17 + 330 - 320) * 720 + i] = frame * 3 + i;
+	}
+}
+
+static vbi_bool
+raw_demux_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	struct raw_result *r = (struct raw_result *) user_data;
+	uint8_t exp_raw[34 * 720];
+	const uint8_t *raw;
+
+	assert ((int64_t)(r->n_frames * 3600) == pts);
+
+	assert (2 == sliced_lines);
+	assert (VBI_SLICED_VBI_625 == sliced[0].id);
+	assert (10 == sliced[0].line);
+	assert (VBI_SLICED_VBI_625 == sliced[1].id);
+	assert (330 == sliced[1].line);
+
+	raw = _vbi_dvb_demux_get_raw (dx);
+	assert (NULL != raw);
+
+	fill_raw_frame (exp_raw, r->n_frames, &r->sp);
+	assert (0 == memcmp (raw, exp_raw, sizeof (exp_raw)));
+
+	if (r->double_buffer && r->n_frames > 0) {
+		/* The previous frame is still intact. */
+		assert (raw != r->prev_raw);
+		fill_raw_frame (exp_raw, r->n_frames - 1, &r->sp);
+		assert (0 == memcmp (r->prev_raw, exp_raw, sizeof (exp_raw)));
+	}
+
+	r->prev_raw = raw;
+	++r->n_frames;
+
+	return TRUE;
+}
+
+static void
+test_raw_buffers		(vbi_bool		double_buffer)
+{
+	struct raw_result r;
+	struct ts_buffer *tb;
+	vbi_dvb_mux *mx;
+	uint8_t *raw_in;
+	uint8_t *raw_out[2];
+	unsigned int i;
+
+	memset (&r, 0, sizeof (r));
+
+	r.sp.scanning = 625;
+	r.sp.sampling_format = VBI_PIXFMT_YUV420;
+	r.sp.sampling_rate = 13500000;
+	r.sp.bytes_per_line = 720;
+	r.sp.offset = 132;
+	r.sp.start[0] = 7;
+	r.sp.count[0] = 17;
+	r.sp.start[1] = 320;
+	r.sp.count[1] = 17;
+	r.sp.interlaced = FALSE;
+	r.sp.synchronous = TRUE;
+
+	r.double_buffer = double_buffer;
+
+	tb = (struct ts_buffer *) xmalloc (sizeof (*tb));
+	tb->size = 0;
+
+	mx = vbi_dvb_pes_mux_new (ts_buffer_append, tb);
+	assert (NULL != mx);
+
+	raw_in = (uint8_t *) xmalloc (34 * 720);
+
+	for (i = 0; i < 6; ++i) {
+		vbi_sliced sliced[2];
+
+		memset (sliced, 0, sizeof (sliced));
+		sliced[0].id = VBI_SLICED_VBI_625;
+		sliced[0].line = 10;
+		sliced[1].id = VBI_SLICED_VBI_625;
+		sliced[1].line = 330;
+
+		fill_raw_frame (raw_in, i, &r.sp);
+
+		assert (vbi_dvb_mux_feed (mx, sliced, 2,
+					  VBI_SLICED_VBI_625,
+					  raw_in, &r.sp,
+					  /* pts */ i * 3600));
+	}
+
+	r.dx = vbi_dvb_pes_demux_new (raw_demux_cb, &r);
+	assert (NULL != r.dx);
+
+	raw_out[0] = (uint8_t *) xralloc (34 * 720);
+	raw_out[1] = (uint8_t *) xralloc (34 * 720);
+
+	/* Invalid sampling parameters. */
+	r.sp.offset = 0;
+	assert (!_vbi_dvb_demux_set_raw_buffers (r.dx, raw_out[0],
+						 NULL, &r.sp));
+	r.sp.offset = 132;
+	r.sp.start[1] = 300;
+	assert (!_vbi_dvb_demux_set_raw_buffers (r.dx, raw_out[0],
+						 NULL, &r.sp));
+	r.sp.start[1] = 320;
+
+	assert (_vbi_dvb_demux_set_raw_buffers
+		(r.dx, raw_out[0],
+		 double_buffer ? raw_out[1] : NULL, &r.sp));
+
+	assert (vbi_dvb_demux_feed (r.dx, tb->data, tb->size));
+
+	/* The last frame is still incomplete. */
+	assert (5 == r.n_frames);
+
+	vbi_dvb_demux_delete (r.dx);
+	vbi_dvb_mux_delete (mx);
+
+	free (raw_out[1]);
+	free (raw_out[0]);
+	free (raw_in);
+	free (tb);
+}
+
+struct frame_log {
+	unsigned int		n_frames;
+	unsigned int		n_lines[64];
+	int64_t			pts[64];
+	unsigned int		checksum[64];
+};
+
+static void
+log_frame			(struct frame_log *	log,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	unsigned int sum;
+	unsigned int i;
+
+	assert (log->n_frames < N_ELEMENTS (log->n_lines));
+
+	sum = 0;
+	for (i = 0; i < sliced_lines; ++i) {
+		unsigned int j;
+
+		sum = sum * 31 + sliced[i].id + sliced[i].line;
+		for (j = 0; j < 42; ++j)
+			sum = sum * 31 + sliced[i].data[j];
+	}
+
+	log->n_lines[log->n_frames] = sliced_lines;
+	log->pts[log->n_frames] = pts;
+	log->checksum[log->n_frames] = sum;
+
+	++log->n_frames;
+}
+
+static vbi_bool
+log_frame_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	dx = dx; /* unused */
+
+	log_frame ((struct frame_log *) user_data,
+		   sliced, sliced_lines, pts);
+
+	return TRUE;
+}
+
+enum feed_mode {
+	/* All data in one call, TS payload is converted in place. */
+	FEED_ALL,
+
+	/* Less than one transport_packet per call, the demultiplexer
+	   copies all payload. */
+	FEED_SMALL_CHUNKS,
+
+	/* All data in one call, the coroutine returns after
+	   each frame. */
+	FEED_COR
+};
+
+static void
+demux_ts_log			(struct frame_log *	log,
+				 const struct ts_buffer *tb,
+				 enum feed_mode		mode)
+{
+	vbi_dvb_demux *dx;
+
+	memset (log, 0, sizeof (*log));
+
+	if (FEED_COR == mode) {
+		vbi_sliced sliced[64];
+		const uint8_t *p;
+		unsigned int p_left;
+
+		dx = _vbi_dvb_ts_demux_new (/* callback */ NULL,
+					    /* user_data */ NULL, 0x100);
+		assert (NULL != dx);
+
+		p = tb->data;
+		p_left = tb->size;
+
+		while (p_left > 0) {
+			unsigned int n_lines;
+			int64_t pts;
+
+			n_lines = vbi_dvb_demux_cor (dx, sliced,
+						     N_ELEMENTS (sliced),
+						     &pts, &p, &p_left);
+			if (n_lines > 0)
+				log_frame (log, sliced, n_lines, pts);
+		}
+	} else {
+		unsigned int i;
+
+		dx = _vbi_dvb_ts_demux_new (log_frame_cb, log, 0x100);
+		assert (NULL != dx);
+
+		for (i = 0; i < tb->size;) {
+			unsigned int n = tb->size - i;
+
+			if (FEED_SMALL_CHUNKS == mode)
+				n = MIN (n, 1 + (unsigned int) lrand48 () % 187);
+
+			assert (vbi_dvb_demux_feed (dx, tb->data + i, n));
+			i += n;
+		}
+	}
+
+	vbi_dvb_demux_delete (dx);
+}
+
+/* Demultiplexes tb in place and by copying, and returns the number
+   of frames, which must be the same. */
+static unsigned int
+demux_ts_compare		(const struct ts_buffer *tb)
+{
+	struct frame_log log[3];
+	unsigned int i;
+
+	demux_ts_log (&log[0], tb, FEED_ALL);
+	demux_ts_log (&log[1], tb, FEED_SMALL_CHUNKS);
+	demux_ts_log (&log[2], tb, FEED_COR);
+
+	for (i = 1; i < 3; ++i)
+		assert (0 == memcmp (&log[0], &log[i], sizeof (log[0])));
+
+	return log[0].n_frames;
+}
+
+/* Index of the transport_packet starting the PES packet of frame
+   frame_num, or of the packet n_packets after that. */
+static unsigned int
+ts_packet_index			(const struct ts_buffer *tb,
+				 unsigned int		frame_num,
+				 unsigned int		n_packets)
+{
+	unsigned int i;
+
+	for (i = 0; i < tb->size / 188; ++i) {
+		const uint8_t *p = tb->data + i * 188;
+
+		if (0x40 == (p[1] & 0x40) /* payload_unit_start */
+		    && 0x100 == ((p[1] * 256 + p[2]) & 0x1FFF)
+		    && 0 == frame_num--)
+			return i + n_packets;
+	}
+
+	assert (0);
+
+	return 0;
+}
+
+static void
+remove_ts_packet		(struct ts_buffer *	tb,
+				 unsigned int		index,
+				 vbi_bool		fix_continuity)
+{
+	unsigned int cc;
+	unsigned int i;
+
+	assert ((index + 1) * 188 <= tb->size);
+
+	memmove (tb->data + index * 188,
+		 tb->data + (index + 1) * 188,
+		 tb->size - (index + 1) * 188);
+	tb->size -= 188;
+
+	if (!fix_continuity)
+		return;
+
+	cc = 0;
+	for (i = 0; i < tb->size / 188; ++i) {
+		uint8_t *p = tb->data + i * 188;
+
+		if (0x100 == ((p[1] * 256 + p[2]) & 0x1FFF))
+			p[3] = (p[3] & 0xF0) | (cc++ & 0x0F);
+	}
+}
+
+static void
+make_ts_stream			(struct ts_buffer *	tb)
+{
+	vbi_dvb_mux *mx;
+	unsigned int i;
+
+	/* A null packet, see test_cor_batch(). */
+	memset (tb->data, 0xFF, 188);
+	tb->data[0] = 0x47;
+	tb->data[1] = 0x1F;
+	tb->data[3] = 0x10;
+	tb->size = 188;
+
+	mx = vbi_dvb_ts_mux_new (0x100, ts_buffer_append, tb);
+	assert (NULL != mx);
+
+	/* Frame i has i % 12 + 1 lines, one to four
+	   transport_packets. */
+	for (i = 0; i < 20; ++i) {
+		vbi_sliced in[12];
+		unsigned int j;
+
+		memset (in, 0, sizeof (in));
+		for (j = 0; j <= i % 12; ++j) {
+			in[j].id = VBI_SLICED_TELETEXT_B;
+			in[j].line = 7 + j;
+			in[j].data[0] = i;
+			in[j].data[1] = j;
+		}
+
+		assert (vbi_dvb_mux_feed (mx, in, i % 12 + 1,
+					  VBI_SLICED_TELETEXT_B,
+					  /* raw */ NULL, /* sp */ NULL,
+					  /* pts */ i * 3600));
+	}
+
+	vbi_dvb_mux_delete (mx);
+}
+
+static void
+test_ts_damage			(void)
+{
+	struct ts_buffer *tb;
+	struct ts_buffer *damaged;
+	unsigned int seed;
+
+	tb = (struct ts_buffer *) xmalloc (sizeof (*tb));
+	damaged = (struct ts_buffer *) xmalloc (sizeof (*damaged));
+
+	make_ts_stream (tb);
+
+	/* The last frame is still incomplete. */
+	assert (19 == demux_ts_compare (tb));
+
+	/* Frame 9 has 10 lines in three transport_packets. Losing
+	   the second one breaks continuity, so the PES packet is
+	   discarded, and so are the lines of frame 8 waiting for
+	   the end of the frame. */
+	*damaged = *tb;
+	remove_ts_packet (damaged, ts_packet_index (damaged, 9, 1),
+			  /* fix_continuity */ FALSE);
+	assert (17 == demux_ts_compare (damaged));
+
+	/* A truncated PES packet. The unexpected start of the PES
+	   packet of frame 10 also discards that one. */
+	*damaged = *tb;
+	remove_ts_packet (damaged, ts_packet_index (damaged, 9, 2),
+			  /* fix_continuity */ TRUE);
+	assert (16 == demux_ts_compare (damaged));
+
+	/* Random junk. */
+	for (seed = 0; seed < 200; ++seed) {
+		unsigned int n;
+
+		srand48 (seed);
+
+		*damaged = *tb;
+
+		for (n = 1 + lrand48 () % 8; n > 0; --n) {
+			unsigned int offset = lrand48 () % damaged->size;
+			unsigned int size = 1 + lrand48 () % 300;
+
+			size = MIN (size, damaged->size - offset);
+			if (lrand48 () & 1)
+				memset (damaged->data + offset, 0x47, size);
+			else
+				memset_rand (damaged->data + offset, size);
+		}
+
+		demux_ts_compare (damaged);
+	}
+
+	free (damaged);
+	free (tb);
+}
+
+struct stream_buffer {
+	uint8_t *		data;
+	size_t			size;
+	size_t			capacity;
+};
+
+static vbi_bool
+stream_buffer_append		(vbi_dvb_mux *		mx,
+				 void *			user_data,
+				 const uint8_t *	packet,
+				 unsigned int		packet_size)
+{
+	struct stream_buffer *sb = (struct stream_buffer *) user_data;
+
+	mx = mx; /* unused */
+
+	if (sb->size + packet_size > sb->capacity) {
+		sb->capacity = MAX (sb->capacity * 2, (size_t) 1 << 20);
+		sb->data = (uint8_t *) realloc (sb->data, sb->capacity);
+		assert (NULL != sb->data);
+	}
+
+	memcpy (sb->data + sb->size, packet, packet_size);
+	sb->size += packet_size;
+
+	return TRUE;
+}
+
+struct stream_log {
+	unsigned int		n_frames;
+	unsigned int		hash;
+	int64_t			last_pts;
+};
+
+static vbi_bool
+stream_log_cb			(vbi_dvb_demux *	dx,
+				 void *			user_data,
+				 const vbi_sliced *	sliced,
+				 unsigned int		sliced_lines,
+				 int64_t		pts)
+{
+	struct stream_log *log = (struct stream_log *) user_data;
+	unsigned int i;
+
+	dx = dx; /* unused */
+
+	/* In stream order. */
+	assert (pts == log->last_pts + 3600);
+	log->last_pts = pts;
+
+	log->hash = log->hash * 31 + sliced_lines;
+	for (i = 0; i < sliced_lines; ++i) {
+		unsigned int j;
+
+		log->hash = log->hash * 31 + sliced[i].line;
+		for (j = 0; j < 42; ++j)
+			log->hash = log->hash * 31 + sliced[i].data[j];
+	}
+
+	++log->n_frames;
+
+	return TRUE;
+}
+
+static void
+test_demux_buffer		(unsigned int		ts_pid)
+{
+	static const unsigned int n_threads[] = { 1, 2, 5 };
+	struct stream_buffer sb;
+	struct stream_log ref;
+	vbi_dvb_demux *dx;
+	vbi_dvb_mux *mx;
+	unsigned int n_frames;
+	unsigned int i;
+
+	memset (&sb, 0, sizeof (sb));
+
+	if (0 != ts_pid) {
+		uint8_t null_packet[188];
+
+		/* See test_cor_batch(). */
+		memset (null_packet, 0xFF, sizeof (null_packet));
+		null_packet[0] = 0x47;
+		null_packet[1] = 0x1F;
+		null_packet[3] = 0x10;
+		stream_buffer_append (NULL, &sb, null_packet, 188);
+
+		mx = vbi_dvb_ts_mux_new (ts_pid, stream_buffer_append, &sb);
+	} else {
+		mx = vbi_dvb_pes_mux_new (stream_buffer_append, &sb);
+	}
+	assert (NULL != mx);
+
+	/* Large enough for _vbi_dvb_demux_buffer() to split the
+	   stream into three chunks of eight MiB. */
+	for (n_frames = 0; sb.size < (20 << 20); ++n_frames) {
+		vbi_sliced sliced[16];
+		unsigned int n_lines = 1 + n_frames % 16;
+
+		memset (sliced, 0, sizeof (sliced));
+		for (i = 0; i < n_lines; ++i) {
+			sliced[i].id = VBI_SLICED_TELETEXT_B;
+			sliced[i].line = 7 + i;
+			sliced[i].data[0] = n_frames;
+			sliced[i].data[1] = n_frames >> 8;
+			sliced[i].data[2] = n_frames >> 16;
+			sliced[i].data[3] = i;
+		}
+
+		assert (vbi_dvb_mux_feed (mx, sliced, n_lines,
+					  VBI_SLICED_TELETEXT_B,
+					  /* raw */ NULL, /* sp */ NULL,
+					  /* pts */ 3600 + n_frames * 3600));
+	}
+
+	vbi_dvb_mux_delete (mx);
+
+	memset (&ref, 0, sizeof (ref));
+
+	if (0 != ts_pid)
+		dx = _vbi_dvb_ts_demux_new (stream_log_cb, &ref, ts_pid);
+	else
+		dx = vbi_dvb_pes_demux_new (stream_log_cb, &ref);
+	assert (NULL != dx);
+
+	assert (vbi_dvb_demux_feed (dx, sb.data, sb.size));
+
+	vbi_dvb_demux_delete (dx);
+
+	/* The last frame is still incomplete. */
+	assert (n_frames - 1 == ref.n_frames);
+
+	for (i = 0; i < N_ELEMENTS (n_threads); ++i) {
+		struct stream_log log;
+
+		memset (&log, 0, sizeof (log));
+
+		assert (_vbi_dvb_demux_buffer (sb.data, sb.size, ts_pid,
+					       n_threads[i],
+					       stream_log_cb, &log));
+
+		assert (ref.n_frames == log.n_frames);
+		assert (ref.hash == log.hash);
+	}
+
+	free (sb.data);
+}
+
 int
 main				(void)
 {
 	/* Regression for a bug fixed in 0.2.27. */
 	test_silly_start_codes ();
 
+	test_multi_demux (188 * 200);
+	test_multi_demux (188);
+	test_multi_demux (100);
+	test_multi_demux (1);
+
+	test_cor_batch (/* pid */ 0, 1, 64, 188 * 200);
+	test_cor_batch (/* pid */ 0, 8, 64 * 8, 188 * 200);
+	test_cor_batch (/* pid */ 0, 8, 64 * 8, 100);
+	test_cor_batch (/* pid */ 0x100, 8, 64 * 8, 188 * 200);
+	test_cor_batch (/* pid */ 0x100, 8, 64 * 3, 188 * 200);
+	test_cor_batch (/* pid */ 0x100, 3, 64 * 8, 1);
+
+	test_raw_buffers (/* double_buffer */ FALSE);
+	test_raw_buffers (/* double_buffer */ TRUE);
+
+	test_ts_damage ();
+
+	test_demux_buffer (/* ts_pid */ 0);
+	test_demux_buffer (/* ts_pid */ 0x100);
+
 	return 0;
 }
 
@@ -28,10 +28,13 @@
 #endif
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
 #include <errno.h>		/* XXX -> dvb_mux.h */
+#include <sys/time.h>		/* gettimeofday() */
+#include <sys/uio.h>
 
 #include "src/misc.h"
 #include "src/dvb.h"
@@ -1679,6 +1682,71 @@ test_multiplex_sliced_null_packet_checks (void)
 	free (sliced);
 }
 
+static double
+timestamp			(void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, /* tz */ NULL);
+
+	return tv.tv_sec + tv.tv_usec * (1 / 1e6);
+}
+
+static void
+test_multiplex_sliced_throughput (void)
+{
+	static const unsigned int n_frames = 20000;
+	uint8_t buffer[35 * 46];
+	vbi_sliced *sliced;
+	double start_time;
+	double elapsed;
+	unsigned int i;
+
+	// 16 Teletext lines per field, as many as EN 301 775 permits.
+	sliced = alloc_sliced (32);
+	for (i = 0; i < 32; ++i) {
+		sliced[i].id = VBI_SLICED_TELETEXT_B;
+		sliced[i].line = (i < 16) ? 7 + i : 320 + i - 16;
+		memset_rand (sliced[i].data, 42);
+	}
+
+	start_time = timestamp ();
+
+	for (i = 0; i < n_frames; ++i) {
+		const vbi_sliced *s;
+		unsigned int s_left;
+		uint8_t *p;
+		unsigned int p_left;
+		vbi_bool success;
+
+		p = buffer;
+		p_left = sizeof (buffer);
+
+		s = sliced;
+		s_left = 32;
+
+		success = vbi_dvb_multiplex_sliced (&p, &p_left,
+						    &s, &s_left,
+						    ALL_SERVICES,
+						    /* data_identifier */ 0x10,
+						    /* stuffing */ TRUE);
+		assert (TRUE == success);
+		assert (0 == s_left);
+		assert (0 == p_left);
+	}
+
+	elapsed = timestamp () - start_time;
+
+	assert_du_conversion_ok (buffer, sizeof (buffer),
+				 sliced, 32, ALL_SERVICES);
+
+	printf ("vbi_dvb_multiplex_sliced: %u frames, %.3f s, %.1f MB/s\n",
+		n_frames, elapsed,
+		n_frames * (double) sizeof (buffer) / (elapsed * 1e6));
+
+	free (sliced);
+}
+
 void
 test_multiplex_sliced		(void)
 {
@@ -1703,6 +1771,7 @@ test_multiplex_sliced		(void)
 	test_multiplex_sliced_unaligned_packet ();
 	test_multiplex_sliced_null_sliced ();
 	test_multiplex_sliced_stuffing ();
+	test_multiplex_sliced_throughput ();
 }
 
 /*
@@ -3060,6 +3129,84 @@ DVBPESMuxTest::test		(const vbi_bool 	exp_success,
 		vbi_dvb_mux_delete (mx);
 	}
 
+	if (NULL != _buffer && _buffer_size > 0) {
+		struct iovec iov[65504 / 184 * 2];
+		bool cmp = (NULL != _sliced && _sliced_lines > 0);
+		unsigned int pid;
+
+		// Verify that the iovec output gives the same result
+		// as the PES and TS coroutines.
+
+		for (pid = 0; pid <= 0x1234; pid += 0x1234) {
+			vbi_dvb_mux *mx;
+			unsigned int size;
+			int n_iov;
+			int i;
+
+			if (0 == pid) {
+				mx = vbi_dvb_pes_mux_new (/* callback */ NULL,
+							   /* user_data */ NULL);
+			} else {
+				mx = vbi_dvb_ts_mux_new (pid,
+							  /* callback */ NULL,
+							  /* user_data */ NULL);
+			}
+			assert (NULL != mx);
+
+			copy_props (mx);
+
+			n_iov = _vbi_dvb_mux_feed_iov (mx, iov,
+						       N_ELEMENTS (iov),
+						       _sliced, _sliced_lines,
+						       _service_mask,
+						       _raw, _sp,
+						       _pts);
+			if (!exp_success) {
+				assert (-1 == n_iov);
+				vbi_dvb_mux_delete (mx);
+				continue;
+			}
+
+			assert (n_iov > 0);
+
+			if (0 == pid) {
+				assert (1 == n_iov);
+			} else {
+				assert (0 == n_iov % 2);
+			}
+
+			size = 0;
+			for (i = 0; i < n_iov; ++i) {
+				const uint8_t *p = (const uint8_t *)
+					iov[i].iov_base;
+
+				if (cmp) {
+					const uint8_t *q;
+
+					q = (0 == pid) ? _buffer : ts_buffer;
+					assert (0 == memcmp (p, q + size,
+							     iov[i].iov_len));
+				}
+
+				size += iov[i].iov_len;
+			}
+
+			if (cmp) {
+				assert (size == ((0 == pid) ? pes_bytes_out
+						 : pes_bytes_out * 188 / 184));
+			}
+
+			// Too small iov array.
+			assert (-1 == _vbi_dvb_mux_feed_iov
+				(mx, iov, (0 == pid) ? 0 :
+				 get_max_pes_packet_size () / 184 * 2 - 1,
+				 _sliced, _sliced_lines,
+				 _service_mask, _raw, _sp, _pts));
+
+			vbi_dvb_mux_delete (mx);
+		}
+	}
+
 	free (ts_rand_buffer);
 	free (ts_buffer);
 	free (rand_buffer);
@@ -3860,6 +4007,109 @@ test_dvb_mux_new_pid_checks	(void)
 	assert (NULL == vbi_dvb_ts_mux_new (UINT_MAX, NULL, NULL)); 
 }
 
+struct cbr_state {
+	unsigned int		n_data_packets;
+	unsigned int		n_null_packets;
+	int64_t			pts;
+	int64_t			last_pcr;
+};
+
+static vbi_bool
+cbr_cb				(vbi_dvb_mux *		mx,
+				 void *			user_data,
+				 const uint8_t *	packet,
+				 unsigned int		packet_size)
+{
+	struct cbr_state *st = (struct cbr_state *) user_data;
+	unsigned int pid;
+	int64_t pcr;
+
+	assert (188 == packet_size);
+	assert (0x47 == packet[0]);
+
+	pid = (packet[1] & 0x1F) * 256 + packet[2];
+	if (0x1FFF == pid)
+		++st->n_null_packets;
+	else if (0x1234 == pid)
+		++st->n_data_packets;
+	else
+		assert (0);
+
+	// Scheduled before the PTS of the frame, in order.
+	pcr = _vbi_dvb_mux_get_pcr (mx);
+	assert (pcr >= 0);
+	assert (pcr <= st->pts * 300);
+	assert (pcr >= st->last_pcr);
+	st->last_pcr = pcr;
+
+	return TRUE;
+}
+
+static void
+test_dvb_mux_cbr_bit_rate	(unsigned int		bit_rate)
+{
+	static const unsigned int n_frames = 100;
+	struct cbr_state st;
+	vbi_dvb_mux *mx;
+	vbi_sliced *sliced;
+	unsigned int n_slots;
+	unsigned int i;
+
+	mx = vbi_dvb_ts_mux_new (/* pid */ 0x1234, cbr_cb, &st);
+	assert (NULL != mx);
+
+	assert (TRUE == _vbi_dvb_mux_set_ts_bit_rate (mx, bit_rate));
+	assert (-1 == _vbi_dvb_mux_get_pcr (mx));
+
+	// One PES header and ten data units in three TS packets.
+	sliced = alloc_sliced (10);
+	for (i = 0; i < 10; ++i) {
+		sliced[i].id = VBI_SLICED_TELETEXT_B;
+		sliced[i].line = 7 + i;
+	}
+
+	memset (&st, 0, sizeof (st));
+
+	for (i = 0; i < n_frames; ++i) {
+		st.pts = 1000000 + i * 3600;
+		assert (TRUE == vbi_dvb_mux_feed (mx, sliced, 10,
+						   ALL_SERVICES,
+						   /* raw */ NULL,
+						   /* sp */ NULL,
+						   st.pts));
+	}
+
+	assert (n_frames * 3 == st.n_data_packets);
+
+	n_slots = (uint64_t)(n_frames - 1) * 3600 * bit_rate
+		/ (90000 * 188 * 8);
+	if (n_slots >= n_frames * 3) {
+		assert (n_slots == st.n_data_packets + st.n_null_packets);
+	} else {
+		// Bit rate exceeded, only stuffing was dropped.
+		assert (0 == st.n_null_packets);
+	}
+
+	free (sliced);
+
+	vbi_dvb_mux_delete (mx);
+}
+
+static void
+test_dvb_mux_cbr		(void)
+{
+	vbi_dvb_mux *mx;
+
+	mx = vbi_dvb_pes_mux_new (/* callback */ NULL,
+				   /* user_data */ NULL);
+	assert (FALSE == _vbi_dvb_mux_set_ts_bit_rate (mx, 1000000));
+	vbi_dvb_mux_delete (mx);
+
+	test_dvb_mux_cbr_bit_rate (1000000);
+	test_dvb_mux_cbr_bit_rate (8000000);
+	test_dvb_mux_cbr_bit_rate (100000);
+}
+
 static void
 test_dvb_ts_mux_malloc		(void)
 {
@@ -3911,6 +4161,8 @@ test_dvb_mux			(void)
 	test_dvb_mux_cor_partial_reads_and_reset (/* pid */ 0);
 	test_dvb_mux_cor_partial_reads_and_reset (/* pid */ 0x1234);
 	test_dvb_mux_cor_pts ();
+
+	test_dvb_mux_cbr ();
 }
 
 int
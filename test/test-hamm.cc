@@ -131,6 +131,115 @@ test_rev			(void)
 	}
 }
 
+static void
+test_rev8_block			(void)
+{
+	uint8_t src[64 + 16];
+	uint8_t dst[64 + 16 + 1];
+	unsigned int offset;
+	unsigned int n;
+
+	for (n = 0; n < sizeof (src); ++n)
+		src[n] = mrand48 ();
+
+	for (offset = 0; offset < 16; ++offset) {
+		for (n = 0; n <= 64; ++n) {
+			unsigned int i;
+
+			memset (dst, 0xA5, sizeof (dst));
+			_vbi_rev8_block (dst + offset, src + offset, n);
+
+			for (i = 0; i < offset; ++i)
+				assert (0xA5 == dst[i]);
+			for (; i < offset + n; ++i)
+				assert (dst[i] == vbi_rev8 (src[i]));
+			assert (0xA5 == dst[i]);
+		}
+	}
+
+	/* In place. */
+	memcpy (dst, src, sizeof (src));
+	_vbi_rev8_block (dst + 3, dst + 3, 42);
+	for (n = 0; n < sizeof (src); ++n) {
+		if (n >= 3 && n < 3 + 42)
+			assert (dst[n] == vbi_rev8 (src[n]));
+		else
+			assert (dst[n] == src[n]);
+	}
+
+	/* All byte values in each lane of the sixteen byte blocks. */
+	{
+		uint8_t all[256 + 16];
+		uint8_t out[256 + 16];
+
+		for (offset = 0; offset < 16; ++offset) {
+			for (n = 0; n < 256; ++n)
+				all[offset + n] = n;
+
+			_vbi_rev8_block (out, all + offset, 256);
+
+			for (n = 0; n < 256; ++n)
+				assert (out[n] == vbi_rev8 (n));
+		}
+	}
+}
+
+static void
+test_unham8_block		(void)
+{
+	uint8_t src[64 + 16];
+	uint8_t dst[64 + 16 + 1];
+	unsigned int offset;
+	unsigned int n;
+
+	/* Correct and correctable bytes. */
+	for (n = 0; n < sizeof (src); ++n) {
+		src[n] = vbi_ham8 (mrand48 ());
+		if (mrand48 () & 1)
+			src[n] ^= 1 << (mrand48 () & 7);
+	}
+
+	for (offset = 0; offset < 16; ++offset) {
+		for (n = 0; n <= 64; ++n) {
+			unsigned int i;
+
+			memset (dst, 0xA5, sizeof (dst));
+			assert (_vbi_unham8_block (dst + offset,
+						   src + offset, n) >= 0);
+
+			for (i = 0; i < offset; ++i)
+				assert (0xA5 == dst[i]);
+			for (; i < offset + n; ++i)
+				assert (dst[i] == vbi_unham8 (src[i]));
+			assert (0xA5 == dst[i]);
+		}
+	}
+
+	/* An incorrectable error in any position. */
+	for (n = 1; n <= 64; ++n) {
+		unsigned int i;
+
+		for (i = 0; i < n; ++i) {
+			uint8_t c = src[i];
+
+			src[i] = vbi_ham8 (mrand48 ()) ^ 0x03;
+			assert (vbi_unham8 (src[i]) < 0);
+			assert (_vbi_unham8_block (dst, src, n) < 0);
+			src[i] = c;
+		}
+	}
+
+	/* In place. */
+	memcpy (dst, src, sizeof (src));
+	assert (_vbi_unham8_block (dst + 3, dst + 3, 42) >= 0);
+	for (n = 0; n < sizeof (src); ++n) {
+		if (n >= 3 && n < 3 + 42)
+			assert (dst[n] == vbi_unham8 (src[n]));
+		else
+			assert (dst[n] == src[n]);
+	}
+}
+
 static void
 test_par_unpar			(void)
 {
@@ -311,6 +420,10 @@ main				(int			argc,
 
 	test_rev ();
 
+	test_rev8_block ();
+
+	test_unham8_block ();
+
 	test_par_unpar ();
 
 	test_ham8_ham16_unham8_unham16 ();
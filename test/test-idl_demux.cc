@@ -0,0 +1,609 @@
+/*
+ *  libzvbi -- Teletext IDL demultiplexer unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+#include "src/misc.h"
+#include "src/idl_demux.h"
+#include "src/hamm.h"
+
+#define FT_HAVE_RI		(1 << 1)
+#define FT_HAVE_CI		(1 << 2)
+#define FT_HAVE_DL		(1 << 3)
+
+#define RI_PACKET_REPEATS	(1 << 7)
+
+/* Channel and service packet address of an IDL Format A service. */
+struct source {
+	unsigned int		channel;
+	unsigned int		address;
+
+	/* Sent to the demuxes. */
+	vbi_bool		requested;
+
+	unsigned int		ci;
+
+	/* Log of the data sent. */
+	unsigned int		n_sent;
+	uint32_t		sent_hash;
+};
+
+/* Log of the data received by one demux. */
+struct log {
+	unsigned int		n_packets;
+	uint32_t		hash;
+};
+
+static struct source
+sources[] = {
+	{ 0, 0, TRUE },
+	{ 0, 0x15, TRUE },
+	{ 0, 0x16, FALSE },
+	{ 5, 0x123456, TRUE },
+	{ 9, 7, TRUE },
+	{ 15, 0xFFFFFF, TRUE },
+	{ 12, 1, FALSE },
+};
+
+#define N_SOURCES N_ELEMENTS (sources)
+
+struct stream {
+	vbi_sliced		lines[4096];
+	unsigned int		n_lines;
+};
+
+/* Inverse of the CRC of two bytes, see add_crc(). */
+static uint16_t			crc_inv[65536];
+
+static uint32_t
+hash_data			(uint32_t		hash,
+				 unsigned int		flags,
+				 const uint8_t *	data,
+				 unsigned int		size)
+{
+	unsigned int i;
+
+	/* FNV-1a. */
+	hash = (hash ^ flags) * 16777619;
+	hash = (hash ^ size) * 16777619;
+
+	for (i = 0; i < size; ++i)
+		hash = (hash ^ data[i]) * 16777619;
+
+	return hash;
+}
+
+static vbi_bool
+log_cb				(vbi_idl_demux *	dx,
+				 const uint8_t *	buffer,
+				 unsigned int		n_bytes,
+				 unsigned int		flags,
+				 void *			user_data)
+{
+	struct log *log = (struct log *) user_data;
+
+	dx = dx; /* unused */
+
+	++log->n_packets;
+	log->hash = hash_data (log->hash, flags, buffer, n_bytes);
+
+	return TRUE;
+}
+
+/* EN 300 708 section 6.5.5, x16 + x9 + x7 + x4 + 1, one bit
+   at a time. */
+static unsigned int
+crc16				(unsigned int		crc,
+				 const uint8_t *	p,
+				 unsigned int		n)
+{
+	while (n-- > 0) {
+		unsigned int i;
+
+		crc ^= *p++;
+
+		for (i = 0; i < 8; ++i)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0x8940 : 0);
+	}
+
+	return crc;
+}
+
+static void
+init_crc_inv			(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < 65536; ++i) {
+		uint8_t buf[2] = { (uint8_t) i, (uint8_t)(i >> 8) };
+
+		crc_inv[crc16 (0, buf, 2)] = i;
+	}
+}
+
+/* Stores two bytes at p[n] so that the CRC of p[0 ... n + 1]
+   becomes crc. */
+static void
+add_crc				(uint8_t *		p,
+				 unsigned int		n,
+				 unsigned int		crc)
+{
+	unsigned int t;
+
+	/* The CRC of two bytes b from state s is the CRC of
+	   b ^ s from state 0. */
+	t = crc16 (0, p, n) ^ crc_inv[crc];
+
+	p[n] = t;
+	p[n + 1] = t >> 8;
+
+	assert (crc == crc16 (0, p, n + 2));
+}
+
+/* Random data byte. 0x00 and 0xFF may be followed by dummy bytes. */
+static unsigned int
+data_byte			(void)
+{
+	return 1 + lrand48 () % 254;
+}
+
+static vbi_sliced *
+next_line			(struct stream *	st)
+{
+	vbi_sliced *s;
+
+	assert (st->n_lines < N_ELEMENTS (st->lines));
+	s = &st->lines[st->n_lines++];
+
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_TELETEXT_B;
+	s->line = 7;
+
+	return s;
+}
+
+/* Adds a Format A packet of source s, and a repetition if
+   repeat is set. */
+static void
+send_packet			(struct stream *	st,
+				 struct source *	s,
+				 vbi_bool		repeat)
+{
+	uint8_t buf[42];
+	unsigned int ft;
+	unsigned int ial;
+	unsigned int spa_length;
+	unsigned int flags;
+	unsigned int dl;
+	unsigned int i;
+	unsigned int j;
+	unsigned int k;
+	unsigned int crc_start;
+
+	ft = (lrand48 () & (FT_HAVE_RI | FT_HAVE_CI | FT_HAVE_DL));
+	if (repeat)
+		ft |= FT_HAVE_RI;
+
+	for (spa_length = 0; spa_length < 6; ++spa_length) {
+		if (0 == (s->address >> (4 * spa_length)))
+			break;
+	}
+
+	spa_length += lrand48 () % (7 - spa_length);
+
+	flags = (mrand48 () & 1) ? VBI_IDL_DEPENDENT : 0;
+	ial = spa_length | flags;
+
+	buf[0] = vbi_ham8 (s->channel);
+	buf[1] = vbi_ham8 (15);
+	buf[2] = vbi_ham8 (ft);
+	buf[3] = vbi_ham8 (ial);
+
+	i = 0;
+	for (; i < spa_length; ++i)
+		buf[4 + i] = vbi_ham8 (s->address >> (4 * i));
+
+	if (ft & FT_HAVE_RI)
+		buf[4 + i++] = repeat ? RI_PACKET_REPEATS : 0;
+
+	crc_start = 4 + i;
+
+	if (ft & FT_HAVE_CI)
+		buf[4 + i++] = s->ci;
+
+	dl = 36 - i;
+
+	if (ft & FT_HAVE_DL) {
+		++i;
+		dl = lrand48 () % (36 - i + 1);
+		buf[4 + i - 1] = dl | (mrand48 () & 0xC0);
+	}
+
+	for (k = 0; 4 + i + k < 40; ++k)
+		buf[4 + i + k] = data_byte ();
+
+	if (ft & FT_HAVE_CI)
+		add_crc (buf + crc_start, 40 - crc_start, 0);
+	else
+		add_crc (buf + crc_start, 40 - crc_start,
+			 s->ci | (s->ci << 8));
+
+	if (s->requested) {
+		++s->n_sent;
+		s->sent_hash = hash_data (s->sent_hash, flags,
+					  buf + 4 + i, dl);
+	}
+
+	s->ci = (s->ci + 1) & 0xFF;
+
+	memcpy (next_line (st)->data, buf, sizeof (buf));
+
+	for (j = 1; repeat && j <= 2; ++j) {
+		/* Repetitions are discarded if the
+		   first packet was received. */
+		buf[crc_start - 1] = RI_PACKET_REPEATS | j;
+		memcpy (next_line (st)->data, buf, sizeof (buf));
+	}
+}
+
+static void
+make_stream			(struct stream *	st)
+{
+	unsigned int i;
+
+	st->n_lines = 0;
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		sources[i].ci = lrand48 () & 0xFF;
+		sources[i].n_sent = 0;
+		sources[i].sent_hash = 0;
+	}
+
+	while (st->n_lines < N_ELEMENTS (st->lines) - 3) {
+		vbi_sliced *s;
+
+		switch (lrand48 () % 8) {
+		case 0:
+			/* Other Teletext packets. */
+			s = next_line (st);
+			for (i = 0; i < 42; ++i)
+				s->data[i] = mrand48 ();
+			s->data[0] = vbi_ham8 (lrand48 ());
+			s->data[1] = vbi_ham8 (lrand48 () % 15);
+			break;
+
+		case 1:
+			/* Not Format A. */
+			s = next_line (st);
+			for (i = 0; i < 42; ++i)
+				s->data[i] = mrand48 ();
+			s->data[0] = vbi_ham8 (lrand48 ());
+			s->data[1] = vbi_ham8 (15);
+			s->data[2] = vbi_ham8 (lrand48 () | 1);
+			break;
+
+		default:
+			send_packet (st, &sources[lrand48 () % N_SOURCES],
+				     0 == (lrand48 () & 7));
+			break;
+		}
+	}
+}
+
+static void
+assert_same_state		(const vbi_idl_demux *	dx1,
+				 const vbi_idl_demux *	dx2)
+{
+	assert (dx1->ci == dx2->ci);
+	assert (dx1->ri == dx2->ri);
+	assert (dx1->flags == dx2->flags);
+}
+
+/* Compares _vbi_idl_multi_demux_feed_frame() against feeding each
+   demux separately. */
+static void
+test_multi_demux		(unsigned int		error_rate)
+{
+	static struct stream st;
+	vbi_idl_demux *single[N_SOURCES];
+	vbi_idl_demux *multi[N_SOURCES];
+	struct log single_log[N_SOURCES];
+	struct log multi_log[N_SOURCES];
+	_vbi_idl_multi_demux *md;
+	unsigned int n_errors;
+	unsigned int i;
+
+	make_stream (&st);
+
+	n_errors = 0;
+	for (i = 0; error_rate > 0 && i < st.n_lines; ++i) {
+		if (0 == lrand48 () % error_rate) {
+			/* More than Hamming 8/4 can correct. */
+			st.lines[i].data[lrand48 () % 42] = mrand48 ();
+			++n_errors;
+		}
+	}
+
+	md = _vbi_idl_multi_demux_new ();
+	assert (NULL != md);
+
+	memset (single_log, 0, sizeof (single_log));
+	memset (multi_log, 0, sizeof (multi_log));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		single[i] = NULL;
+		multi[i] = NULL;
+
+		if (!sources[i].requested)
+			continue;
+
+		single[i] = vbi_idl_a_demux_new (sources[i].channel,
+						 sources[i].address,
+						 log_cb, &single_log[i]);
+		assert (NULL != single[i]);
+
+		multi[i] = _vbi_idl_multi_demux_add (md, sources[i].channel,
+						     sources[i].address,
+						     log_cb, &multi_log[i]);
+		assert (NULL != multi[i]);
+	}
+
+	for (i = 0; i < st.n_lines; i += 16) {
+		unsigned int n_lines = MIN (16u, st.n_lines - i);
+		vbi_bool success1;
+		vbi_bool success2;
+		unsigned int j;
+
+		success1 = TRUE;
+
+		/* Only channels with a demux count. */
+		for (j = 0; j < N_SOURCES; ++j) {
+			unsigned int k;
+
+			if (NULL == single[j])
+				continue;
+
+			for (k = i; k < i + n_lines; ++k)
+				success1 &= vbi_idl_demux_feed
+					(single[j], st.lines[k].data);
+		}
+
+		success2 = _vbi_idl_multi_demux_feed_frame
+			(md, st.lines + i, n_lines);
+
+		assert (success1 == success2);
+
+		for (j = 0; j < N_SOURCES; ++j) {
+			if (NULL != single[j])
+				assert_same_state (single[j], multi[j]);
+		}
+	}
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (!sources[i].requested)
+			continue;
+
+		assert (single_log[i].n_packets == multi_log[i].n_packets);
+		assert (single_log[i].hash == multi_log[i].hash);
+
+		if (0 == n_errors) {
+			assert (sources[i].n_sent == multi_log[i].n_packets);
+			assert (sources[i].sent_hash == multi_log[i].hash);
+		}
+
+		vbi_idl_demux_delete (single[i]);
+	}
+
+	_vbi_idl_multi_demux_delete (md);
+}
+
+static void
+test_add_remove			(void)
+{
+	static struct stream st;
+	vbi_idl_demux *multi[N_SOURCES];
+	struct log log[N_SOURCES];
+	vbi_bool requested[N_SOURCES];
+	_vbi_idl_multi_demux *md;
+	unsigned int i;
+
+	md = _vbi_idl_multi_demux_new ();
+	assert (NULL != md);
+
+	memset (log, 0, sizeof (log));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		multi[i] = _vbi_idl_multi_demux_add (md, sources[i].channel,
+						     sources[i].address,
+						     log_cb, &log[i]);
+		assert (NULL != multi[i]);
+	}
+
+	/* Invalid or already added channel and address. */
+	assert (NULL == _vbi_idl_multi_demux_add (md, 16, 0,
+						  log_cb, NULL));
+	assert (NULL == _vbi_idl_multi_demux_add (md, 0, 1 << 24,
+						  log_cb, NULL));
+	assert (NULL == _vbi_idl_multi_demux_add (md, 0, 0x15,
+						  log_cb, NULL));
+
+	/* Removing one address of a channel keeps the others. */
+	_vbi_idl_multi_demux_remove (md, multi[1]);
+	multi[1] = NULL;
+
+	_vbi_idl_multi_demux_remove (md, NULL);
+
+	/* All sources except the removed one. */
+	for (i = 0; i < N_SOURCES; ++i) {
+		requested[i] = sources[i].requested;
+		sources[i].requested = (NULL != multi[i]);
+	}
+
+	make_stream (&st);
+
+	for (i = 0; i < N_SOURCES; ++i)
+		sources[i].requested = requested[i];
+
+	assert (_vbi_idl_multi_demux_feed_frame (md, st.lines, st.n_lines));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (NULL == multi[i]) {
+			assert (0 == log[i].n_packets);
+		} else {
+			assert (sources[i].n_sent == log[i].n_packets);
+			assert (sources[i].sent_hash == log[i].hash);
+		}
+	}
+
+	/* A reset forgets the continuity indicators. */
+	_vbi_idl_multi_demux_reset (md);
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (NULL != multi[i]) {
+			assert (-1 == multi[i]->ci);
+			assert (-1 == multi[i]->ri);
+		}
+	}
+
+	_vbi_idl_multi_demux_delete (md);
+}
+
+static void
+test_data_lost			(void)
+{
+	static struct stream st;
+	vbi_idl_demux *dx;
+	struct log log;
+	struct source *s;
+	unsigned int i;
+
+	s = &sources[3];
+
+	memset (&log, 0, sizeof (log));
+
+	dx = vbi_idl_a_demux_new (s->channel, s->address, log_cb, &log);
+	assert (NULL != dx);
+
+	st.n_lines = 0;
+	s->ci = 0x10;
+	for (i = 0; i < 4; ++i)
+		send_packet (&st, s, FALSE);
+
+	/* Packet 1 lost. */
+	st.lines[1] = st.lines[2];
+	st.lines[2] = st.lines[3];
+	st.n_lines = 3;
+
+	assert (vbi_idl_demux_feed_frame (dx, st.lines, 2));
+	assert (2 == log.n_packets);
+
+	/* Packet 2 corrupted. */
+	st.lines[2].data[41] ^= 0x01;
+	assert (!vbi_idl_demux_feed_frame (dx, st.lines + 2, 1));
+	assert (2 == log.n_packets);
+	assert (dx->flags & VBI_IDL_DATA_LOST);
+
+	vbi_idl_demux_delete (dx);
+}
+
+static void
+test_dummy_bytes		(void)
+{
+	uint8_t buf[42];
+	vbi_idl_demux *dx;
+	struct log log;
+	uint8_t expect[36];
+	unsigned int i;
+
+	memset (&log, 0, sizeof (log));
+
+	dx = vbi_idl_a_demux_new (1, 0, log_cb, &log);
+	assert (NULL != dx);
+
+	/* Explicit CI and DL, no address. */
+	buf[0] = vbi_ham8 (1);
+	buf[1] = vbi_ham8 (15);
+	buf[2] = vbi_ham8 (FT_HAVE_CI | FT_HAVE_DL);
+	buf[3] = vbi_ham8 (0);
+	buf[4] = 0x55; /* CI */
+	buf[5] = 12; /* DL */
+
+	/* A dummy byte follows eight 0x00 bytes. */
+	buf[6] = 'A';
+	memset (buf + 7, 0x00, 10);
+	buf[17] = 'B';
+
+	for (i = 18; i < 40; ++i)
+		buf[i] = data_byte ();
+
+	add_crc (buf + 4, 36, 0);
+
+	assert (vbi_idl_demux_feed (dx, buf));
+
+	expect[0] = 'A';
+	memset (expect + 1, 0x00, 9);
+	expect[10] = 'B';
+
+	assert (1 == log.n_packets);
+	assert (hash_data (0, 0, expect, 11) == log.hash);
+
+	vbi_idl_demux_delete (dx);
+}
+
+int
+main				(void)
+{
+	unsigned int i;
+
+	srand48 (0x1234);
+
+	init_crc_inv ();
+
+	test_dummy_bytes ();
+
+	test_data_lost ();
+
+	for (i = 0; i < 20; ++i)
+		test_multi_demux (/* error_rate */ 0);
+
+	for (i = 0; i < 100; ++i)
+		test_multi_demux (/* error_rate */ 20 + i);
+
+	test_add_remove ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
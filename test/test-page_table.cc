@@ -0,0 +1,248 @@
+/*
+ *  libzvbi -- Teletext page number table unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+#include "src/page_table.h"
+
+/* Reference implementation. We only add and remove subpages
+   0 ... 63, so the subpages above are either all in the table
+   or none. */
+struct model {
+	uint64_t		low[0x800];
+	vbi_bool		high[0x800];
+};
+
+static struct model		ma;
+static struct model		mb;
+
+static unsigned int
+random_pgno			(void)
+{
+	/* Mostly the first few pages to get some overlap. */
+	if (0 != (mrand48 () & 3))
+		return 0x100 + (mrand48 () & 0x3F);
+	else
+		return 0x100 + (mrand48 () & 0x7FF);
+}
+
+static void
+model_set_pages			(struct model *		m,
+				 vbi_pgno		first_pgno,
+				 vbi_pgno		last_pgno,
+				 vbi_bool		set)
+{
+	vbi_pgno pgno;
+
+	for (pgno = first_pgno; pgno <= last_pgno; ++pgno) {
+		m->low[pgno - 0x100] = set ? ~(uint64_t) 0 : 0;
+		m->high[pgno - 0x100] = set;
+	}
+}
+
+static void
+model_set_subpages		(struct model *		m,
+				 vbi_pgno		pgno,
+				 vbi_subno		first_subno,
+				 vbi_subno		last_subno,
+				 vbi_bool		set)
+{
+	vbi_subno subno;
+
+	for (subno = first_subno; subno <= last_subno; ++subno) {
+		if (set)
+			m->low[pgno - 0x100] |= (uint64_t) 1 << subno;
+		else
+			m->low[pgno - 0x100] &= ~((uint64_t) 1 << subno);
+	}
+}
+
+static void
+random_op			(vbi_page_table *	pt,
+				 struct model *		m)
+{
+	vbi_pgno first_pgno;
+	vbi_pgno last_pgno;
+	vbi_subno first_subno;
+	vbi_subno last_subno;
+	unsigned int r;
+
+	first_pgno = random_pgno ();
+	last_pgno = first_pgno + (mrand48 () & 63);
+	if (last_pgno > 0x8FF)
+		last_pgno = 0x8FF;
+
+	first_subno = mrand48 () & 63;
+	last_subno = first_subno + (mrand48 () & 7);
+	if (last_subno > 63)
+		last_subno = 63;
+
+	r = (unsigned int) mrand48 () % 100;
+
+	if (r < 10) {
+		assert (vbi_page_table_add_pages (pt, first_pgno, last_pgno));
+		model_set_pages (m, first_pgno, last_pgno, TRUE);
+	} else if (r < 20) {
+		assert (vbi_page_table_remove_pages (pt, first_pgno,
+						     last_pgno));
+		model_set_pages (m, first_pgno, last_pgno, FALSE);
+	} else if (r < 55) {
+		assert (vbi_page_table_add_subpages (pt, first_pgno,
+						     first_subno, last_subno));
+		model_set_subpages (m, first_pgno,
+				    first_subno, last_subno, TRUE);
+	} else if (r < 90) {
+		assert (vbi_page_table_remove_subpages (pt, first_pgno,
+							first_subno,
+							last_subno));
+		model_set_subpages (m, first_pgno,
+				    first_subno, last_subno, FALSE);
+	} else if (r < 92) {
+		vbi_page_table_remove_all_pages (pt);
+		memset (m, 0, sizeof (*m));
+	} else if (r < 94) {
+		vbi_pgno pgno;
+
+		vbi_page_table_add_all_displayable_pages (pt);
+		for (pgno = 0x100; pgno <= 0x899; ++pgno) {
+			if (vbi_is_bcd (pgno))
+				model_set_pages (m, pgno, pgno, TRUE);
+		}
+	} else {
+		assert (vbi_page_table_add_subpage (pt, first_pgno,
+						    VBI_ANY_SUBNO));
+		model_set_pages (m, first_pgno, first_pgno, TRUE);
+	}
+}
+
+static void
+assert_equal			(const vbi_page_table *	pt,
+				 const struct model *	m)
+{
+	vbi_pgno pgno;
+
+	for (pgno = 0x100; pgno <= 0x8FF; ++pgno) {
+		uint64_t low = m->low[pgno - 0x100];
+		vbi_bool high = m->high[pgno - 0x100];
+		vbi_subno subno;
+
+		assert ((0 != low || high)
+			== vbi_page_table_contains_page (pt, pgno));
+
+		if (vbi_page_table_contains_all_subpages (pt, pgno))
+			assert (~(uint64_t) 0 == low && high);
+
+		for (subno = 0; subno < 64; ++subno) {
+			assert ((int)((low >> subno) & 1)
+				== vbi_page_table_contains_subpage
+				(pt, pgno, subno));
+		}
+
+		assert (high == vbi_page_table_contains_subpage
+			(pt, pgno, 0x3F7E));
+	}
+
+	assert (!vbi_page_table_contains_page (pt, 0x0FF));
+	assert (!vbi_page_table_contains_page (pt, 0x900));
+}
+
+static void
+test_random			(vbi_bool		union_op)
+{
+	vbi_page_table *pta;
+	vbi_page_table *ptb;
+	unsigned int pgno;
+	unsigned int i;
+
+	pta = vbi_page_table_new ();
+	assert (NULL != pta);
+	ptb = vbi_page_table_new ();
+	assert (NULL != ptb);
+
+	memset (&ma, 0, sizeof (ma));
+	memset (&mb, 0, sizeof (mb));
+
+	for (i = (unsigned int) mrand48 () % 200; i > 0; --i)
+		random_op (pta, &ma);
+	for (i = (unsigned int) mrand48 () % 200; i > 0; --i)
+		random_op (ptb, &mb);
+
+	assert_equal (pta, &ma);
+	assert_equal (ptb, &mb);
+
+	if (union_op) {
+		assert (_vbi_page_table_union (pta, ptb));
+		for (pgno = 0; pgno < 0x800; ++pgno) {
+			ma.low[pgno] |= mb.low[pgno];
+			ma.high[pgno] |= mb.high[pgno];
+		}
+	} else {
+		assert (_vbi_page_table_intersection (pta, ptb));
+		for (pgno = 0; pgno < 0x800; ++pgno) {
+			ma.low[pgno] &= mb.low[pgno];
+			ma.high[pgno] &= mb.high[pgno];
+		}
+	}
+
+	assert_equal (pta, &ma);
+	assert_equal (ptb, &mb);
+
+	/* Does it still work? */
+	for (i = 50; i > 0; --i)
+		random_op (pta, &ma);
+
+	assert_equal (pta, &ma);
+
+	vbi_page_table_delete (ptb);
+	vbi_page_table_delete (pta);
+}
+
+int
+main				(int			argc,
+				 char **		argv)
+{
+	unsigned int i;
+
+	argc = argc; /* unused */
+	argv = argv;
+
+	for (i = 0; i < 100; ++i) {
+		test_random (/* union_op */ TRUE);
+		test_random (/* union_op */ FALSE);
+	}
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -0,0 +1,486 @@
+/*
+ *  libzvbi -- Teletext PFC demultiplexer unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+#include "src/misc.h"
+#include "src/pfc_demux.h"
+#include "src/hamm.h"
+
+#define BLOCK_SEPARATOR 0x0C
+
+/* Page and stream of a PFC data source. */
+struct source {
+	vbi_pgno		pgno;
+	unsigned int		stream;
+
+	/* Sent to the demuxes. */
+	vbi_bool		requested;
+
+	/* Separators, structure headers and data of all blocks,
+	   Hamming 8/4 encoded where required. */
+	uint8_t			data[16384];
+	unsigned int		size;
+	unsigned int		pos;
+
+	/* Offset of the next block separator. */
+	unsigned int		next_block[64];
+	unsigned int		n_blocks;
+	unsigned int		block_index;
+
+	unsigned int		ci;
+
+	/* Log of the blocks sent. */
+	unsigned int		n_sent;
+	uint32_t		sent_hash;
+};
+
+/* Log of the blocks received by one demux. */
+struct log {
+	unsigned int		n_blocks;
+	uint32_t		hash;
+};
+
+static struct source
+sources[] = {
+	{ 0x1DF, 0, TRUE },
+	{ 0x1DF, 1, TRUE },
+	{ 0x1DF, 2, FALSE },
+	{ 0x8FF, 3, TRUE },
+	{ 0x330, 15, TRUE },
+	{ 0x331, 0, TRUE },
+	{ 0x100, 0, FALSE },
+};
+
+#define N_SOURCES N_ELEMENTS (sources)
+
+struct stream {
+	vbi_sliced		lines[8192];
+	unsigned int		n_lines;
+};
+
+static uint32_t
+hash_block			(uint32_t		hash,
+				 unsigned int		application_id,
+				 const uint8_t *	data,
+				 unsigned int		size)
+{
+	unsigned int i;
+
+	/* FNV-1a. */
+	hash = (hash ^ application_id) * 16777619;
+	hash = (hash ^ size) * 16777619;
+
+	for (i = 0; i < size; ++i)
+		hash = (hash ^ data[i]) * 16777619;
+
+	return hash;
+}
+
+static vbi_bool
+log_cb				(vbi_pfc_demux *	dx,
+				 void *			user_data,
+				 const vbi_pfc_block *	block)
+{
+	struct log *log = (struct log *) user_data;
+
+	assert (block->pgno == dx->block.pgno);
+	assert (block->stream == dx->block.stream);
+
+	++log->n_blocks;
+	log->hash = hash_block (log->hash, block->application_id,
+				block->block, block->block_size);
+
+	return TRUE;
+}
+
+static void
+ham16p				(uint8_t *		p,
+				 unsigned int		c)
+{
+	p[0] = vbi_ham8 (c & 15);
+	p[1] = vbi_ham8 ((c >> 4) & 15);
+}
+
+/* Encodes random blocks for all sources. */
+static void
+make_blocks			(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		struct source *s = &sources[i];
+
+		s->size = 0;
+		s->pos = 0;
+		s->n_blocks = 0;
+		s->block_index = 0;
+		s->ci = mrand48 () & 15;
+		s->n_sent = 0;
+		s->sent_hash = 0;
+
+		for (;;) {
+			uint8_t block[2047];
+			unsigned int application_id;
+			unsigned int size;
+			unsigned int sh;
+			unsigned int j;
+
+			if (0 == (mrand48 () & 7))
+				size = 1 + (lrand48 () % N_ELEMENTS (block));
+			else
+				size = 1 + (lrand48 () % 100);
+
+			if (s->size + 5 + size > sizeof (s->data)
+			    || s->n_blocks >= N_ELEMENTS (s->next_block))
+				break;
+
+			application_id = lrand48 () & 0x1F;
+			for (j = 0; j < size; ++j)
+				block[j] = mrand48 ();
+
+			s->next_block[s->n_blocks++] = s->size;
+
+			s->data[s->size++] = vbi_ham8 (BLOCK_SEPARATOR);
+			sh = application_id | (size << 5);
+			ham16p (s->data + s->size, sh & 0xFF);
+			ham16p (s->data + s->size + 2, sh >> 8);
+			s->size += 4;
+
+			memcpy (s->data + s->size, block, size);
+			s->size += size;
+
+			++s->n_sent;
+			s->sent_hash = hash_block (s->sent_hash,
+						   application_id,
+						   block, size);
+		}
+	}
+}
+
+static vbi_sliced *
+next_line			(struct stream *	st,
+				 unsigned int		magazine,
+				 unsigned int		packet)
+{
+	vbi_sliced *s;
+
+	assert (st->n_lines < N_ELEMENTS (st->lines));
+	s = &st->lines[st->n_lines++];
+
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_TELETEXT_B;
+	s->line = 7;
+	ham16p (s->data, (magazine & 7) | (packet << 3));
+
+	return s;
+}
+
+/* Adds the page header and packets of one page transmission. */
+static void
+send_page			(struct stream *	st,
+				 struct source *	s)
+{
+	vbi_sliced *l;
+	unsigned int n_packets;
+	unsigned int subno;
+	unsigned int i;
+
+	n_packets = 1 + lrand48 () % 25;
+
+	subno = (s->ci
+		 | ((n_packets & 7) << 4)
+		 | (s->stream << 8)
+		 | ((n_packets >> 3) << 12));
+	s->ci = (s->ci + 1) & 15;
+
+	l = next_line (st, s->pgno >> 8, 0);
+	ham16p (l->data + 2, s->pgno & 0xFF);
+	ham16p (l->data + 4, subno & 0xFF);
+	ham16p (l->data + 6, subno >> 8);
+
+	for (i = 1; i <= n_packets; ++i) {
+		unsigned int start = s->pos;
+		unsigned int bp = 13; /* no block starts */
+		unsigned int col;
+
+		if (0 == (mrand48 () & 15)) {
+			/* Stuffing. */
+			next_line (st, s->pgno >> 8, 26 + (lrand48 () % 6));
+		}
+
+		l = next_line (st, s->pgno >> 8, i);
+
+		for (col = 3; col < 42; ++col) {
+			if (s->pos < s->size)
+				l->data[col] = s->data[s->pos++];
+			else
+				l->data[col] = vbi_ham8 (0x03); /* filler */
+		}
+
+		/* Pointer to the first block separator. */
+		while (s->block_index < s->n_blocks
+		       && s->next_block[s->block_index] < start + 39) {
+			unsigned int offset;
+
+			offset = s->next_block[s->block_index++] - start;
+			if (13 == bp && 0 == offset % 3)
+				bp = offset / 3;
+		}
+
+		l->data[2] = vbi_ham8 (bp);
+	}
+}
+
+static void
+make_stream			(struct stream *	st)
+{
+	make_blocks ();
+
+	st->n_lines = 0;
+
+	for (;;) {
+		struct source *s;
+		unsigned int n_left;
+		unsigned int i;
+
+		n_left = 0;
+		for (i = 0; i < N_SOURCES; ++i)
+			n_left += (sources[i].pos < sources[i].size);
+
+		if (0 == n_left)
+			break;
+
+		/* Mostly pages with data left, sometimes padding. */
+		s = &sources[lrand48 () % N_SOURCES];
+		if (s->pos >= s->size && 0 != (mrand48 () & 7))
+			continue;
+
+		send_page (st, s);
+	}
+}
+
+static void
+assert_same_state		(const vbi_pfc_demux *	dx1,
+				 const vbi_pfc_demux *	dx2)
+{
+	assert (dx1->ci == dx2->ci);
+	assert (dx1->packet == dx2->packet);
+	assert (dx1->n_packets == dx2->n_packets);
+	assert (dx1->bi == dx2->bi);
+	assert (dx1->left == dx2->left);
+	assert (dx1->block.application_id == dx2->block.application_id);
+	assert (0 == memcmp (dx1->block.block, dx2->block.block, dx1->bi));
+}
+
+/* Compares _vbi_pfc_multi_demux_feed_frame() against feeding each
+   demux separately. */
+static void
+test_multi_demux		(unsigned int		error_rate)
+{
+	static struct stream st;
+	vbi_pfc_demux *single[N_SOURCES];
+	vbi_pfc_demux *multi[N_SOURCES];
+	struct log single_log[N_SOURCES];
+	struct log multi_log[N_SOURCES];
+	_vbi_pfc_multi_demux *md;
+	unsigned int n_errors;
+	unsigned int i;
+
+	make_stream (&st);
+
+	n_errors = 0;
+	for (i = 0; error_rate > 0 && i < st.n_lines; ++i) {
+		if (0 == lrand48 () % error_rate) {
+			/* More than Hamming 8/4 can correct. */
+			st.lines[i].data[lrand48 () % 42] = mrand48 ();
+			++n_errors;
+		}
+	}
+
+	md = _vbi_pfc_multi_demux_new ();
+	assert (NULL != md);
+
+	memset (single_log, 0, sizeof (single_log));
+	memset (multi_log, 0, sizeof (multi_log));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		single[i] = NULL;
+		multi[i] = NULL;
+
+		if (!sources[i].requested)
+			continue;
+
+		single[i] = vbi_pfc_demux_new (sources[i].pgno,
+					       sources[i].stream,
+					       log_cb, &single_log[i]);
+		assert (NULL != single[i]);
+
+		multi[i] = _vbi_pfc_multi_demux_add (md, sources[i].pgno,
+						     sources[i].stream,
+						     log_cb, &multi_log[i]);
+		assert (NULL != multi[i]);
+	}
+
+	for (i = 0; i < st.n_lines; i += 16) {
+		unsigned int n_lines = MIN (16u, st.n_lines - i);
+		vbi_bool success1;
+		vbi_bool success2;
+		unsigned int j;
+
+		success1 = TRUE;
+
+		for (j = 0; j < N_SOURCES; ++j) {
+			unsigned int k;
+
+			if (NULL == single[j])
+				continue;
+
+			for (k = i; k < i + n_lines; ++k)
+				success1 &= vbi_pfc_demux_feed
+					(single[j], st.lines[k].data);
+		}
+
+		success2 = _vbi_pfc_multi_demux_feed_frame
+			(md, st.lines + i, n_lines);
+
+		assert (success1 == success2);
+
+		for (j = 0; j < N_SOURCES; ++j) {
+			if (NULL != single[j])
+				assert_same_state (single[j], multi[j]);
+		}
+	}
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (!sources[i].requested)
+			continue;
+
+		assert (single_log[i].n_blocks == multi_log[i].n_blocks);
+		assert (single_log[i].hash == multi_log[i].hash);
+
+		if (0 == n_errors) {
+			assert (sources[i].n_sent == multi_log[i].n_blocks);
+			assert (sources[i].sent_hash == multi_log[i].hash);
+		}
+
+		vbi_pfc_demux_delete (single[i]);
+	}
+
+	_vbi_pfc_multi_demux_delete (md);
+}
+
+static void
+test_add_remove			(void)
+{
+	static struct stream st;
+	vbi_pfc_demux *multi[N_SOURCES];
+	struct log log[N_SOURCES];
+	_vbi_pfc_multi_demux *md;
+	unsigned int i;
+
+	md = _vbi_pfc_multi_demux_new ();
+	assert (NULL != md);
+
+	memset (log, 0, sizeof (log));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		multi[i] = _vbi_pfc_multi_demux_add (md, sources[i].pgno,
+						     sources[i].stream,
+						     log_cb, &log[i]);
+		assert (NULL != multi[i]);
+	}
+
+	/* Invalid or already added page and stream. */
+	assert (NULL == _vbi_pfc_multi_demux_add (md, 0x0FF, 0,
+						  log_cb, NULL));
+	assert (NULL == _vbi_pfc_multi_demux_add (md, 0x900, 0,
+						  log_cb, NULL));
+	assert (NULL == _vbi_pfc_multi_demux_add (md, 0x1DF, 16,
+						  log_cb, NULL));
+	assert (NULL == _vbi_pfc_multi_demux_add (md, 0x1DF, 1,
+						  log_cb, NULL));
+
+	/* Removing one stream of a page keeps the others. */
+	_vbi_pfc_multi_demux_remove (md, multi[1]);
+	multi[1] = NULL;
+
+	_vbi_pfc_multi_demux_remove (md, NULL);
+
+	make_stream (&st);
+
+	assert (_vbi_pfc_multi_demux_feed_frame (md, st.lines, st.n_lines));
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (NULL == multi[i]) {
+			assert (0 == log[i].n_blocks);
+		} else {
+			assert (sources[i].n_sent == log[i].n_blocks);
+			assert (sources[i].sent_hash == log[i].hash);
+		}
+	}
+
+	/* A reset discards partial blocks. */
+	_vbi_pfc_multi_demux_reset (md);
+
+	for (i = 0; i < N_SOURCES; ++i) {
+		if (NULL != multi[i]) {
+			assert (0 == multi[i]->n_packets);
+			assert (0 == multi[i]->left);
+		}
+	}
+
+	_vbi_pfc_multi_demux_delete (md);
+}
+
+int
+main				(void)
+{
+	unsigned int i;
+
+	srand48 (0x1234);
+
+	for (i = 0; i < 20; ++i)
+		test_multi_demux (/* error_rate */ 0);
+
+	for (i = 0; i < 100; ++i)
+		test_multi_demux (/* error_rate */ 20 + i);
+
+	test_add_remove ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -0,0 +1,495 @@
+/*
+ *  libzvbi -- Sliced VBI filter unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+#include "src/misc.h"
+#include "src/sliced_filter.h"
+#include "src/cc608_decoder.h"	/* VBI_CAPTION_CC1 */
+#include "src/hamm.h"
+
+/* The filtered lines of the last frame. */
+struct capture {
+	vbi_sliced		lines[32];
+	unsigned int		n_lines;
+	unsigned int		n_frames;
+};
+
+static vbi_bool
+capture_cb			(vbi_sliced_filter *	sf,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines,
+				 void *			user_data)
+{
+	struct capture *c = (struct capture *) user_data;
+
+	sf = sf; /* unused */
+
+	assert (n_lines <= N_ELEMENTS (c->lines));
+
+	memcpy (c->lines, sliced, n_lines * sizeof (*sliced));
+	c->n_lines = n_lines;
+	++c->n_frames;
+
+	return TRUE;
+}
+
+static void
+cc_line				(vbi_sliced *		s,
+				 unsigned int		line,
+				 int			c1,
+				 int			c2)
+{
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_CAPTION_525;
+	s->line = line;
+	s->data[0] = vbi_par8 (c1);
+	s->data[1] = vbi_par8 (c2);
+}
+
+static void
+ttx_line			(vbi_sliced *		s,
+				 unsigned int		magazine,
+				 unsigned int		packet,
+				 vbi_pgno		page,
+				 unsigned int		flags)
+{
+	unsigned int i;
+
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_TELETEXT_B;
+	s->line = 7;
+
+	s->data[0] = vbi_ham8 ((magazine & 7) | ((packet & 1) << 3));
+	s->data[1] = vbi_ham8 (packet >> 1);
+
+	for (i = 2; i < 42; ++i)
+		s->data[i] = vbi_par8 ('0' + i % 10);
+
+	if (0 != packet)
+		return;
+
+	s->data[2] = vbi_ham8 (page & 15);
+	s->data[3] = vbi_ham8 ((page >> 4) & 15);
+
+	for (i = 0; i < 6; ++i)
+		s->data[4 + i] = vbi_ham8 (flags >> (i * 4));
+}
+
+/* Feeds n_lines as one frame and checks which lines the filter
+   passed through. */
+static void
+assert_filter			(vbi_sliced_filter *	sf,
+				 struct capture *	c,
+				 const vbi_sliced *	sliced,
+				 unsigned int		n_lines,
+				 const char *		expect)
+{
+	unsigned int n;
+	unsigned int i;
+	unsigned int j;
+
+	assert (strlen (expect) == n_lines);
+
+	n = n_lines;
+	assert (vbi_sliced_filter_feed (sf, sliced, &n));
+	assert (n_lines == n);
+
+	j = 0;
+	for (i = 0; i < n_lines; ++i) {
+		if ('1' != expect[i])
+			continue;
+
+		assert (j < c->n_lines);
+		assert (0 == memcmp (&c->lines[j], &sliced[i],
+				     sizeof (*sliced)));
+		++j;
+	}
+
+	assert (j == c->n_lines);
+}
+
+static void
+test_caption_channels		(void)
+{
+	vbi_sliced_filter *sf;
+	struct capture c;
+	vbi_sliced s[11];
+
+	cc_line (&s[0], 21, 0x14, 0x20);	/* RCL CC1 */
+	cc_line (&s[1], 21, 'A', 'B');
+	cc_line (&s[2], 21, 0x1C, 0x20);	/* RCL CC2 */
+	cc_line (&s[3], 21, 'C', 'D');
+	cc_line (&s[4], 21, 0x14, 0x2A);	/* TR T1 */
+	cc_line (&s[5], 21, 'E', 'F');
+	cc_line (&s[6], 21, 0x1C, 0x20);	/* RCL CC2 */
+	cc_line (&s[7], 21, 0x00, 0x00);	/* filler */
+	cc_line (&s[8], 21, 'G', 'H');
+	cc_line (&s[9], 284, 0x14, 0x20);	/* RCL CC3 */
+	cc_line (&s[10], 284, 'I', 'J');
+
+	memset (&c, 0, sizeof (c));
+	sf = vbi_sliced_filter_new (capture_cb, &c);
+	assert (NULL != sf);
+
+	/* Nothing selected. */
+	assert_filter (sf, &c, s, 11, "00000000000");
+
+	assert (vbi_sliced_filter_keep_cc_channel (sf, VBI_CAPTION_CC2));
+	vbi_sliced_filter_reset (sf);
+	assert_filter (sf, &c, s, 11, "00110010100");
+
+	assert (vbi_sliced_filter_keep_cc_channel (sf, VBI_CAPTION_T1));
+	assert (vbi_sliced_filter_keep_cc_channel (sf, VBI_CAPTION_CC3));
+	vbi_sliced_filter_reset (sf);
+	assert_filter (sf, &c, s, 11, "00111110111");
+
+	assert (vbi_sliced_filter_drop_cc_channel (sf, VBI_CAPTION_CC2));
+	vbi_sliced_filter_reset (sf);
+	assert_filter (sf, &c, s, 11, "00001100011");
+
+	assert (!vbi_sliced_filter_keep_cc_channel (sf, 0));
+	assert (NULL != vbi_sliced_filter_errstr (sf));
+	assert (!vbi_sliced_filter_drop_cc_channel (sf, VBI_CAPTION_T4 + 1));
+
+	vbi_sliced_filter_delete (sf);
+}
+
+static void
+test_xds_classes		(void)
+{
+	vbi_sliced_filter *sf;
+	struct capture c;
+	vbi_sliced s[10];
+
+	cc_line (&s[0], 284, 0x01, 0x03);	/* Current, program name */
+	cc_line (&s[1], 284, 'A', 'B');
+	cc_line (&s[2], 284, 0x0F, 0x00);	/* End */
+	cc_line (&s[3], 284, 0x05, 0x01);	/* Channel, network name */
+	cc_line (&s[4], 284, 'C', 'D');
+	cc_line (&s[5], 284, 0x0F, 0x00);
+	cc_line (&s[6], 284, 0x14, 0x20);	/* RCL CC3 */
+	cc_line (&s[7], 284, 'E', 'F');
+	cc_line (&s[8], 284, 0x06, 0x01);	/* Channel, continue */
+	cc_line (&s[9], 284, 'G', 'H');
+
+	memset (&c, 0, sizeof (c));
+	sf = vbi_sliced_filter_new (capture_cb, &c);
+	assert (NULL != sf);
+
+	assert (vbi_sliced_filter_keep_xds_class
+		(sf, VBI_XDS_CLASS_CHANNEL));
+	assert_filter (sf, &c, s, 10, "0001110011");
+
+	/* A caption control code interrupts the XDS packet. */
+	assert (vbi_sliced_filter_keep_xds_class
+		(sf, VBI_XDS_CLASS_CURRENT));
+	assert (vbi_sliced_filter_keep_cc_channel (sf, VBI_CAPTION_CC3));
+	assert (vbi_sliced_filter_drop_xds_class
+		(sf, VBI_XDS_CLASS_CHANNEL));
+	vbi_sliced_filter_reset (sf);
+	assert_filter (sf, &c, s, 10, "1110001100");
+
+	assert (!vbi_sliced_filter_keep_xds_class
+		(sf, (vbi_xds_class) VBI_XDS_MAX_CLASSES));
+
+	vbi_sliced_filter_delete (sf);
+}
+
+/* Caption lines passed through by vbi_sliced_filter_keep_services()
+   must still update the current caption channel and XDS class. */
+static void
+test_caption_services_state	(void)
+{
+	vbi_sliced_filter *sf;
+	struct capture c;
+	vbi_sliced s[4];
+
+	memset (&c, 0, sizeof (c));
+	sf = vbi_sliced_filter_new (capture_cb, &c);
+	assert (NULL != sf);
+
+	vbi_sliced_filter_keep_services (sf, VBI_SLICED_CAPTION_525);
+
+	cc_line (&s[0], 21, 0x14, 0x20);	/* RCL CC1 */
+	cc_line (&s[1], 21, 'A', 'B');
+	cc_line (&s[2], 284, 0x14, 0x20);	/* RCL CC3 */
+	cc_line (&s[3], 284, 0x05, 0x01);	/* Channel, network name */
+	assert_filter (sf, &c, s, 4, "1111");
+
+	/* Still on CC1 and in a channel class packet. */
+	assert (vbi_sliced_filter_drop_cc_channel (sf, VBI_CAPTION_CC2));
+	assert (vbi_sliced_filter_drop_xds_class
+		(sf, VBI_XDS_CLASS_CHANNEL));
+
+	cc_line (&s[0], 21, 'E', 'F');
+	cc_line (&s[1], 284, 'G', 'H');
+	cc_line (&s[2], 284, 0x0F, 0x00);	/* End */
+	cc_line (&s[3], 284, 'I', 'J');		/* CC3 */
+	assert_filter (sf, &c, s, 4, "1001");
+
+	vbi_sliced_filter_delete (sf);
+}
+
+static void
+test_teletext			(void)
+{
+	vbi_sliced_filter *sf;
+	struct capture c;
+	vbi_sliced s[12];
+	unsigned int n;
+
+	ttx_line (&s[0], 1, 0, 0x00, 0);
+	ttx_line (&s[1], 1, 1, 0, 0);
+	ttx_line (&s[2], 1, 0, 0x01, 0);
+	ttx_line (&s[3], 1, 1, 0, 0);
+	ttx_line (&s[4], 2, 0, 0x01, 0);	/* other magazine */
+	ttx_line (&s[5], 1, 2, 0, 0);
+	ttx_line (&s[6], 1, 0, 0x02, 0);
+	ttx_line (&s[7], 1, 1, 0, 0);
+	ttx_line (&s[8], 0, 30, 0, 0);		/* IDL */
+	ttx_line (&s[9], 1, 0, 0xFF, 0);	/* filler */
+	ttx_line (&s[10], 1, 0, 0x01, 0x0001);	/* subpage 1 */
+	ttx_line (&s[11], 1, 1, 0, 0);
+
+	memset (&c, 0, sizeof (c));
+	sf = vbi_sliced_filter_new (capture_cb, &c);
+	assert (NULL != sf);
+
+	/* The first page header is kept for its timestamp, the header
+	   of the next page of the magazine terminates page 101. */
+	assert (vbi_sliced_filter_keep_ttx_page (sf, 0x101));
+	assert_filter (sf, &c, s, 12, "101101100011");
+
+	vbi_sliced_filter_reset (sf);
+	assert (vbi_sliced_filter_drop_ttx_subpage (sf, 0x101, 1));
+	assert_filter (sf, &c, s, 12, "101101100000");
+
+	vbi_sliced_filter_reset (sf);
+	vbi_sliced_filter_keep_services (sf, VBI_SLICED_TELETEXT_B);
+	assert_filter (sf, &c, s, 12, "111111111111");
+
+	/* Hamming error in the page number. */
+	vbi_sliced_filter_drop_services (sf, VBI_SLICED_TELETEXT_B);
+	assert (vbi_sliced_filter_keep_ttx_page (sf, 0x101));
+	s[6].data[2] ^= 0x03;
+
+	n = 12;
+	assert (!vbi_sliced_filter_feed (sf, s, &n));
+	assert (6 == n);
+	assert (NULL != vbi_sliced_filter_errstr (sf));
+
+	assert (!vbi_sliced_filter_keep_ttx_page (sf, 0x900));
+
+	vbi_sliced_filter_delete (sf);
+}
+
+static void
+random_frame			(vbi_sliced *		s,
+				 unsigned int		n_lines)
+{
+	static const int cc_codes[][2] = {
+		{ 0x14, 0x20 }, { 0x1C, 0x20 }, { 0x14, 0x2A },
+		{ 0x1C, 0x2A }, { 0x01, 0x03 }, { 0x05, 0x01 },
+		{ 0x0F, 0x00 }, { 0x00, 0x00 }, { 'A', 'B' }
+	};
+	unsigned int i;
+
+	for (i = 0; i < n_lines; ++i) {
+		unsigned int r = (unsigned int) mrand48 ();
+
+		if (r & 1) {
+			unsigned int packet = (r >> 1) % 4;
+
+			ttx_line (&s[i], 1 + (r >> 3) % 2, packet,
+				  (r >> 5) % 4, 0);
+		} else {
+			const int *code;
+
+			code = cc_codes[(r >> 1) % N_ELEMENTS (cc_codes)];
+			cc_line (&s[i], (r & 0x10) ? 284 : 21,
+				 code[0], code[1]);
+		}
+	}
+}
+
+static void
+configure_filter		(vbi_sliced_filter *	sf,
+				 unsigned int		config)
+{
+	switch (config) {
+	case 0:
+		vbi_sliced_filter_keep_ttx_page (sf, 0x101);
+		vbi_sliced_filter_keep_ttx_page (sf, 0x202);
+		break;
+
+	case 1:
+		vbi_sliced_filter_keep_services (sf, VBI_SLICED_TELETEXT_B);
+		vbi_sliced_filter_keep_cc_channel (sf, VBI_CAPTION_CC2);
+		break;
+
+	case 2:
+		vbi_sliced_filter_keep_services (sf, VBI_SLICED_CAPTION_525);
+		vbi_sliced_filter_keep_ttx_page (sf, 0x100);
+		vbi_sliced_filter_drop_xds_class
+			(sf, VBI_XDS_CLASS_CURRENT);
+		break;
+
+	case 3:
+		vbi_sliced_filter_keep_services
+			(sf, VBI_SLICED_TELETEXT_B | VBI_SLICED_CAPTION_525);
+		break;
+
+	default:
+		assert (0);
+	}
+}
+
+/* The filters of a multi filter must give the same results
+   as independent filters. */
+static void
+test_multi_filter		(const unsigned int *	configs,
+				 unsigned int		n_configs)
+{
+	_vbi_sliced_multi_filter *mf;
+	vbi_sliced_filter *sf[4];
+	vbi_sliced_filter *ref[4];
+	struct capture c[4];
+	struct capture ref_c[4];
+	vbi_sliced s[16];
+	vbi_bool all_keep_ttx;
+	unsigned int n;
+	unsigned int i;
+	unsigned int j;
+
+	assert (n_configs <= N_ELEMENTS (sf));
+
+	mf = _vbi_sliced_multi_filter_new ();
+	assert (NULL != mf);
+
+	memset (c, 0, sizeof (c));
+	memset (ref_c, 0, sizeof (ref_c));
+
+	for (i = 0; i < n_configs; ++i) {
+		sf[i] = _vbi_sliced_multi_filter_add_sink
+			(mf, capture_cb, &c[i]);
+		assert (NULL != sf[i]);
+		configure_filter (sf[i], configs[i]);
+
+		ref[i] = vbi_sliced_filter_new (capture_cb, &ref_c[i]);
+		assert (NULL != ref[i]);
+		configure_filter (ref[i], configs[i]);
+	}
+
+	srand48 (n_configs);
+
+	for (j = 0; j < 1000; ++j) {
+		random_frame (s, N_ELEMENTS (s));
+
+		n = N_ELEMENTS (s);
+		assert (_vbi_sliced_multi_filter_feed (mf, s, &n));
+		assert (N_ELEMENTS (s) == n);
+
+		for (i = 0; i < n_configs; ++i) {
+			n = N_ELEMENTS (s);
+			assert (vbi_sliced_filter_feed (ref[i], s, &n));
+
+			assert (c[i].n_frames == ref_c[i].n_frames);
+			assert (c[i].n_lines == ref_c[i].n_lines);
+			assert (0 == memcmp (c[i].lines, ref_c[i].lines,
+					     c[i].n_lines
+					     * sizeof (*c[i].lines)));
+		}
+	}
+
+	/* A Hamming error stops the filters which need the packet. */
+	ttx_line (&s[5], 1, 0, 0x01, 0);
+	s[5].data[0] ^= 0x03;
+
+	all_keep_ttx = TRUE;
+	for (i = 0; i < n_configs; ++i) {
+		if (0 == (VBI_SLICED_TELETEXT_B
+			  & vbi_sliced_filter_keep_services (sf[i], 0)))
+			all_keep_ttx = FALSE;
+	}
+
+	n = N_ELEMENTS (s);
+	if (all_keep_ttx) {
+		assert (_vbi_sliced_multi_filter_feed (mf, s, &n));
+		assert (N_ELEMENTS (s) == n);
+	} else {
+		assert (!_vbi_sliced_multi_filter_feed (mf, s, &n));
+		assert (5 == n);
+		assert (NULL != _vbi_sliced_multi_filter_errstr (mf));
+	}
+
+	for (i = 0; i < n_configs; ++i) {
+		if (VBI_SLICED_TELETEXT_B
+		    & vbi_sliced_filter_keep_services (sf[i], 0))
+			assert (c[i].n_frames == j + 1);
+		else
+			assert (c[i].n_frames == j);
+	}
+
+	_vbi_sliced_multi_filter_remove_sink (mf, sf[0]);
+	_vbi_sliced_multi_filter_reset (mf);
+
+	for (i = 0; i < n_configs; ++i)
+		vbi_sliced_filter_delete (ref[i]);
+
+	_vbi_sliced_multi_filter_delete (mf);
+}
+
+int
+main				(void)
+{
+	static const unsigned int all_configs[] = { 0, 1, 2, 3 };
+	static const unsigned int ttx_configs[] = { 1, 3 };
+
+	test_caption_channels ();
+	test_xds_classes ();
+	test_caption_services_state ();
+	test_teletext ();
+
+	test_multi_filter (all_configs, N_ELEMENTS (all_configs));
+
+	/* All filters keep Teletext, nothing to decode. */
+	test_multi_filter (ttx_configs, N_ELEMENTS (ttx_configs));
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
@@ -0,0 +1,448 @@
+/*
+ *  libzvbi -- Teletext decoder unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>		/* mrand48() */
+#include <string.h>		/* memset() */
+
+/* vbi.h has no C++ linkage declarations. */
+extern "C" {
+#  include "src/vbi.h"
+}
+#include "src/hamm.h"
+#include "src/page_table.h"
+
+/* Page header control bits, EN 300 706 section 9.3.1.3. */
+#define C4_ERASE_PAGE		(1 << 0)
+#define C5_NEWSFLASH		(1 << 1)
+#define C6_SUBTITLE		(1 << 2)
+#define C10_INHIBIT_DISPLAY	(1 << 6)
+
+struct decoder {
+	vbi_decoder *		vbi;
+	double			time;
+
+	vbi_sliced		lines[64];
+	unsigned int		n_lines;
+
+	unsigned int		n_page_events;
+};
+
+struct ttx_page {
+	vbi_pgno		pgno;
+	vbi_subno		subno;
+	unsigned int		flags;
+	unsigned int		national;
+};
+
+static void
+event_handler			(vbi_event *		ev,
+				 void *			user_data)
+{
+	struct decoder *d = (struct decoder *) user_data;
+
+	assert (VBI_EVENT_TTX_PAGE == ev->type);
+
+	++d->n_page_events;
+}
+
+static void
+flush_lines			(struct decoder *	d)
+{
+	vbi_decode (d->vbi, d->lines, d->n_lines, d->time);
+
+	d->time += 1 / 25.0;
+	d->n_lines = 0;
+}
+
+static uint8_t *
+add_packet			(struct decoder *	d,
+				 unsigned int		magazine,
+				 unsigned int		packet)
+{
+	vbi_sliced *s;
+
+	if (d->n_lines >= N_ELEMENTS (d->lines))
+		flush_lines (d);
+
+	s = &d->lines[d->n_lines++];
+
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_TELETEXT_B;
+	s->line = 7 + d->n_lines % 16;
+	s->data[0] = vbi_ham8 ((magazine & 7) | ((packet & 1) << 3));
+	s->data[1] = vbi_ham8 (packet >> 1);
+
+	return s->data + 2;
+}
+
+/* Adds a page header. A header of page xFF only terminates the
+   previous page of the magazine. */
+static void
+add_header			(struct decoder *	d,
+				 const struct ttx_page *tp)
+{
+	uint8_t *p;
+	unsigned int i;
+
+	p = add_packet (d, tp->pgno >> 8, 0);
+
+	p[0] = vbi_ham8 (tp->pgno);
+	p[1] = vbi_ham8 (tp->pgno >> 4);
+	p[2] = vbi_ham8 (tp->subno);
+	p[3] = vbi_ham8 (((tp->subno >> 4) & 7)
+			 | ((tp->flags & C4_ERASE_PAGE) << 3));
+	p[4] = vbi_ham8 (tp->subno >> 8);
+	p[5] = vbi_ham8 (((tp->subno >> 12) & 3)
+			 | ((tp->flags & (C5_NEWSFLASH | C6_SUBTITLE)) << 1));
+	p[6] = vbi_ham8 (tp->flags >> 3);
+	/* C11 parallel transmission, C12 ... C14 national option
+	   subset, in reverse bit order. */
+	p[7] = vbi_ham8 (((tp->national & 1) << 3)
+			 | ((tp->national & 2) << 1)
+			 | ((tp->national & 4) >> 1));
+
+	for (i = 8; i < 40; ++i)
+		p[i] = vbi_par8 (0x20 + lrand48 () % 0x60);
+}
+
+/* Random Level 1 text, including all spacing attributes. */
+static void
+add_random_rows			(struct decoder *	d,
+				 vbi_pgno		pgno)
+{
+	unsigned int row;
+
+	for (row = 1; row <= 24; ++row) {
+		uint8_t *p;
+		unsigned int i;
+
+		p = add_packet (d, pgno >> 8, row);
+
+		for (i = 0; i < 40; ++i) {
+			if (0 == lrand48 () % 3)
+				p[i] = vbi_par8 (lrand48 () % 0x20);
+			else
+				p[i] = vbi_par8 (0x20 + lrand48 () % 0x60);
+		}
+	}
+}
+
+static void
+make_pages			(struct decoder *	d,
+				 struct ttx_page *	pages,
+				 unsigned int		n_pages)
+{
+	unsigned int i;
+
+	for (i = 0; i < n_pages; ++i) {
+		struct ttx_page *tp = &pages[i];
+
+		/* Distinct pages with decimal page numbers, which
+		   the decoder takes for Level 1 pages. */
+		tp->pgno = 0x100 * (1 + i % 8)
+			+ 0x10 * (i / 8) + lrand48 () % 10;
+		/* BCD. */
+		tp->subno = (lrand48 () % 8) * 0x10 + lrand48 () % 10;
+		tp->flags = C4_ERASE_PAGE
+			| (lrand48 () & (C5_NEWSFLASH | C6_SUBTITLE
+					 | C10_INHIBIT_DISPLAY));
+		tp->national = lrand48 () % 8;
+
+		add_header (d, tp);
+		add_random_rows (d, tp->pgno);
+	}
+
+	/* Terminate the last page of each magazine. */
+	for (i = 1; i <= 8; ++i) {
+		struct ttx_page end;
+
+		memset (&end, 0, sizeof (end));
+		end.pgno = i * 0x100 + 0xFF;
+		end.subno = 0x3F7F;
+
+		add_header (d, &end);
+	}
+
+	flush_lines (d);
+}
+
+static void
+assert_same_text		(const vbi_text_page *	tp,
+				 const vbi_page *	pg,
+				 int			display_rows)
+{
+	int row;
+
+	assert (tp->pgno == pg->pgno);
+	assert (tp->subno == pg->subno);
+	assert (tp->rows == display_rows);
+	assert (pg->rows == display_rows);
+	assert (tp->screen_opacity == pg->screen_opacity);
+
+	for (row = 0; row < display_rows; ++row) {
+		int column;
+
+		for (column = 0; column < 40; ++column) {
+			const vbi_char *ac = &pg->text[row * 41 + column];
+			unsigned int attr = tp->attr[row * 40 + column];
+
+			assert (tp->unicode[row * 40 + column]
+				== ac->unicode);
+			assert (VBI_TEXT_FOREGROUND (attr)
+				== (vbi_color) ac->foreground);
+			assert (VBI_TEXT_BACKGROUND (attr)
+				== (vbi_color) ac->background);
+			assert (VBI_TEXT_SIZE (attr)
+				== (vbi_size) ac->size);
+			assert (VBI_TEXT_OPACITY (attr)
+				== (vbi_opacity) ac->opacity);
+			assert (!!(attr & VBI_TEXT_FLASH) == ac->flash);
+			assert (!!(attr & VBI_TEXT_CONCEAL) == ac->conceal);
+		}
+	}
+}
+
+/* vbi_fetch_vt_text_page() must format like vbi_fetch_vt_page()
+   at Level 1 without navigation. */
+static void
+test_text_page			(void)
+{
+	static const int display_rows[] = { 1, 12, 25 };
+	struct ttx_page pages[64];
+	struct decoder d;
+	unsigned int i;
+
+	memset (&d, 0, sizeof (d));
+
+	d.vbi = vbi_decoder_new ();
+	assert (NULL != d.vbi);
+
+	assert (vbi_event_handler_register (d.vbi, VBI_EVENT_TTX_PAGE,
+					    event_handler, &d));
+
+	d.time = 1.0;
+
+	make_pages (&d, pages, N_ELEMENTS (pages));
+
+	assert (N_ELEMENTS (pages) == d.n_page_events);
+
+	for (i = 0; i < N_ELEMENTS (pages); ++i) {
+		unsigned int j;
+
+		for (j = 0; j < N_ELEMENTS (display_rows); ++j) {
+			vbi_text_page tp;
+			vbi_page pg;
+
+			assert (vbi_fetch_vt_text_page (d.vbi, &tp,
+							pages[i].pgno,
+							VBI_ANY_SUBNO,
+							display_rows[j]));
+			assert (vbi_fetch_vt_page (d.vbi, &pg,
+						   pages[i].pgno,
+						   VBI_ANY_SUBNO,
+						   VBI_WST_LEVEL_1,
+						   display_rows[j],
+						   /* navigation */ FALSE));
+
+			assert (pages[i].subno == tp.subno);
+
+			assert_same_text (&tp, &pg, display_rows[j]);
+		}
+	}
+
+	/* Not cached. */
+	{
+		vbi_text_page tp;
+
+		assert (!vbi_fetch_vt_text_page (d.vbi, &tp, 0x8A0,
+						 VBI_ANY_SUBNO, 25));
+	}
+
+	vbi_decoder_delete (d.vbi);
+}
+
+/* Adds a page of the given function with packet 1 data only. */
+static void
+add_function_page		(struct decoder *	d,
+				 vbi_pgno		pgno,
+				 const uint8_t		packet_1[40])
+{
+	struct ttx_page tp;
+
+	memset (&tp, 0, sizeof (tp));
+	tp.pgno = pgno;
+	tp.flags = C4_ERASE_PAGE;
+
+	add_header (d, &tp);
+
+	memcpy (add_packet (d, pgno >> 8, 1), packet_1, 40);
+}
+
+/* Filtered pages must never reach the cache, but the decoder must
+   still parse the MIP, MOT and BTT pages it needs to classify pages
+   and format them later. */
+static void
+test_page_filter		(void)
+{
+	struct ttx_page kept, filtered, end;
+	vbi_page_table *pt;
+	const struct ttx_magazine *mag;
+	struct decoder d;
+	uint8_t buffer[40];
+	vbi_subno subno;
+	unsigned int i;
+
+	memset (&d, 0, sizeof (d));
+
+	d.vbi = vbi_decoder_new ();
+	assert (NULL != d.vbi);
+
+	assert (vbi_event_handler_register (d.vbi, VBI_EVENT_TTX_PAGE,
+					    event_handler, &d));
+
+	d.time = 1.0;
+
+	pt = vbi_page_table_new ();
+	assert (NULL != pt);
+
+	assert (vbi_page_table_add_page (pt, 0x301));
+
+	_vbi_teletext_set_page_filter (d.vbi, pt);
+
+	memset (&filtered, 0, sizeof (filtered));
+	filtered.pgno = 0x300;
+	filtered.subno = 0x0001;
+	filtered.flags = C4_ERASE_PAGE;
+
+	kept = filtered;
+	kept.pgno = 0x301;
+
+	add_header (&d, &filtered);
+	add_random_rows (&d, filtered.pgno);
+	add_header (&d, &kept);
+	add_random_rows (&d, kept.pgno);
+
+	/* MIP: page 0x205 is a subtitle page, code 0x70. The
+	   entries of pages 0x200 ... 0x209 come first. */
+	memset (buffer, vbi_ham8 (0xF), sizeof (buffer));
+	buffer[5 * 2 + 0] = vbi_ham8 (0x0);
+	buffer[5 * 2 + 1] = vbi_ham8 (0x7);
+	add_function_page (&d, 0x2FD, buffer);
+
+	/* MOT: object pages of page 0x105. Packet 1 holds the
+	   entries of pages 0x100 ... 0x109, 0x110 ... 0x119. */
+	memset (buffer, vbi_ham8 (0), sizeof (buffer));
+	buffer[5 * 2 + 0] = vbi_ham8 (3);
+	buffer[5 * 2 + 1] = vbi_ham8 (5);
+	add_function_page (&d, 0x1FE, buffer);
+
+	/* BTT: page 0x120 is a subtitle page (1), all other pages
+	   of 0x100 ... 0x139 are not in transmission (0). */
+	memset (buffer, vbi_ham8 (0), sizeof (buffer));
+	buffer[20] = vbi_ham8 (1);
+	add_function_page (&d, 0x1F0, buffer);
+
+	memset (&end, 0, sizeof (end));
+	end.subno = 0x3F7F;
+
+	for (i = 1; i <= 3; ++i) {
+		end.pgno = i * 0x100 + 0xFF;
+		add_header (&d, &end);
+	}
+
+	flush_lines (&d);
+
+	assert (1 == d.n_page_events);
+
+	{
+		vbi_text_page tp;
+		vbi_page pg;
+
+		assert (!vbi_fetch_vt_text_page (d.vbi, &tp, filtered.pgno,
+						 VBI_ANY_SUBNO, 25));
+		assert (!vbi_fetch_vt_page (d.vbi, &pg, filtered.pgno,
+					    VBI_ANY_SUBNO, VBI_WST_LEVEL_1,
+					    25, /* navigation */ FALSE));
+
+		assert (vbi_fetch_vt_text_page (d.vbi, &tp, kept.pgno,
+						VBI_ANY_SUBNO, 25));
+		assert (kept.subno == tp.subno);
+	}
+
+	assert (VBI_SUBTITLE_PAGE
+		== vbi_classify_page (d.vbi, 0x205, &subno, NULL));
+	assert (VBI_SUBTITLE_PAGE
+		== vbi_classify_page (d.vbi, 0x120, &subno, NULL));
+	assert (VBI_NO_PAGE
+		== vbi_classify_page (d.vbi, 0x121, &subno, NULL));
+
+	mag = cache_network_magazine (d.vbi->cn, 0x100);
+	assert (3 == mag->pop_lut[5]);
+	assert (5 == mag->drcs_lut[5]);
+
+	/* Without a filter the decoder stores all pages again. */
+	_vbi_teletext_set_page_filter (d.vbi, NULL);
+
+	add_header (&d, &filtered);
+	add_random_rows (&d, filtered.pgno);
+	end.pgno = 0x3FF;
+	add_header (&d, &end);
+	flush_lines (&d);
+
+	assert (2 == d.n_page_events);
+
+	{
+		vbi_text_page tp;
+
+		assert (vbi_fetch_vt_text_page (d.vbi, &tp, filtered.pgno,
+						VBI_ANY_SUBNO, 25));
+	}
+
+	vbi_page_table_delete (pt);
+
+	vbi_decoder_delete (d.vbi);
+}
+
+int
+main				(void)
+{
+	srand48 (0x1234);
+
+	test_text_page ();
+	test_page_filter ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/
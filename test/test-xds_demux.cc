@@ -0,0 +1,584 @@
+/*
+ *  libzvbi -- XDS demultiplexer unit test
+ *
+ *  Copyright (C) 2026 the libzvbi contributors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA 02110-1301, USA.
+ */
+
+#undef NDEBUG
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>		/* memset() */
+
+#include "src/misc.h"
+#include "src/xds_demux.h"
+#include "src/hamm.h"
+
+/* Caption lines of a test stream. */
+struct stream {
+	vbi_sliced		lines[512];
+	unsigned int		n_lines;
+};
+
+/* Packets passed to the callback. */
+struct capture {
+	vbi_xds_packet		packets[64];
+	unsigned int		n_packets;
+};
+
+static vbi_bool
+capture_cb			(vbi_xds_demux *	xd,
+				 const vbi_xds_packet *	xp,
+				 void *			user_data)
+{
+	struct capture *c = (struct capture *) user_data;
+
+	xd = xd; /* unused */
+
+	assert (c->n_packets < N_ELEMENTS (c->packets));
+	c->packets[c->n_packets++] = *xp;
+
+	return TRUE;
+}
+
+static void
+add_line			(struct stream *	st,
+				 unsigned int		line,
+				 int			c1,
+				 int			c2)
+{
+	vbi_sliced *s;
+
+	assert (st->n_lines < N_ELEMENTS (st->lines));
+	s = &st->lines[st->n_lines++];
+
+	memset (s, 0, sizeof (*s));
+
+	s->id = VBI_SLICED_CAPTION_525;
+	s->line = line;
+	s->data[0] = vbi_par8 (c1);
+	s->data[1] = vbi_par8 (c2);
+}
+
+/* Adds a packet header and updates the checksum *sum. Continue
+   headers are not part of the checksum. */
+static void
+add_header			(struct stream *	st,
+				 unsigned int *		sum,
+				 vbi_xds_class		xds_class,
+				 vbi_xds_subclass	xds_subclass,
+				 vbi_bool		start)
+{
+	int c1 = xds_class * 2 + 1 + !start;
+
+	add_line (st, 284, c1, xds_subclass);
+	if (start)
+		*sum = c1 + xds_subclass;
+}
+
+static void
+add_data			(struct stream *	st,
+				 unsigned int *		sum,
+				 const char *		data,
+				 unsigned int		size)
+{
+	unsigned int i;
+
+	for (i = 0; i < size; i += 2) {
+		int c2 = (i + 1 < size) ? data[i + 1] : 0;
+
+		add_line (st, 284, data[i], c2);
+		*sum += data[i] + c2;
+	}
+}
+
+static void
+add_end				(struct stream *	st,
+				 unsigned int		sum,
+				 vbi_bool		valid)
+{
+	sum += 0x0F;
+	add_line (st, 284, 0x0F, (-sum + !valid) & 0x7F);
+}
+
+static void
+add_packet			(struct stream *	st,
+				 vbi_xds_class		xds_class,
+				 vbi_xds_subclass	xds_subclass,
+				 const char *		data,
+				 unsigned int		size)
+{
+	unsigned int sum;
+
+	add_header (st, &sum, xds_class, xds_subclass, TRUE);
+	add_data (st, &sum, data, size);
+	add_end (st, sum, TRUE);
+}
+
+static void
+assert_packet			(const vbi_xds_packet *	xp,
+				 vbi_xds_class		xds_class,
+				 vbi_xds_subclass	xds_subclass,
+				 const char *		data,
+				 unsigned int		size)
+{
+	assert (xds_class == xp->xds_class);
+	assert (xds_subclass == xp->xds_subclass);
+	assert (size == xp->buffer_size);
+	assert (0 == memcmp (xp->buffer, data, size));
+	assert (0 == xp->buffer[size]);
+}
+
+static void
+demux_stream			(struct capture *	c,
+				 const struct stream *	st)
+{
+	vbi_xds_demux *xd;
+
+	memset (c, 0, sizeof (*c));
+
+	xd = vbi_xds_demux_new (capture_cb, c);
+	assert (NULL != xd);
+
+	assert (vbi_xds_demux_feed_frame (xd, st->lines, st->n_lines));
+
+	vbi_xds_demux_delete (xd);
+}
+
+static const char
+text[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghij";
+
+static void
+test_sizes			(void)
+{
+	struct stream st;
+	struct capture c;
+	unsigned int size;
+
+	/* Even and odd sizes up to the maximum. */
+	for (size = 1; size <= 32; ++size) {
+		st.n_lines = 0;
+		add_packet (&st, VBI_XDS_CLASS_CURRENT,
+			    VBI_XDS_PROGRAM_NAME, text, size);
+
+		demux_stream (&c, &st);
+
+		assert (1 == c.n_packets);
+		assert_packet (&c.packets[0], VBI_XDS_CLASS_CURRENT,
+			       VBI_XDS_PROGRAM_NAME, text, size);
+	}
+
+	/* An odd pair in the middle of a packet. */
+	{
+		unsigned int sum;
+
+		st.n_lines = 0;
+		add_header (&st, &sum, VBI_XDS_CLASS_CHANNEL,
+			    VBI_XDS_CHANNEL_NAME, TRUE);
+		add_data (&st, &sum, "A", 1);
+		add_data (&st, &sum, "BC", 2);
+		add_end (&st, sum, TRUE);
+
+		demux_stream (&c, &st);
+
+		assert (1 == c.n_packets);
+		assert_packet (&c.packets[0], VBI_XDS_CLASS_CHANNEL,
+			       VBI_XDS_CHANNEL_NAME, "ABC", 3);
+	}
+}
+
+static void
+test_overflow			(void)
+{
+	struct stream st;
+	struct capture c;
+	unsigned int sum;
+
+	st.n_lines = 0;
+
+	/* Too long. */
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, text, 34);
+
+	/* 31 bytes ending in an odd pair, then one more pair.
+	   The second pair must not be stored after the buffer. */
+	add_header (&st, &sum, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, TRUE);
+	add_data (&st, &sum, text, 31);
+	add_data (&st, &sum, "xy", 2);
+	add_end (&st, sum, TRUE);
+
+	/* Subsequent packets are not affected. */
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_TYPE, "ab", 2);
+
+	demux_stream (&c, &st);
+
+	assert (2 == c.n_packets);
+	assert_packet (&c.packets[0], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+	assert_packet (&c.packets[1], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_TYPE, "ab", 2);
+}
+
+static void
+test_subclasses			(void)
+{
+	static const vbi_xds_subclass invalid[] = {
+		0x18, 0x19, 0x3F, 0x48, 0x4F, 0x7F
+	};
+	struct stream st;
+	struct capture c;
+	unsigned int i;
+
+	st.n_lines = 0;
+
+	for (i = 0; i < N_ELEMENTS (invalid); ++i) {
+		add_packet (&st, VBI_XDS_CLASS_MISC,
+			    invalid[i], "ab", 2);
+	}
+
+	/* Bad checksum. */
+	{
+		unsigned int sum;
+
+		add_header (&st, &sum, VBI_XDS_CLASS_MISC,
+			    VBI_XDS_TIME_OF_DAY, TRUE);
+		add_data (&st, &sum, "ab", 2);
+		add_end (&st, sum, FALSE);
+	}
+
+	/* Public service, reserved and undefined class. */
+	for (i = 0x09; i <= 0x0E; ++i) {
+		add_line (&st, 284, i, VBI_XDS_WEATHER_BULLETIN);
+		add_line (&st, 284, 'a', 'b');
+		add_line (&st, 284, 0x0F, -(i + 0x01 + 'a' + 'b' + 0x0F)
+			  & 0x7F);
+	}
+
+	/* The highest valid subclasses. */
+	add_packet (&st, VBI_XDS_CLASS_MISC, 0x17, "cd", 2);
+	add_packet (&st, VBI_XDS_CLASS_MISC, VBI_XDS_CHANNEL_MAP, "ef", 2);
+
+	demux_stream (&c, &st);
+
+	assert (2 == c.n_packets);
+	assert_packet (&c.packets[0], VBI_XDS_CLASS_MISC, 0x17, "cd", 2);
+	assert_packet (&c.packets[1], VBI_XDS_CLASS_MISC,
+		       VBI_XDS_CHANNEL_MAP, "ef", 2);
+}
+
+static void
+test_interleaved		(void)
+{
+	struct stream st;
+	struct capture c;
+	unsigned int sum1, sum2;
+
+	st.n_lines = 0;
+
+	add_header (&st, &sum1, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, TRUE);
+	add_data (&st, &sum1, "Prog", 4);
+
+	/* Caption data interrupts the packet. */
+	add_line (&st, 284, 0x14, 0x2C);
+	add_line (&st, 284, 'H', 'i');
+
+	add_header (&st, &sum2, VBI_XDS_CLASS_CHANNEL,
+		    VBI_XDS_CHANNEL_CALL_LETTERS, TRUE);
+	add_data (&st, &sum2, "WX", 2);
+
+	add_header (&st, &sum1, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, FALSE);
+	add_data (&st, &sum1, "ram", 3);
+	add_end (&st, sum1, TRUE);
+
+	add_header (&st, &sum2, VBI_XDS_CLASS_CHANNEL,
+		    VBI_XDS_CHANNEL_CALL_LETTERS, FALSE);
+	add_data (&st, &sum2, "YZ", 2);
+	add_end (&st, sum2, TRUE);
+
+	/* Cannot continue, the packet is complete. */
+	add_header (&st, &sum2, VBI_XDS_CLASS_CHANNEL,
+		    VBI_XDS_CHANNEL_CALL_LETTERS, FALSE);
+	add_data (&st, &sum2, "AB", 2);
+	add_end (&st, sum2, TRUE);
+
+	demux_stream (&c, &st);
+
+	assert (2 == c.n_packets);
+	assert_packet (&c.packets[0], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Program", 7);
+	assert_packet (&c.packets[1], VBI_XDS_CLASS_CHANNEL,
+		       VBI_XDS_CHANNEL_CALL_LETTERS, "WXYZ", 4);
+}
+
+static void
+test_cor			(void)
+{
+	vbi_xds_packet packets[8];
+	struct stream st;
+	struct capture c;
+	vbi_xds_demux *xd;
+	unsigned int n_packets;
+	unsigned int n_lines;
+	unsigned int total;
+	unsigned int i;
+
+	st.n_lines = 0;
+
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	/* Only line 284 carries XDS. */
+	add_line (&st, 21, 0x01, 0x03);
+	add_packet (&st, VBI_XDS_CLASS_CHANNEL,
+		    VBI_XDS_CHANNEL_NAME, "Net", 3);
+	add_packet (&st, VBI_XDS_CLASS_MISC,
+		    VBI_XDS_TIME_OF_DAY, "abcdef", 6);
+
+	demux_stream (&c, &st);
+	assert (3 == c.n_packets);
+
+	xd = vbi_xds_demux_new (capture_cb, NULL);
+	assert (NULL != xd);
+
+	/* All at once. */
+	n_lines = st.n_lines;
+	assert (_vbi_xds_demux_cor (xd, packets, &n_packets,
+				    N_ELEMENTS (packets),
+				    st.lines, &n_lines));
+	assert (st.n_lines == n_lines);
+	assert (3 == n_packets);
+
+	for (i = 0; i < 3; ++i) {
+		assert_packet (&packets[i],
+			       c.packets[i].xds_class,
+			       c.packets[i].xds_subclass,
+			       (const char *) c.packets[i].buffer,
+			       c.packets[i].buffer_size);
+	}
+
+	/* One packet at a time. It stops before the line
+	   following a packet, so no data is lost. */
+	for (total = 0, i = 0; total < st.n_lines; ++i) {
+		n_lines = st.n_lines - total;
+		assert (_vbi_xds_demux_cor (xd, packets, &n_packets, 1,
+					    st.lines + total, &n_lines));
+		assert (n_packets <= 1);
+		if (1 == n_packets) {
+			assert (i < 3);
+			assert_packet (&packets[0],
+				       c.packets[i].xds_class,
+				       c.packets[i].xds_subclass,
+				       (const char *) c.packets[i].buffer,
+				       c.packets[i].buffer_size);
+		} else {
+			--i;
+		}
+		total += n_lines;
+	}
+
+	assert (3 == i);
+
+	/* A parity error discards the current packet,
+	   but the function continues. */
+	st.lines[1].data[0] ^= 0x80;
+	n_lines = st.n_lines;
+	assert (!_vbi_xds_demux_cor (xd, packets, &n_packets,
+				     N_ELEMENTS (packets),
+				     st.lines, &n_lines));
+	assert (st.n_lines == n_lines);
+	assert (2 == n_packets);
+	assert (VBI_XDS_CLASS_CHANNEL == packets[0].xds_class);
+	assert (VBI_XDS_CLASS_MISC == packets[1].xds_class);
+
+	vbi_xds_demux_delete (xd);
+}
+
+static void
+test_reset			(void)
+{
+	struct stream st;
+	struct capture c;
+	vbi_xds_demux *xd;
+	unsigned int sum;
+
+	memset (&c, 0, sizeof (c));
+
+	xd = vbi_xds_demux_new (capture_cb, &c);
+	assert (NULL != xd);
+
+	st.n_lines = 0;
+	add_header (&st, &sum, VBI_XDS_CLASS_MISC,
+		    VBI_XDS_CHANNEL_MAP, TRUE);
+	add_data (&st, &sum, "ab", 2);
+	assert (vbi_xds_demux_feed_frame (xd, st.lines, st.n_lines));
+
+	vbi_xds_demux_reset (xd);
+
+	/* The partial packet is gone. */
+	st.n_lines = 0;
+	add_header (&st, &sum, VBI_XDS_CLASS_MISC,
+		    VBI_XDS_CHANNEL_MAP, FALSE);
+	add_data (&st, &sum, "cd", 2);
+	add_end (&st, sum, TRUE);
+	assert (vbi_xds_demux_feed_frame (xd, st.lines, st.n_lines));
+
+	assert (0 == c.n_packets);
+
+	vbi_xds_demux_delete (xd);
+}
+
+static void
+test_duplicates			(void)
+{
+	vbi_xds_packet packets[8];
+	const vbi_xds_packet *xp;
+	struct stream st;
+	struct capture c;
+	vbi_xds_demux *xd;
+	unsigned int n_packets;
+	unsigned int n_lines;
+
+	st.n_lines = 0;
+
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	/* Same class and subclass, different size or contents. */
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name2", 5);
+	add_packet (&st, VBI_XDS_CLASS_CURRENT,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	/* Same contents, different class. */
+	add_packet (&st, VBI_XDS_CLASS_FUTURE,
+		    VBI_XDS_PROGRAM_NAME, "Name", 4);
+	/* MISC subclasses 0x11 and 0x41 share a subpacket. */
+	add_packet (&st, VBI_XDS_CLASS_MISC, 0x11, "ab", 2);
+	add_packet (&st, VBI_XDS_CLASS_MISC,
+		    VBI_XDS_CHANNEL_MAP_POINTER, "ab", 2);
+	add_packet (&st, VBI_XDS_CLASS_MISC,
+		    VBI_XDS_CHANNEL_MAP_POINTER, "ab", 2);
+
+	/* Disabled by default. */
+	demux_stream (&c, &st);
+	assert (8 == c.n_packets);
+
+	memset (&c, 0, sizeof (c));
+
+	xd = vbi_xds_demux_new (capture_cb, &c);
+	assert (NULL != xd);
+
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_CURRENT, VBI_XDS_PROGRAM_NAME));
+
+	_vbi_xds_demux_filter_duplicates (xd, TRUE);
+
+	assert (vbi_xds_demux_feed_frame (xd, st.lines, st.n_lines));
+
+	assert (6 == c.n_packets);
+	assert_packet (&c.packets[0], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+	assert_packet (&c.packets[1], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name2", 5);
+	assert_packet (&c.packets[2], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+	assert_packet (&c.packets[3], VBI_XDS_CLASS_FUTURE,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+	assert_packet (&c.packets[4], VBI_XDS_CLASS_MISC, 0x11, "ab", 2);
+	assert_packet (&c.packets[5], VBI_XDS_CLASS_MISC,
+		       VBI_XDS_CHANNEL_MAP_POINTER, "ab", 2);
+
+	/* The last packets. */
+	xp = _vbi_xds_demux_get_packet (xd, VBI_XDS_CLASS_CURRENT,
+					VBI_XDS_PROGRAM_NAME);
+	assert (NULL != xp);
+	assert_packet (xp, VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+
+	xp = _vbi_xds_demux_get_packet (xd, VBI_XDS_CLASS_MISC,
+					VBI_XDS_CHANNEL_MAP_POINTER);
+	assert (NULL != xp);
+	assert_packet (xp, VBI_XDS_CLASS_MISC,
+		       VBI_XDS_CHANNEL_MAP_POINTER, "ab", 2);
+
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_MISC, 0x11));
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_CURRENT, VBI_XDS_PROGRAM_TYPE));
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_PUBLIC_SERVICE,
+		 VBI_XDS_WEATHER_BULLETIN));
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_MISC, 0x48));
+
+	/* _vbi_xds_demux_cor() filters too. The first packets
+	   repeat the last ones of the previous pass. */
+	n_lines = st.n_lines;
+	assert (_vbi_xds_demux_cor (xd, packets, &n_packets,
+				    N_ELEMENTS (packets),
+				    st.lines, &n_lines));
+	assert (4 == n_packets);
+	assert_packet (&packets[0], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name2", 5);
+	assert_packet (&packets[1], VBI_XDS_CLASS_CURRENT,
+		       VBI_XDS_PROGRAM_NAME, "Name", 4);
+	assert_packet (&packets[2], VBI_XDS_CLASS_MISC, 0x11, "ab", 2);
+	assert_packet (&packets[3], VBI_XDS_CLASS_MISC,
+		       VBI_XDS_CHANNEL_MAP_POINTER, "ab", 2);
+
+	/* A reset forgets the last packets. */
+	vbi_xds_demux_reset (xd);
+
+	assert (NULL == _vbi_xds_demux_get_packet
+		(xd, VBI_XDS_CLASS_CURRENT, VBI_XDS_PROGRAM_NAME));
+
+	c.n_packets = 0;
+	assert (vbi_xds_demux_feed_frame (xd, st.lines, st.n_lines));
+	assert (6 == c.n_packets);
+
+	vbi_xds_demux_delete (xd);
+}
+
+int
+main				(void)
+{
+	test_sizes ();
+	test_overflow ();
+	test_subclasses ();
+	test_interleaved ();
+	test_cor ();
+	test_reset ();
+	test_duplicates ();
+
+	return 0;
+}
+
+/*
+Local variables:
+c-set-style: K&R
+c-basic-offset: 8
+End:
+*/